@@ -0,0 +1,129 @@
+#ifndef GODOT_GRPC_LOADGEN_HISTOGRAM_H
+#define GODOT_GRPC_LOADGEN_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace godot_grpc {
+namespace loadgen {
+
+/**
+ * Lock-free latency histogram in microseconds.
+ *
+ * Values below 8 us get exact buckets; above that every power of two is
+ * split into 4 sub-buckets, so percentiles are accurate to ~25% over the
+ * full 64-bit range with a fixed 252-bucket array. record() only does
+ * relaxed atomic increments, so thousands of reader threads can share one.
+ */
+class Histogram {
+public:
+    static constexpr int BUCKETS = 8 + 61 * 4;
+
+    struct Snapshot {
+        std::array<uint64_t, BUCKETS> counts{};
+        uint64_t samples = 0;
+        uint64_t sum_us = 0;
+        uint64_t max_us = 0;
+
+        void merge(const Snapshot& other) {
+            for (int i = 0; i < BUCKETS; ++i) {
+                counts[i] += other.counts[i];
+            }
+            samples += other.samples;
+            sum_us += other.sum_us;
+            max_us = std::max(max_us, other.max_us);
+        }
+
+        double mean_us() const { return samples ? double(sum_us) / double(samples) : 0.0; }
+
+        // Upper limit of the bucket holding quantile q (0..1), capped at the max sample
+        uint64_t percentile(double q) const {
+            if (samples == 0) {
+                return 0;
+            }
+            uint64_t target = uint64_t(q * double(samples));
+            if (target >= samples) {
+                target = samples - 1;
+            }
+            uint64_t seen = 0;
+            for (int i = 0; i < BUCKETS; ++i) {
+                seen += counts[i];
+                if (seen > target) {
+                    return std::min(bucket_limit(i), max_us);
+                }
+            }
+            return max_us;
+        }
+    };
+
+    void record(uint64_t us) {
+        buckets_[bucket_index(us)].fetch_add(1, std::memory_order_relaxed);
+        samples_.fetch_add(1, std::memory_order_relaxed);
+        sum_us_.fetch_add(us, std::memory_order_relaxed);
+        uint64_t current = max_us_.load(std::memory_order_relaxed);
+        while (us > current && !max_us_.compare_exchange_weak(current, us, std::memory_order_relaxed)) {
+        }
+    }
+
+    Snapshot snapshot() const {
+        Snapshot out;
+        for (int i = 0; i < BUCKETS; ++i) {
+            out.counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        }
+        out.samples = samples_.load(std::memory_order_relaxed);
+        out.sum_us = sum_us_.load(std::memory_order_relaxed);
+        out.max_us = max_us_.load(std::memory_order_relaxed);
+        return out;
+    }
+
+    static int bucket_index(uint64_t us) {
+        if (us < 8) {
+            return int(us);
+        }
+        int exp = 63 - count_leading_zeros(us); // >= 3
+        int sub = int(us >> (exp - 2)) & 3;
+        return 8 + (exp - 3) * 4 + sub;
+    }
+
+    // Largest value that falls into bucket i
+    static uint64_t bucket_limit(int i) {
+        if (i < 8) {
+            return uint64_t(i);
+        }
+        int exp = (i - 8) / 4 + 3;
+        uint64_t sub = uint64_t((i - 8) % 4);
+        uint64_t base = uint64_t(1) << (exp - 2);
+        // The top bucket's limit does not fit; saturate instead of wrapping
+        if (exp == 63 && sub == 3) {
+            return UINT64_MAX;
+        }
+        return (4 + sub + 1) * base - 1;
+    }
+
+private:
+    static int count_leading_zeros(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return 63 - int(index);
+#else
+        return __builtin_clzll(value);
+#endif
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> sum_us_{0};
+    std::atomic<uint64_t> max_us_{0};
+};
+
+} // namespace loadgen
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_LOADGEN_HISTOGRAM_H
@@ -0,0 +1,914 @@
+// Multi-client load generator.
+//
+// Simulates many game clients in one process using the extension's own
+// GrpcChannelPool, GrpcStream and StreamTable (built with
+// GODOT_GRPC_NO_GODOT), so each client costs what it would inside Godot: a
+// reader thread per stream, a writer thread per bidi stream, and a message
+// copy per receive.
+//
+// Build with -DGODOT_GRPC_BUILD_LOADGEN=ON and run:
+//   ./godot_grpc_loadgen bench/loadgen/scenarios/game.ini [--duration=60] [--json=out.json]
+//
+// See bench/loadgen/README.md for the scenario file format.
+
+#include "grpc_channel_pool.h"
+#include "grpc_stream.h"
+#include "grpc_stream_table.h"
+#include "histogram.h"
+#include "scenario.h"
+#include "util/alloc_stats.h"
+#include "util/mock_server.h"
+#include "util/runtime_init.h"
+#include "util/status_map.h"
+#include <grpcpp/generic/generic_stub.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace godot_grpc;
+using namespace godot_grpc::loadgen;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Set once the measured window ends; errors from our own cancellation are not counted
+std::atomic<bool> g_stopping{false};
+
+uint64_t micros_since(Clock::time_point start) {
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+}
+
+struct ScenarioStats {
+    Histogram unary_latency;
+    Histogram round_trip;     // Bidi send to the matching reply, FIFO order
+    Histogram first_message;  // Subscription start to its first message
+
+    std::atomic<uint64_t> unary_calls{0};
+    std::atomic<uint64_t> unary_errors{0};
+    std::atomic<uint64_t> unary_skipped{0};  // Previous call still blocking
+    std::atomic<uint64_t> messages_sent{0};
+    std::atomic<uint64_t> messages_received{0};
+    std::atomic<uint64_t> bytes_received{0};
+    std::atomic<uint64_t> streams_opened{0};
+    std::atomic<uint64_t> streams_finished{0};
+    std::atomic<uint64_t> stream_errors{0};
+    std::atomic<uint64_t> streams_restarted{0};  // Reopened by churn
+    std::atomic<uint64_t> clients_closed{0};     // Whole-client closes by close_ms
+};
+
+// Subscription start, for the time to its first message. Shared with the
+// stream's callback, as the stream may outlive the slot it was opened for.
+struct FirstMessage {
+    Clock::time_point opened_at = Clock::now();
+    std::atomic<bool> received{false};
+};
+
+/**
+ * One simulated client. Its streams live in a StreamTable under the IDs in
+ * subscription_ids and bidi_id, used the way GrpcClient uses its own: sends
+ * look streams up by ID, cancels and closes take them out, and the streams'
+ * reader threads retire themselves when they end.
+ */
+struct SimClient {
+    SimClient(const ScenarioSpec* scenario, ScenarioStats* scenario_stats)
+        : spec(scenario), stats(scenario_stats), subscription_ids(scenario->subscriptions.size()) {}
+
+    const ScenarioSpec* spec;
+    ScenarioStats* stats;
+    std::shared_ptr<grpc::GenericStub> stub;
+
+    StreamTable streams;
+    std::vector<std::atomic<int64_t>> subscription_ids;  // 0 = not opened yet
+    std::atomic<int64_t> bidi_id{0};
+    StreamBytes bidi_message;
+
+    // Churn and close both reopen streams; this keeps them from opening two
+    // for one slot. Sends never take it.
+    std::mutex reopen_mutex;
+
+    std::mutex pending_mutex;
+    std::deque<Clock::time_point> pending;  // Bidi sends awaiting a reply
+
+    std::atomic<bool> unary_in_flight{false};
+
+    // Join the stream threads before the state their callbacks touch goes away
+    ~SimClient() {
+        std::vector<std::unique_ptr<GrpcStream>> all = streams.take_all();
+        all.clear();
+    }
+};
+
+// ============================================================================
+// STREAMS
+// ============================================================================
+
+StreamBytes to_stream_bytes(const std::vector<uint8_t>& bytes) {
+    return StreamBytes(bytes.begin(), bytes.end());
+}
+
+// Destroy streams taken out of the table, by GrpcClient::release_streams()'s
+// rule: any the calling thread belongs to are parked instead
+void release_streams(SimClient* client, std::vector<std::unique_ptr<GrpcStream>>& streams) {
+    for (auto& stream : streams) {
+        if (stream && stream->on_stream_thread()) {
+            client->streams.park(std::move(stream));
+        }
+    }
+    streams.clear();
+}
+
+void on_stream_finished(SimClient* client, int64_t stream_id) {
+    client->streams.retire(stream_id);
+    client->stats->streams_finished.fetch_add(1, std::memory_order_relaxed);
+}
+
+void on_stream_error(SimClient* client, int64_t stream_id, int status_code, const std::string& message) {
+    client->streams.retire(stream_id);
+    if (g_stopping.load()) {
+        return;
+    }
+    // Churn and closes cancel streams on purpose
+    if (status_code == int(grpc::StatusCode::CANCELLED) && (client->spec->churn_ms > 0 || client->spec->close_ms > 0)) {
+        return;
+    }
+    ScenarioStats* stats = client->stats;
+    uint64_t errors = stats->stream_errors.fetch_add(1, std::memory_order_relaxed);
+    if (errors < 5) {
+        std::fprintf(stderr, "stream error %d: %s\n", status_code, message.c_str());
+    }
+}
+
+// Start a stream and add it to the client's table, as GrpcClient::start_stream() does
+int64_t open_stream(SimClient* client, StreamType type, const std::string& method, StreamBytes request,
+        StreamMessageCallback on_message) {
+    int64_t stream_id = StreamTable::allocate_id();
+    auto stream = std::make_unique<GrpcStream>(
+        stream_id,
+        type,
+        client->stub,
+        method,
+        std::move(request),
+        std::make_unique<grpc::ClientContext>(),
+        std::move(on_message),
+        [client](int64_t id, int, const std::string&) { on_stream_finished(client, id); },
+        [client](int64_t id, int code, const std::string& message) { on_stream_error(client, id, code, message); }
+    );
+    stream->start();
+    client->streams.add(std::move(stream));
+    client->stats->streams_opened.fetch_add(1, std::memory_order_relaxed);
+    return stream_id;
+}
+
+void open_subscription(SimClient* client, size_t index) {
+    ScenarioStats* stats = client->stats;
+    const CallSpec& call = client->spec->subscriptions[index];
+    auto first = std::make_shared<FirstMessage>();
+    int64_t stream_id = open_stream(client, StreamType::SERVER_STREAMING, call.method, to_stream_bytes(call.request),
+        [stats, first](int64_t, const StreamBytes& data) {
+            if (!first->received.exchange(true, std::memory_order_relaxed)) {
+                stats->first_message.record(micros_since(first->opened_at));
+            }
+            stats->messages_received.fetch_add(1, std::memory_order_relaxed);
+            stats->bytes_received.fetch_add(data.size(), std::memory_order_relaxed);
+        });
+    client->subscription_ids[index].store(stream_id);
+}
+
+void open_bidi(SimClient* client) {
+    ScenarioStats* stats = client->stats;
+    {
+        std::lock_guard<std::mutex> lock(client->pending_mutex);
+        client->pending.clear();
+    }
+    int64_t stream_id = open_stream(client, StreamType::BIDIRECTIONAL, client->spec->bidi.method, StreamBytes(),
+        [client, stats](int64_t, const StreamBytes& data) {
+            stats->messages_received.fetch_add(1, std::memory_order_relaxed);
+            stats->bytes_received.fetch_add(data.size(), std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(client->pending_mutex);
+            if (!client->pending.empty()) {
+                stats->round_trip.record(micros_since(client->pending.front()));
+                client->pending.pop_front();
+            }
+        });
+    client->bidi_id.store(stream_id);
+}
+
+void start_client(SimClient* client) {
+    std::lock_guard<std::mutex> lock(client->reopen_mutex);
+    for (size_t i = 0; i < client->spec->subscriptions.size(); ++i) {
+        open_subscription(client, i);
+    }
+    if (client->spec->has_bidi) {
+        client->bidi_message = to_stream_bytes(client->spec->bidi.request);
+        open_bidi(client);
+    }
+}
+
+// False once the stream has left the table: retired by its reader thread,
+// or taken by a cancel or close
+bool in_table(SimClient* client, int64_t stream_id) {
+    return client->streams.with_stream(stream_id, [](GrpcStream&) {});
+}
+
+// Cancel and reopen one random stream, and reopen any the server has ended.
+// Runs on the churn thread, racing sends, closes and the streams' own
+// reader threads on the client's table.
+void churn_client(SimClient* client, std::mt19937& random) {
+    std::lock_guard<std::mutex> lock(client->reopen_mutex);
+    std::vector<std::unique_ptr<GrpcStream>> streams = client->streams.take_finished();
+    size_t count = client->subscription_ids.size() + (client->spec->has_bidi ? 1 : 0);
+    if (count == 0) {
+        return;
+    }
+    size_t victim = std::uniform_int_distribution<size_t>(0, count - 1)(random);
+    // Alternate between an explicit cancel and letting the destructor do it
+    bool explicit_cancel = random() & 1;
+
+    auto replace = [&](int64_t stream_id, bool cancel) {
+        if (cancel) {
+            std::unique_ptr<GrpcStream> stream = client->streams.take(stream_id);
+            if (!stream) {
+                return true;  // Ended meanwhile; reopen it all the same
+            }
+            if (explicit_cancel) {
+                stream->cancel();
+            }
+            streams.push_back(std::move(stream));
+            return true;
+        }
+        return !in_table(client, stream_id);
+    };
+
+    for (size_t i = 0; i < client->subscription_ids.size(); ++i) {
+        if (replace(client->subscription_ids[i].load(), i == victim)) {
+            open_subscription(client, i);
+            client->stats->streams_restarted.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (client->spec->has_bidi && replace(client->bidi_id.load(), victim == count - 1)) {
+        open_bidi(client);
+        client->stats->streams_restarted.fetch_add(1, std::memory_order_relaxed);
+    }
+    release_streams(client, streams);
+}
+
+// Close every stream at once and reopen them, as GrpcClient::close() and a
+// reconnect would. Runs on the close thread.
+void close_client(SimClient* client) {
+    std::lock_guard<std::mutex> lock(client->reopen_mutex);
+    std::vector<std::unique_ptr<GrpcStream>> streams = client->streams.take_all();
+    for (auto& stream : streams) {
+        stream->shutdown();
+    }
+    release_streams(client, streams);
+
+    for (size_t i = 0; i < client->subscription_ids.size(); ++i) {
+        open_subscription(client, i);
+    }
+    if (client->spec->has_bidi) {
+        open_bidi(client);
+    }
+    client->stats->clients_closed.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Runs on the send thread, as GrpcClient::stream_send() runs on the main
+// thread: the stream may be cancelled, closed or retired at any moment
+void send_bidi(SimClient* client) {
+    int64_t stream_id = client->bidi_id.load();
+    if (stream_id == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(client->pending_mutex);
+        client->pending.push_back(Clock::now());
+    }
+    bool queued = false;
+    client->streams.with_stream(stream_id, [&](GrpcStream& stream) {
+        queued = stream.is_active() && stream.send(client->bidi_message);
+    });
+    if (queued) {
+        client->stats->messages_sent.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        std::lock_guard<std::mutex> lock(client->pending_mutex);
+        client->pending.pop_back();
+    }
+}
+
+// Same shape as GrpcClient::unary: blocking, one completion queue per call,
+// response copied out of the ByteBuffer.
+bool run_unary(grpc::GenericStub& stub, const CallSpec& call) {
+    GODOT_GRPC_ALLOC_SCOPE(alloc::UNARY_CALL);
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(10));
+
+    grpc::Slice slice(call.request.data(), call.request.size());
+    GODOT_GRPC_ALLOC_NOTE_SLICE(call.request.size());
+    grpc::ByteBuffer request_buffer(&slice, 1);
+
+    grpc::CompletionQueue cq;
+    grpc::ByteBuffer response_buffer;
+    grpc::Status status;
+    std::unique_ptr<grpc::GenericClientAsyncResponseReader> rpc(
+        stub.PrepareUnaryCall(&context, call.method, request_buffer, &cq)
+    );
+    rpc->StartCall();
+    rpc->Finish(&response_buffer, &status, (void*)1);
+
+    void* got_tag;
+    bool ok = false;
+    cq.Next(&got_tag, &ok);
+    if (!ok || !status.ok()) {
+        return false;
+    }
+
+    std::vector<grpc::Slice> slices;
+    (void)response_buffer.Dump(&slices);
+    StreamBytes response_bytes(response_buffer.Length());
+    size_t offset = 0;
+    for (const auto& part : slices) {
+        std::memcpy(response_bytes.ptrw() + offset, part.begin(), part.size());
+        offset += part.size();
+    }
+    return true;
+}
+
+// ============================================================================
+// SCHEDULING
+// ============================================================================
+
+enum class EventKind { BIDI_SEND, UNARY, CHURN, CLOSE };
+
+struct TimedEvent {
+    Clock::time_point due;
+    SimClient* client;
+    EventKind kind;
+
+    bool operator>(const TimedEvent& other) const { return due > other.due; }
+};
+
+/**
+ * Fires periodic bidi writes, stream churn and closes, and hands due unary
+ * calls to the worker pool. One thread serves every client, so per-client
+ * cost is a heap entry rather than a sleeping thread.
+ */
+class Scheduler {
+public:
+    void push(const TimedEvent& event) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            events_.push(event);
+        }
+        cv_.notify_one();
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_.store(true);
+        }
+        cv_.notify_all();
+        {
+            std::lock_guard<std::mutex> lock(unary_mutex_);
+        }
+        unary_cv_.notify_all();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopped_) {
+            if (events_.empty()) {
+                cv_.wait(lock);
+                continue;
+            }
+            TimedEvent event = events_.top();
+            if (event.due > Clock::now()) {
+                cv_.wait_until(lock, event.due);
+                continue;
+            }
+            events_.pop();
+            lock.unlock();
+
+            SimClient* client = event.client;
+            Clock::duration period;
+            if (event.kind == EventKind::BIDI_SEND) {
+                send_bidi(client);
+                period = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(1.0 / client->spec->bidi_rate_hz));
+            } else if (event.kind == EventKind::CHURN) {
+                churn_client(client, random_);
+                period = jittered(client->spec->churn_ms);
+            } else if (event.kind == EventKind::CLOSE) {
+                close_client(client);
+                period = jittered(client->spec->close_ms);
+            } else {
+                if (client->unary_in_flight.exchange(true)) {
+                    client->stats->unary_skipped.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::lock_guard<std::mutex> unary_lock(unary_mutex_);
+                    unary_queue_.push_back(client);
+                    unary_cv_.notify_one();
+                }
+                period = std::chrono::milliseconds(client->spec->unary_interval_ms);
+            }
+
+            // Keep the cadence, but do not burst to catch up after a stall
+            event.due = std::max(event.due + period, Clock::now());
+            lock.lock();
+            events_.push(event);
+        }
+    }
+
+    void run_unary_worker() {
+        while (true) {
+            SimClient* client;
+            {
+                std::unique_lock<std::mutex> lock(unary_mutex_);
+                unary_cv_.wait(lock, [this] { return !unary_queue_.empty() || stopped_.load(); });
+                if (stopped_.load()) {
+                    return;
+                }
+                client = unary_queue_.front();
+                unary_queue_.pop_front();
+            }
+
+            Clock::time_point start = Clock::now();
+            bool ok = run_unary(*client->stub, client->spec->unary);
+            if (!g_stopping.load()) {
+                ScenarioStats* stats = client->stats;
+                stats->unary_calls.fetch_add(1, std::memory_order_relaxed);
+                if (ok) {
+                    stats->unary_latency.record(micros_since(start));
+                } else {
+                    stats->unary_errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            client->unary_in_flight.store(false);
+        }
+    }
+
+private:
+    // Uniform in [0.5, 1.5] x interval_ms so clients drift apart
+    Clock::duration jittered(int interval_ms) {
+        return std::chrono::milliseconds(interval_ms / 2 + std::uniform_int_distribution<int>(0, interval_ms)(random_));
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::priority_queue<TimedEvent, std::vector<TimedEvent>, std::greater<TimedEvent>> events_;
+    std::atomic<bool> stopped_{false};
+
+    std::mutex unary_mutex_;
+    std::condition_variable unary_cv_;
+    std::deque<SimClient*> unary_queue_;
+
+    std::mt19937 random_{777};  // Churn victims and intervals; scheduler thread only
+};
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+struct Report {
+    std::string name;
+    int clients = 0;
+    Histogram::Snapshot unary_latency;
+    Histogram::Snapshot round_trip;
+    Histogram::Snapshot first_message;
+    uint64_t unary_calls = 0;
+    uint64_t unary_errors = 0;
+    uint64_t unary_skipped = 0;
+    uint64_t messages_sent = 0;
+    uint64_t messages_received = 0;
+    uint64_t bytes_received = 0;
+    uint64_t streams_opened = 0;
+    uint64_t streams_finished = 0;
+    uint64_t stream_errors = 0;
+    uint64_t streams_restarted = 0;
+    uint64_t clients_closed = 0;
+
+    void add(const Report& other) {
+        clients += other.clients;
+        unary_latency.merge(other.unary_latency);
+        round_trip.merge(other.round_trip);
+        first_message.merge(other.first_message);
+        unary_calls += other.unary_calls;
+        unary_errors += other.unary_errors;
+        unary_skipped += other.unary_skipped;
+        messages_sent += other.messages_sent;
+        messages_received += other.messages_received;
+        bytes_received += other.bytes_received;
+        streams_opened += other.streams_opened;
+        streams_finished += other.streams_finished;
+        stream_errors += other.stream_errors;
+        streams_restarted += other.streams_restarted;
+        clients_closed += other.clients_closed;
+    }
+};
+
+Report make_report(const ScenarioSpec& spec, const ScenarioStats& stats) {
+    Report report;
+    report.name = spec.name;
+    report.clients = spec.clients;
+    report.unary_latency = stats.unary_latency.snapshot();
+    report.round_trip = stats.round_trip.snapshot();
+    report.first_message = stats.first_message.snapshot();
+    report.unary_calls = stats.unary_calls.load();
+    report.unary_errors = stats.unary_errors.load();
+    report.unary_skipped = stats.unary_skipped.load();
+    report.messages_sent = stats.messages_sent.load();
+    report.messages_received = stats.messages_received.load();
+    report.bytes_received = stats.bytes_received.load();
+    report.streams_opened = stats.streams_opened.load();
+    report.streams_finished = stats.streams_finished.load();
+    report.stream_errors = stats.stream_errors.load();
+    report.streams_restarted = stats.streams_restarted.load();
+    report.clients_closed = stats.clients_closed.load();
+    return report;
+}
+
+void print_latency(const char* label, const Histogram::Snapshot& latency) {
+    if (latency.samples == 0) {
+        return;
+    }
+    std::printf("  %-14s p50 %llu  p90 %llu  p99 %llu  max %llu us  (%llu samples)\n", label,
+        (unsigned long long)latency.percentile(0.50), (unsigned long long)latency.percentile(0.90),
+        (unsigned long long)latency.percentile(0.99), (unsigned long long)latency.max_us,
+        (unsigned long long)latency.samples);
+}
+
+void print_report(const Report& report, double elapsed_s) {
+    std::printf("[%s] %d clients\n", report.name.c_str(), report.clients);
+    std::printf("  streams        %llu opened, %llu finished, %llu errors, %llu restarted\n",
+        (unsigned long long)report.streams_opened, (unsigned long long)report.streams_finished,
+        (unsigned long long)report.stream_errors, (unsigned long long)report.streams_restarted);
+    if (report.clients_closed > 0) {
+        std::printf("  closes         %llu (every stream of a client at once)\n", (unsigned long long)report.clients_closed);
+    }
+    std::printf("  received       %.0f msg/s, %.2f MB/s\n",
+        report.messages_received / elapsed_s, report.bytes_received / elapsed_s / 1e6);
+    if (report.messages_sent > 0) {
+        std::printf("  sent           %.0f msg/s\n", report.messages_sent / elapsed_s);
+    }
+    if (report.unary_calls + report.unary_skipped > 0) {
+        std::printf("  unary          %.0f calls/s, %llu errors, %llu skipped\n",
+            report.unary_calls / elapsed_s, (unsigned long long)report.unary_errors,
+            (unsigned long long)report.unary_skipped);
+    }
+    print_latency("first message", report.first_message);
+    print_latency("round trip", report.round_trip);
+    print_latency("unary", report.unary_latency);
+}
+
+std::string json_escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+std::string latency_json(const Histogram::Snapshot& latency) {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+        "{\"samples\": %llu, \"mean_us\": %.1f, \"p50_us\": %llu, \"p90_us\": %llu, \"p99_us\": %llu, \"max_us\": %llu}",
+        (unsigned long long)latency.samples, latency.mean_us(),
+        (unsigned long long)latency.percentile(0.50), (unsigned long long)latency.percentile(0.90),
+        (unsigned long long)latency.percentile(0.99), (unsigned long long)latency.max_us);
+    return buffer;
+}
+
+std::string report_json(const Report& report, double elapsed_s) {
+    // Appended, not formatted: escaped, the name has no length bound
+    std::string json = "{\"name\": \"" + json_escape(report.name) + "\", ";
+    char buffer[1024];
+    std::snprintf(buffer, sizeof(buffer),
+        "\"clients\": %d, \"streams_opened\": %llu, \"streams_finished\": %llu, "
+        "\"stream_errors\": %llu, \"streams_restarted\": %llu, \"clients_closed\": %llu, \"messages_received\": %llu, \"bytes_received\": %llu, "
+        "\"messages_per_second\": %.1f, \"megabytes_per_second\": %.3f, \"messages_sent\": %llu, "
+        "\"unary_calls\": %llu, \"unary_errors\": %llu, \"unary_skipped\": %llu, \"unary_calls_per_second\": %.1f, ",
+        report.clients,
+        (unsigned long long)report.streams_opened, (unsigned long long)report.streams_finished,
+        (unsigned long long)report.stream_errors, (unsigned long long)report.streams_restarted,
+        (unsigned long long)report.clients_closed, (unsigned long long)report.messages_received,
+        (unsigned long long)report.bytes_received, report.messages_received / elapsed_s,
+        report.bytes_received / elapsed_s / 1e6, (unsigned long long)report.messages_sent,
+        (unsigned long long)report.unary_calls, (unsigned long long)report.unary_errors,
+        (unsigned long long)report.unary_skipped, report.unary_calls / elapsed_s);
+    return json + buffer +
+        "\"first_message\": " + latency_json(report.first_message) +
+        ", \"round_trip\": " + latency_json(report.round_trip) +
+        ", \"unary_latency\": " + latency_json(report.unary_latency) + "}";
+}
+
+// Per-operation allocation counts; all zero unless built with GODOT_GRPC_ALLOC_STATS
+struct AllocReport {
+    alloc::Counters ops[alloc::OP_COUNT];
+
+    static AllocReport take() {
+        AllocReport report;
+        for (int i = 0; i < alloc::OP_COUNT; ++i) {
+            report.ops[i] = alloc::snapshot(static_cast<alloc::Op>(i));
+        }
+        return report;
+    }
+};
+
+double per_op(uint64_t value, uint64_t operations) {
+    return operations > 0 ? double(value) / double(operations) : 0.0;
+}
+
+void print_alloc_report(const AllocReport& report) {
+    std::printf("[allocations]\n");
+    for (int i = 0; i < alloc::OP_COUNT; ++i) {
+        const alloc::Counters& counters = report.ops[i];
+        std::printf("  %-14s %.2f allocs/op, %.0f B/op  (%llu ops)\n", alloc::op_name(static_cast<alloc::Op>(i)),
+            per_op(counters.allocations, counters.operations), per_op(counters.bytes, counters.operations),
+            (unsigned long long)counters.operations);
+    }
+}
+
+std::string alloc_json(const AllocReport& report) {
+    std::string json = "{";
+    for (int i = 0; i < alloc::OP_COUNT; ++i) {
+        const alloc::Counters& counters = report.ops[i];
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer),
+            "%s\"%s\": {\"operations\": %llu, \"allocations\": %llu, \"bytes\": %llu, "
+            "\"allocations_per_op\": %.3f, \"bytes_per_op\": %.1f}",
+            i > 0 ? ", " : "", alloc::op_name(static_cast<alloc::Op>(i)),
+            (unsigned long long)counters.operations, (unsigned long long)counters.allocations,
+            (unsigned long long)counters.bytes, per_op(counters.allocations, counters.operations),
+            per_op(counters.bytes, counters.operations));
+        json += buffer;
+    }
+    return json + "}";
+}
+
+bool write_json(const std::string& path, const LoadConfig& config, double elapsed_s,
+        const std::vector<Report>& reports, const Report& total, const AllocReport* allocations) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    std::fprintf(file, "{\n  \"endpoint\": \"%s\",\n  \"duration_s\": %.1f,\n  \"elapsed_s\": %.3f,\n",
+        json_escape(config.endpoint).c_str(), config.duration_s, elapsed_s);
+    std::fprintf(file, "  \"scenarios\": [\n");
+    for (size_t i = 0; i < reports.size(); ++i) {
+        std::fprintf(file, "    %s%s\n", report_json(reports[i], elapsed_s).c_str(), i + 1 < reports.size() ? "," : "");
+    }
+    std::fprintf(file, "  ],\n");
+    if (allocations) {
+        std::fprintf(file, "  \"allocations\": %s,\n", alloc_json(*allocations).c_str());
+    }
+    std::fprintf(file, "  \"aggregate\": %s\n}\n", report_json(total, elapsed_s).c_str());
+    return std::fclose(file) == 0;
+}
+
+void usage() {
+    std::fprintf(stderr,
+        "usage: godot_grpc_loadgen <scenario.ini> [options]\n"
+        "  --endpoint=TARGET   Override the scenario endpoint\n"
+        "  --duration=SECONDS  Override the run length\n"
+        "  --ramp-up=SECONDS   Override the client start window\n"
+        "  --channels=N        Override the channel count (0 = one per client)\n"
+        "  --json=PATH         Also write the results as JSON\n"
+        "  --log-level=N       Extension log level, 0 (none) to 5 (trace); default 1\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argv[1][0] == '-') {
+        usage();
+        return 2;
+    }
+
+    LoadConfig config;
+    std::string error;
+    if (!parse_scenario_file(argv[1], &config, &error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+
+    std::string json_path;
+    Logger::set_level(LogLevel::ERR);
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value = arg.find('=') == std::string::npos ? "" : arg.substr(arg.find('=') + 1);
+        if (arg.rfind("--endpoint=", 0) == 0) {
+            config.endpoint = value;
+        } else if (arg.rfind("--duration=", 0) == 0) {
+            config.duration_s = std::max(0.1, std::atof(value.c_str()));
+        } else if (arg.rfind("--ramp-up=", 0) == 0) {
+            config.ramp_up_s = std::max(0.0, std::atof(value.c_str()));
+        } else if (arg.rfind("--channels=", 0) == 0) {
+            config.channels = std::max(0, std::atoi(value.c_str()));
+        } else if (arg.rfind("--json=", 0) == 0) {
+            json_path = value;
+        } else if (arg.rfind("--log-level=", 0) == 0) {
+            Logger::set_level(static_cast<LogLevel>(std::clamp(std::atoi(value.c_str()), 0, 5)));
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    // Start-up costs are paid here, outside the measured run
+    runtime::Timings startup = runtime::initialize();
+    std::printf("gRPC runtime: core %.1f ms, resolver %.1f ms, TLS %.1f ms\n",
+        startup.core_ms, startup.resolver_ms, startup.tls_ms);
+
+    // [mock] sections are served in-process, replacing the endpoint
+    mock::Server mock_server;
+    if (!config.mocks.empty()) {
+        for (const auto& mock : config.mocks) {
+            mock_server.set_script(mock.first, mock.second);
+        }
+        if (!mock_server.start(config.mock_listen, &error)) {
+            std::fprintf(stderr, "mock server: %s\n", error.c_str());
+            return 1;
+        }
+        config.endpoint = mock_server.endpoint();
+    }
+
+    // Clients, shuffled so each scenario's starts are spread over the whole ramp-up
+    std::vector<std::unique_ptr<ScenarioStats>> stats;
+    std::vector<std::unique_ptr<SimClient>> clients;
+    for (const ScenarioSpec& spec : config.scenarios) {
+        stats.push_back(std::make_unique<ScenarioStats>());
+        for (int i = 0; i < spec.clients; ++i) {
+            auto client = std::make_unique<SimClient>(&spec, stats.back().get());
+            clients.push_back(std::move(client));
+        }
+    }
+    std::mt19937 rng(12345);
+    std::shuffle(clients.begin(), clients.end(), rng);
+
+    int channel_count = config.channels == 0 ? int(clients.size()) : std::min<int>(config.channels, int(clients.size()));
+    ChannelOptions channel_options;
+    channel_options.max_send_message_length = config.max_message_size;
+    channel_options.max_receive_message_length = config.max_message_size;
+    channel_options.local_subchannel_pool = true;  // One connection per channel, like separate processes
+    std::vector<std::unique_ptr<GrpcChannelPool>> channels;
+    for (int i = 0; i < channel_count; ++i) {
+        channels.push_back(std::make_unique<GrpcChannelPool>());
+        if (!channels.back()->create_channel(config.endpoint, channel_options)) {
+            std::fprintf(stderr, "cannot create channel to %s\n", config.endpoint.c_str());
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < clients.size(); ++i) {
+        clients[i]->stub = channels[i % channels.size()]->get_stub();
+    }
+
+    std::printf("godot_grpc_loadgen: %zu clients in %zu scenarios over %d channels, %s%s for %.1f s\n",
+        clients.size(), config.scenarios.size(), channel_count, config.endpoint.c_str(),
+        mock_server.is_running() ? " (mock)" : "", config.duration_s);
+    std::fflush(stdout);
+
+    // Sends, churn and closes each get a thread, so they race on the clients'
+    // stream tables as the main thread and stream threads do in GrpcClient
+    Scheduler scheduler;
+    Scheduler churn_scheduler;
+    Scheduler close_scheduler;
+    std::thread scheduler_thread(&Scheduler::run, &scheduler);
+    std::thread churn_thread(&Scheduler::run, &churn_scheduler);
+    std::thread close_thread(&Scheduler::run, &close_scheduler);
+    std::vector<std::thread> unary_workers;
+    for (int i = 0; i < config.unary_threads; ++i) {
+        unary_workers.emplace_back(&Scheduler::run_unary_worker, &scheduler);
+    }
+
+    alloc::reset();
+    Clock::time_point start = Clock::now();
+    Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.duration_s));
+
+    std::thread starter([&] {
+        std::mt19937 jitter(54321);
+        std::uniform_real_distribution<double> phase(0.0, 1.0);
+        for (size_t i = 0; i < clients.size() && !g_stopping.load(); ++i) {
+            auto due = start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(config.ramp_up_s * double(i) / double(clients.size())));
+            std::this_thread::sleep_until(due);
+            if (g_stopping.load()) {
+                break;
+            }
+
+            SimClient* client = clients[i].get();
+            start_client(client);
+
+            // Random phase so clients do not fire in lockstep
+            Clock::time_point now = Clock::now();
+            if (client->spec->has_bidi && client->spec->bidi_rate_hz > 0.0) {
+                scheduler.push({now + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(phase(jitter) / client->spec->bidi_rate_hz)), client, EventKind::BIDI_SEND});
+            }
+            if (client->spec->has_unary) {
+                scheduler.push({now + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(phase(jitter) * client->spec->unary_interval_ms / 1000.0)), client, EventKind::UNARY});
+            }
+            if (client->spec->churn_ms > 0) {
+                churn_scheduler.push({now + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(phase(jitter) * client->spec->churn_ms / 1000.0)), client, EventKind::CHURN});
+            }
+            if (client->spec->close_ms > 0) {
+                close_scheduler.push({now + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(phase(jitter) * client->spec->close_ms / 1000.0)), client, EventKind::CLOSE});
+            }
+        }
+    });
+
+    // Progress once a second on stderr
+    uint64_t last_received = 0;
+    while (Clock::now() < end) {
+        std::this_thread::sleep_until(std::min(end, Clock::now() + std::chrono::seconds(1)));
+        uint64_t received = 0;
+        uint64_t errors = 0;
+        for (const auto& scenario_stats : stats) {
+            received += scenario_stats->messages_received.load();
+            errors += scenario_stats->stream_errors.load() + scenario_stats->unary_errors.load();
+        }
+        std::fprintf(stderr, "  t=%5.1fs  %10llu msg received (+%llu)  %llu errors\n",
+            micros_since(start) / 1e6, (unsigned long long)received,
+            (unsigned long long)(received - last_received), (unsigned long long)errors);
+        last_received = received;
+    }
+
+    g_stopping.store(true);
+    double elapsed_s = micros_since(start) / 1e6;
+
+    std::vector<Report> reports;
+    Report total;
+    total.name = "all";
+    for (size_t i = 0; i < config.scenarios.size(); ++i) {
+        reports.push_back(make_report(config.scenarios[i], *stats[i]));
+        total.add(reports.back());
+    }
+#ifdef GODOT_GRPC_ALLOC_STATS
+    AllocReport allocation_report = AllocReport::take();
+    const AllocReport* allocations = &allocation_report;
+#else
+    const AllocReport* allocations = nullptr;
+#endif
+
+    scheduler.stop();
+    churn_scheduler.stop();
+    close_scheduler.stop();
+    scheduler_thread.join();
+    churn_thread.join();
+    close_thread.join();
+    for (std::thread& worker : unary_workers) {
+        worker.join();
+    }
+    starter.join();
+
+    std::printf("\nResults over %.1f s (including %.1f s ramp-up):\n", elapsed_s, std::min(config.ramp_up_s, elapsed_s));
+    for (const Report& report : reports) {
+        print_report(report, elapsed_s);
+    }
+    if (reports.size() > 1) {
+        print_report(total, elapsed_s);
+    }
+    if (allocations) {
+        print_alloc_report(*allocations);
+    }
+
+    if (!json_path.empty()) {
+        if (write_json(json_path, config, elapsed_s, reports, total, allocations)) {
+            std::printf("Results written to %s\n", json_path.c_str());
+        } else {
+            std::fprintf(stderr, "cannot write %s\n", json_path.c_str());
+        }
+    }
+    std::fflush(stdout);
+
+    // Stream destructors cancel and join their threads; the resulting
+    // CANCELLED statuses are expected, so keep them out of the log
+    Logger::set_level(LogLevel::NONE);
+    clients.clear();
+    channels.clear();
+    mock_server.stop();
+    runtime::shutdown();
+    return 0;
+}
@@ -0,0 +1,290 @@
+#include "scenario.h"
+#include "util/wire_format.h"
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace godot_grpc {
+namespace loadgen {
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool parse_int(const std::string& text, long long min_value, long long* out) {
+    if (text.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    long long value = std::strtoll(text.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || value < min_value) {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+bool parse_double(const std::string& text, double min_value, double* out) {
+    if (text.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    double value = std::strtod(text.c_str(), &end);
+    if (*end != '\0' || !(value >= min_value)) {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+// "<method> [field specs...]"
+bool parse_call(const std::string& value, CallSpec* call, std::string* error) {
+    std::istringstream words(value);
+    std::vector<std::string> fields;
+    std::string word;
+    words >> call->method;
+    if (call->method.empty() || call->method[0] != '/') {
+        *error = "expected a full method path such as /bench.Bench/Flood";
+        return false;
+    }
+    while (words >> word) {
+        fields.push_back(word);
+    }
+    return encode_request(fields, &call->request, error);
+}
+
+} // namespace
+
+bool encode_request(const std::vector<std::string>& fields, std::vector<uint8_t>* out, std::string* error) {
+    wire::Buffer buffer;
+    for (const std::string& field : fields) {
+        size_t first = field.find(':');
+        size_t second = first == std::string::npos ? std::string::npos : field.find(':', first + 1);
+        long long number = 0;
+        if (second == std::string::npos || second != first + 2 ||
+                !parse_int(field.substr(0, first), 1, &number) || number > 536870911) {
+            *error = "bad field spec '" + field + "' (expected <number>:<v|s|b>:<value>)";
+            return false;
+        }
+        char kind = field[first + 1];
+        std::string value = field.substr(second + 1);
+
+        long long integer = 0;
+        switch (kind) {
+            case 'v':
+                if (!parse_int(value, INT64_MIN, &integer)) {
+                    *error = "bad varint in '" + field + "'";
+                    return false;
+                }
+                buffer.put_tag(uint32_t(number), wire::VARINT);
+                buffer.put_varint(uint64_t(integer));
+                break;
+            case 's':
+                buffer.put_tag(uint32_t(number), wire::LENGTH_DELIMITED);
+                buffer.put_varint(value.size());
+                buffer.put_bytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+                break;
+            case 'b': {
+                if (!parse_int(value, 0, &integer)) {
+                    *error = "bad byte count in '" + field + "'";
+                    return false;
+                }
+                std::vector<uint8_t> zeros(size_t(integer), 0);
+                buffer.put_tag(uint32_t(number), wire::LENGTH_DELIMITED);
+                buffer.put_varint(zeros.size());
+                buffer.put_bytes(zeros.data(), zeros.size());
+                break;
+            }
+            default:
+                *error = "unknown field kind '" + std::string(1, kind) + "' in '" + field + "'";
+                return false;
+        }
+    }
+    out->assign(buffer.data(), buffer.data() + buffer.size());
+    return true;
+}
+
+bool parse_scenario_file(const std::string& path, LoadConfig* config, std::string* error) {
+    std::ifstream file(path);
+    if (!file) {
+        *error = "cannot open " + path;
+        return false;
+    }
+
+    ScenarioSpec* scenario = nullptr;
+    mock::MethodScript* mock_script = nullptr;
+    std::string line;
+    int line_number = 0;
+    auto fail = [&](const std::string& message) {
+        *error = path + ":" + std::to_string(line_number) + ": " + message;
+        return false;
+    };
+
+    while (std::getline(file, line)) {
+        ++line_number;
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+
+        if (line.front() == '[') {
+            if (line.back() != ']' || line.size() < 3) {
+                return fail("bad section header");
+            }
+            std::string name = trim(line.substr(1, line.size() - 2));
+            if (name.compare(0, 5, "mock ") == 0) {
+                std::string method = trim(name.substr(5));
+                if (method.empty() || method[0] != '/') {
+                    return fail("expected [mock /package.Service/Method]");
+                }
+                config->mocks.emplace_back(method, mock::MethodScript());
+                mock_script = &config->mocks.back().second;
+                scenario = nullptr;
+                continue;
+            }
+            config->scenarios.emplace_back();
+            scenario = &config->scenarios.back();
+            scenario->name = name;
+            mock_script = nullptr;
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            return fail("expected key = value");
+        }
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+        long long integer = 0;
+        double number = 0.0;
+        std::string call_error;
+
+        if (mock_script) {
+            if (key == "response") {
+                std::istringstream words(value);
+                std::vector<std::string> fields;
+                std::string word;
+                std::vector<uint8_t> response;
+                while (words >> word) {
+                    fields.push_back(word);
+                }
+                if (!encode_request(fields, &response, &call_error)) return fail(call_error);
+                mock_script->responses.emplace_back(response.begin(), response.end());
+            } else if (key == "repeat") {
+                if (!parse_int(value, 0, &integer) || integer > INT32_MAX) return fail("repeat must be >= 0");
+                mock_script->repeat = int(integer);
+            } else if (key == "echo") {
+                if (value != "0" && value != "1") return fail("echo must be 0 or 1");
+                mock_script->echo = value == "1";
+            } else if (key == "reply_per_message") {
+                if (value != "0" && value != "1") return fail("reply_per_message must be 0 or 1");
+                mock_script->reply_per_message = value == "1";
+            } else if (key == "delay_ms") {
+                if (!parse_int(value, 0, &integer) || integer > INT32_MAX) return fail("delay_ms must be >= 0");
+                mock_script->delay_ms = int(integer);
+            } else if (key == "jitter_ms") {
+                if (!parse_int(value, 0, &integer) || integer > INT32_MAX) return fail("jitter_ms must be >= 0");
+                mock_script->jitter_ms = int(integer);
+            } else if (key == "read_delay_ms") {
+                if (!parse_int(value, 0, &integer) || integer > INT32_MAX) return fail("read_delay_ms must be >= 0");
+                mock_script->read_delay_ms = int(integer);
+            } else if (key == "status_code") {
+                if (!parse_int(value, 0, &integer) || integer > 16) return fail("status_code must be 0..16");
+                mock_script->status_code = int(integer);
+            } else if (key == "status_message") {
+                mock_script->status_message = value;
+            } else if (key == "error_rate") {
+                if (!parse_double(value, 0.0, &number) || number > 1.0) return fail("error_rate must be 0..1");
+                mock_script->error_rate = number;
+            } else if (key == "disconnect_after") {
+                if (!parse_int(value, -1, &integer) || integer > INT32_MAX) return fail("disconnect_after must be >= -1");
+                mock_script->disconnect_after = int(integer);
+            } else {
+                return fail("unknown mock key '" + key + "'");
+            }
+            continue;
+        }
+
+        if (!scenario) {
+            // Global settings before the first section
+            if (key == "endpoint") {
+                config->endpoint = value;
+            } else if (key == "duration") {
+                if (!parse_double(value, 0.1, &number)) return fail("duration must be >= 0.1 seconds");
+                config->duration_s = number;
+            } else if (key == "ramp_up") {
+                if (!parse_double(value, 0.0, &number)) return fail("ramp_up must be >= 0 seconds");
+                config->ramp_up_s = number;
+            } else if (key == "channels") {
+                if (!parse_int(value, 0, &integer)) return fail("channels must be >= 0");
+                config->channels = int(integer);
+            } else if (key == "unary_threads") {
+                if (!parse_int(value, 1, &integer)) return fail("unary_threads must be >= 1");
+                config->unary_threads = int(integer);
+            } else if (key == "max_message_size") {
+                if (!parse_int(value, 1, &integer) || integer > INT32_MAX) return fail("bad max_message_size");
+                config->max_message_size = int(integer);
+            } else if (key == "mock_listen") {
+                config->mock_listen = value;
+            } else {
+                return fail("unknown setting '" + key + "'");
+            }
+            continue;
+        }
+
+        if (key == "clients") {
+            if (!parse_int(value, 1, &integer) || integer > 1000000) return fail("clients must be 1..1000000");
+            scenario->clients = int(integer);
+        } else if (key == "subscribe") {
+            CallSpec call;
+            if (!parse_call(value, &call, &call_error)) return fail(call_error);
+            scenario->subscriptions.push_back(std::move(call));
+        } else if (key == "bidi") {
+            if (scenario->has_bidi) return fail("only one bidi stream per scenario");
+            if (!parse_call(value, &scenario->bidi, &call_error)) return fail(call_error);
+            scenario->has_bidi = true;
+        } else if (key == "bidi_rate") {
+            if (!parse_double(value, 0.0, &number)) return fail("bidi_rate must be >= 0 Hz");
+            scenario->bidi_rate_hz = number;
+        } else if (key == "unary") {
+            if (scenario->has_unary) return fail("only one unary call per scenario");
+            if (!parse_call(value, &scenario->unary, &call_error)) return fail(call_error);
+            scenario->has_unary = true;
+        } else if (key == "unary_interval_ms") {
+            if (!parse_int(value, 1, &integer)) return fail("unary_interval_ms must be >= 1");
+            scenario->unary_interval_ms = int(integer);
+        } else if (key == "churn_ms") {
+            if (!parse_int(value, 0, &integer) || integer > INT32_MAX) return fail("churn_ms must be >= 0");
+            scenario->churn_ms = int(integer);
+        } else if (key == "close_ms") {
+            if (!parse_int(value, 0, &integer) || integer > INT32_MAX) return fail("close_ms must be >= 0");
+            scenario->close_ms = int(integer);
+        } else {
+            return fail("unknown scenario key '" + key + "'");
+        }
+    }
+
+    if (config->scenarios.empty()) {
+        *error = path + ": no [scenario] sections";
+        return false;
+    }
+    for (const ScenarioSpec& spec : config->scenarios) {
+        if (spec.subscriptions.empty() && !spec.has_bidi && !spec.has_unary) {
+            *error = path + ": scenario '" + spec.name + "' makes no calls";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace loadgen
+} // namespace godot_grpc
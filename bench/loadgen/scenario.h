@@ -0,0 +1,82 @@
+#ifndef GODOT_GRPC_LOADGEN_SCENARIO_H
+#define GODOT_GRPC_LOADGEN_SCENARIO_H
+
+#include "util/mock_server.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace godot_grpc {
+namespace loadgen {
+
+/**
+ * One RPC a simulated client makes: a full method path and the encoded
+ * request sent with it.
+ */
+struct CallSpec {
+    std::string method;
+    std::vector<uint8_t> request;
+};
+
+/**
+ * A group of identical clients. Each client opens every subscription
+ * (server stream) once, optionally keeps one bidi stream it writes to at
+ * bidi_rate_hz, and optionally makes a blocking unary call every
+ * unary_interval_ms. With churn_ms set, clients also cancel and reopen a
+ * random stream (and reopen any the server ended) about that often, and
+ * with close_ms set they close and reopen all their streams at once, to
+ * soak the stream lifecycle.
+ */
+struct ScenarioSpec {
+    std::string name;
+    int clients = 1;
+
+    std::vector<CallSpec> subscriptions;
+
+    bool has_bidi = false;
+    CallSpec bidi;
+    double bidi_rate_hz = 30.0;
+
+    bool has_unary = false;
+    CallSpec unary;
+    int unary_interval_ms = 1000;
+
+    int churn_ms = 0;  // 0 = streams live for the whole run
+    int close_ms = 0;  // 0 = never
+};
+
+/**
+ * A whole load run: global settings plus the scenarios running side by side.
+ */
+struct LoadConfig {
+    std::string endpoint = "dns:///localhost:50051";
+    double duration_s = 30.0;
+    double ramp_up_s = 5.0;       // Client starts are spread over this window
+    int channels = 8;             // Clients share channels round-robin; 0 = one per client
+    int unary_threads = 16;       // Workers running blocking unary calls
+    int max_message_size = 16 * 1024 * 1024;
+    std::vector<ScenarioSpec> scenarios;
+
+    // [mock <method>] sections: when present, calls go to an in-process
+    // mock server listening on mock_listen instead of the endpoint
+    std::vector<std::pair<std::string, mock::MethodScript>> mocks;
+    std::string mock_listen = "127.0.0.1:0";
+};
+
+/**
+ * Parse an INI-style scenario file (see bench/loadgen/README.md).
+ * Returns false and sets error (with the line number) on the first problem.
+ */
+bool parse_scenario_file(const std::string& path, LoadConfig* config, std::string* error);
+
+/**
+ * Encode a request from field specs such as "1:v:1000", "2:s:hello" or
+ * "3:b:64" (varint, string, and that many zero bytes).
+ */
+bool encode_request(const std::vector<std::string>& fields, std::vector<uint8_t>* out, std::string* error);
+
+} // namespace loadgen
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_LOADGEN_SCENARIO_H
@@ -0,0 +1,561 @@
+// Network impairment proxy.
+//
+// Forwards TCP connections from a local port to a target (usually the demo
+// server) and degrades the link in between: one-way latency with jitter,
+// per-direction bandwidth caps, periodic stalls where nothing moves, and
+// connection resets. Runs are reproducible for a given --seed.
+//
+// Build with -DGODOT_GRPC_BUILD_NETPROXY=ON and run:
+//   ./godot_grpc_netproxy --listen=127.0.0.1:50052 --target=127.0.0.1:50051 --profile=3g
+//
+// See bench/netproxy/README.md for the options and profiles.
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t READ_CHUNK = 16 * 1024;
+// Bytes held per direction before the proxy stops reading, so a slow link
+// pushes back on the sender through TCP flow control. Capped links queue
+// about 250 ms worth, like a modest router buffer.
+constexpr size_t MAX_QUEUED = 4 * 1024 * 1024;
+constexpr size_t MIN_QUEUED = 64 * 1024;
+
+/**
+ * Impairment of one direction of a connection.
+ */
+struct LinkSpec {
+    int latency_ms = 0;           // One way
+    int jitter_ms = 0;            // Uniform extra delay in [0, jitter_ms]
+    int64_t bytes_per_second = 0; // 0 = unlimited
+};
+
+struct ProxyConfig {
+    std::string listen = "127.0.0.1:50052";
+    std::string target = "127.0.0.1:50051";
+    LinkSpec up;    // Client to server
+    LinkSpec down;  // Server to client
+    int stall_every_ms = 0;       // Mean time between stalls; 0 = never
+    int stall_ms = 0;             // Length of each stall
+    double reset_every_s = 0.0;   // Mean connection lifetime before a reset; 0 = never
+    uint32_t seed = 1;
+};
+
+// Kilobits per second to bytes per second
+int64_t kbps(int64_t kilobits) {
+    return kilobits * 1000 / 8;
+}
+
+/**
+ * Presets approximating common mobile and Wi-Fi conditions.
+ */
+bool apply_profile(const std::string& name, ProxyConfig* config) {
+    if (name == "wifi") {
+        config->up = { 3, 2, kbps(20000) };
+        config->down = { 3, 2, kbps(50000) };
+    } else if (name == "lte") {
+        config->up = { 25, 10, kbps(4000) };
+        config->down = { 25, 10, kbps(12000) };
+    } else if (name == "3g") {
+        config->up = { 100, 40, kbps(750) };
+        config->down = { 100, 40, kbps(1600) };
+        config->stall_every_ms = 10000;
+        config->stall_ms = 400;
+    } else if (name == "flaky") {
+        config->up = { 40, 60, kbps(2000) };
+        config->down = { 40, 60, kbps(4000) };
+        config->stall_every_ms = 3000;
+        config->stall_ms = 800;
+        config->reset_every_s = 30.0;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Per-direction queue limit
+size_t queue_limit(const LinkSpec& link) {
+    if (link.bytes_per_second <= 0) {
+        return MAX_QUEUED;
+    }
+    return std::clamp(size_t(link.bytes_per_second / 4), MIN_QUEUED, MAX_QUEUED);
+}
+
+struct Chunk {
+    Clock::time_point release;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * One direction: a reader thread queues chunks stamped with their release
+ * time, a writer thread sends them when due at the capped rate.
+ */
+struct Pipe {
+    int from = -1;
+    int to = -1;
+    LinkSpec link;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Chunk> queue;
+    size_t queued_bytes = 0;
+    size_t max_queued = MAX_QUEUED;
+    bool eof = false;
+    Clock::time_point last_release;  // Release times never go backwards: TCP keeps order
+
+    uint64_t bytes = 0;
+};
+
+class Connection {
+public:
+    Connection(int id, int client_fd, int server_fd, const ProxyConfig& config)
+        : id_(id), config_(config), client_fd_(client_fd), server_fd_(server_fd),
+          random_(config.seed + uint32_t(id)) {
+        up_.from = client_fd;
+        up_.to = server_fd;
+        up_.link = config.up;
+        down_.from = server_fd;
+        down_.to = client_fd;
+        down_.link = config.down;
+
+        up_.max_queued = queue_limit(config.up);
+        down_.max_queued = queue_limit(config.down);
+
+        Clock::time_point now = Clock::now();
+        up_.last_release = now;
+        down_.last_release = now;
+        next_stall_ = config.stall_every_ms > 0 ? now + exponential_ms(config.stall_every_ms) : Clock::time_point::max();
+        reset_at_ = config.reset_every_s > 0.0 ? now + exponential_ms(int(config.reset_every_s * 1000.0)) : Clock::time_point::max();
+    }
+
+    ~Connection() {
+        close(client_fd_);
+        close(server_fd_);
+    }
+
+    void run() {
+        Clock::time_point opened = Clock::now();
+        std::thread up_reader(&Connection::read_loop, this, &up_);
+        std::thread down_reader(&Connection::read_loop, this, &down_);
+        std::thread up_writer(&Connection::write_loop, this, &up_);
+        write_loop(&down_);
+        up_writer.join();
+        down_reader.join();
+        up_reader.join();
+
+        double seconds = std::chrono::duration<double>(Clock::now() - opened).count();
+        std::fprintf(stderr, "[%d] closed after %.1f s: up %.2f MB, down %.2f MB, %d stalls%s\n",
+            id_, seconds, up_.bytes / 1e6, down_.bytes / 1e6, stalls_, reset_.load() ? ", reset" : "");
+    }
+
+private:
+    Clock::duration exponential_ms(int mean_ms) {
+        std::lock_guard<std::mutex> lock(random_mutex_);
+        std::exponential_distribution<double> distribution(1.0 / double(mean_ms));
+        return std::chrono::milliseconds(int64_t(distribution(random_)));
+    }
+
+    // Stop both directions. shutdown() wakes threads blocked in recv()
+    void abort_all(bool reset) {
+        if (closing_.exchange(true)) {
+            return;
+        }
+        if (reset) {
+            // Zero linger turns the final close() into a RST. Only the read
+            // side is shut down, so no FIN goes out first.
+            std::fprintf(stderr, "[%d] reset\n", id_);
+            reset_.store(true);
+            linger abort = { 1, 0 };
+            setsockopt(client_fd_, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+            setsockopt(server_fd_, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+            shutdown(client_fd_, SHUT_RD);
+            shutdown(server_fd_, SHUT_RD);
+        } else {
+            shutdown(client_fd_, SHUT_RDWR);
+            shutdown(server_fd_, SHUT_RDWR);
+        }
+        for (Pipe* pipe : { &up_, &down_ }) {
+            std::lock_guard<std::mutex> lock(pipe->mutex);
+            pipe->cv.notify_all();
+        }
+    }
+
+    void read_loop(Pipe* pipe) {
+        std::vector<uint8_t> buffer(READ_CHUNK);
+        while (!closing_.load()) {
+            ssize_t received = recv(pipe->from, buffer.data(), buffer.size(), 0);
+            std::unique_lock<std::mutex> lock(pipe->mutex);
+            if (received <= 0) {
+                pipe->eof = true;
+                pipe->cv.notify_all();
+                return;
+            }
+
+            int jitter = 0;
+            if (pipe->link.jitter_ms > 0) {
+                std::lock_guard<std::mutex> random_lock(random_mutex_);
+                jitter = std::uniform_int_distribution<int>(0, pipe->link.jitter_ms)(random_);
+            }
+            Clock::time_point release = Clock::now() + std::chrono::milliseconds(pipe->link.latency_ms + jitter);
+            release = std::max(release, pipe->last_release);
+            pipe->last_release = release;
+
+            pipe->queue.push_back({ release, std::vector<uint8_t>(buffer.begin(), buffer.begin() + received) });
+            pipe->queued_bytes += size_t(received);
+            pipe->cv.notify_all();
+            pipe->cv.wait(lock, [&] { return pipe->queued_bytes < pipe->max_queued || closing_.load(); });
+        }
+    }
+
+    void write_loop(Pipe* pipe) {
+        Clock::time_point next_send = Clock::now();
+        while (true) {
+            Chunk chunk;
+            {
+                std::unique_lock<std::mutex> lock(pipe->mutex);
+                while (!closing_.load()) {
+                    Clock::time_point wake = reset_at_;
+                    if (!pipe->queue.empty()) {
+                        wake = std::min(wake, pipe->queue.front().release);
+                    }
+                    if (Clock::now() >= reset_at_) {
+                        break;
+                    }
+                    if (!pipe->queue.empty() && Clock::now() >= pipe->queue.front().release) {
+                        break;
+                    }
+                    if (pipe->queue.empty() && pipe->eof) {
+                        break;
+                    }
+                    if (wake == Clock::time_point::max()) {
+                        pipe->cv.wait(lock);
+                    } else {
+                        pipe->cv.wait_until(lock, wake);
+                    }
+                }
+                if (closing_.load()) {
+                    return;
+                }
+                if (Clock::now() >= reset_at_) {
+                    lock.unlock();
+                    abort_all(true);
+                    return;
+                }
+                if (pipe->queue.empty()) {
+                    // Sender closed its side and everything was delivered: pass the FIN on
+                    shutdown(pipe->to, SHUT_WR);
+                    return;
+                }
+                chunk = std::move(pipe->queue.front());
+                pipe->queue.pop_front();
+                pipe->queued_bytes -= chunk.data.size();
+                pipe->cv.notify_all();
+            }
+
+            if (!send_paced(pipe, chunk.data, &next_send)) {
+                abort_all(false);
+                return;
+            }
+        }
+    }
+
+    // Send at no more than the link's rate, pausing for stalls
+    bool send_paced(Pipe* pipe, const std::vector<uint8_t>& data, Clock::time_point* next_send) {
+        int64_t rate = pipe->link.bytes_per_second;
+        // Slices of ~10 ms at the capped rate keep pacing smooth
+        size_t slice = rate > 0 ? size_t(std::max<int64_t>(rate / 100, 1)) : data.size();
+        size_t offset = 0;
+        while (offset < data.size()) {
+            wait_out_stall();
+            if (closing_.load()) {
+                return false;
+            }
+            if (rate > 0) {
+                Clock::time_point now = Clock::now();
+                if (*next_send > now) {
+                    std::this_thread::sleep_until(*next_send);
+                } else {
+                    // Idle time does not bank credit for a later burst
+                    *next_send = now;
+                }
+            }
+
+            size_t count = std::min(slice, data.size() - offset);
+            ssize_t sent = send(pipe->to, data.data() + offset, count, MSG_NOSIGNAL);
+            if (sent <= 0) {
+                return false;
+            }
+            offset += size_t(sent);
+            pipe->bytes += uint64_t(sent);
+            if (rate > 0) {
+                *next_send += std::chrono::microseconds(int64_t(sent) * 1000000 / rate);
+            }
+        }
+        return true;
+    }
+
+    // Both directions freeze together during a stall, as on a radio link
+    void wait_out_stall() {
+        Clock::time_point until;
+        {
+            std::lock_guard<std::mutex> lock(stall_mutex_);
+            Clock::time_point now = Clock::now();
+            if (now >= next_stall_) {
+                stall_end_ = next_stall_ + std::chrono::milliseconds(config_.stall_ms);
+                next_stall_ = stall_end_ + exponential_ms(config_.stall_every_ms);
+                if (now < stall_end_) {
+                    stalls_++;
+                }
+            }
+            until = stall_end_;
+        }
+        if (Clock::now() < until) {
+            std::this_thread::sleep_until(until);
+        }
+    }
+
+    int id_;
+    ProxyConfig config_;
+    int client_fd_;
+    int server_fd_;
+    Pipe up_;
+    Pipe down_;
+    std::atomic<bool> closing_{false};
+    std::atomic<bool> reset_{false};
+
+    std::mutex random_mutex_;
+    std::mt19937 random_;
+
+    std::mutex stall_mutex_;
+    Clock::time_point next_stall_;
+    Clock::time_point stall_end_;
+    int stalls_ = 0;
+    Clock::time_point reset_at_;
+};
+
+bool resolve(const std::string& address, addrinfo** result, bool passive) {
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+    std::string host = address.substr(0, colon);
+    std::string port = address.substr(colon + 1);
+    if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+        host = host.substr(1, host.size() - 2);
+    }
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    return getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, result) == 0;
+}
+
+void set_no_delay(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+// A small receive buffer on a capped direction keeps the sender's data queued
+// at the sender, where TCP flow control sees it, rather than in our kernel.
+// Must be set before connect() or listen() to size the TCP window.
+void limit_receive_buffer(int fd, const LinkSpec& link) {
+    if (link.bytes_per_second > 0) {
+        int size = int(queue_limit(link));
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    }
+}
+
+int connect_to(const std::string& address, const LinkSpec& link) {
+    addrinfo* addresses = nullptr;
+    if (!resolve(address, &addresses, false)) {
+        return -1;
+    }
+    int fd = -1;
+    for (addrinfo* entry = addresses; entry; entry = entry->ai_next) {
+        fd = socket(entry->ai_family, entry->ai_socktype, entry->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        limit_receive_buffer(fd, link);
+        if (connect(fd, entry->ai_addr, entry->ai_addrlen) == 0) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addresses);
+    if (fd >= 0) {
+        set_no_delay(fd);
+    }
+    return fd;
+}
+
+int listen_on(const std::string& address, const LinkSpec& link) {
+    addrinfo* addresses = nullptr;
+    if (!resolve(address, &addresses, true)) {
+        return -1;
+    }
+    int fd = -1;
+    for (addrinfo* entry = addresses; entry; entry = entry->ai_next) {
+        fd = socket(entry->ai_family, entry->ai_socktype, entry->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        limit_receive_buffer(fd, link);  // Inherited by accepted sockets
+        if (bind(fd, entry->ai_addr, entry->ai_addrlen) == 0 && listen(fd, 64) == 0) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addresses);
+    return fd;
+}
+
+void usage() {
+    std::fprintf(stderr,
+        "usage: godot_grpc_netproxy [options]\n"
+        "  --listen=HOST:PORT       Address to accept clients on (default 127.0.0.1:50052)\n"
+        "  --target=HOST:PORT       Server to forward to (default 127.0.0.1:50051)\n"
+        "  --profile=NAME           Preset: wifi, lte, 3g, flaky (later options override it)\n"
+        "  --latency-ms=N           One-way latency, both directions\n"
+        "  --jitter-ms=N            Extra random one-way delay in [0, N], both directions\n"
+        "  --up-kbps=N              Client-to-server bandwidth cap in kilobits/s (0 = none)\n"
+        "  --down-kbps=N            Server-to-client bandwidth cap in kilobits/s (0 = none)\n"
+        "  --stall-every-ms=N       Mean time between stalls (0 = never)\n"
+        "  --stall-ms=N             Length of each stall\n"
+        "  --reset-every-s=N        Mean connection lifetime before a reset (0 = never)\n"
+        "  --seed=N                 Seed for jitter, stalls and resets (default 1)\n");
+}
+
+bool parse_args(int argc, char** argv, ProxyConfig* config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        if (equals == std::string::npos) {
+            return false;
+        }
+        std::string key = arg.substr(0, equals);
+        std::string value = arg.substr(equals + 1);
+        long long number = std::atoll(value.c_str());
+        if (key == "--listen") {
+            config->listen = value;
+        } else if (key == "--target") {
+            config->target = value;
+        } else if (key == "--profile") {
+            if (!apply_profile(value, config)) {
+                std::fprintf(stderr, "unknown profile '%s'\n", value.c_str());
+                return false;
+            }
+        } else if (key == "--latency-ms") {
+            config->up.latency_ms = config->down.latency_ms = int(std::max(0LL, number));
+        } else if (key == "--jitter-ms") {
+            config->up.jitter_ms = config->down.jitter_ms = int(std::max(0LL, number));
+        } else if (key == "--up-kbps") {
+            config->up.bytes_per_second = kbps(std::max(0LL, number));
+        } else if (key == "--down-kbps") {
+            config->down.bytes_per_second = kbps(std::max(0LL, number));
+        } else if (key == "--stall-every-ms") {
+            config->stall_every_ms = int(std::max(0LL, number));
+        } else if (key == "--stall-ms") {
+            config->stall_ms = int(std::max(0LL, number));
+        } else if (key == "--reset-every-s") {
+            config->reset_every_s = std::max(0.0, std::atof(value.c_str()));
+        } else if (key == "--seed") {
+            config->seed = uint32_t(number);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string describe(const LinkSpec& link) {
+    char buffer[128];
+    if (link.bytes_per_second > 0) {
+        std::snprintf(buffer, sizeof(buffer), "%d+%d ms, %lld kbit/s", link.latency_ms, link.jitter_ms,
+            (long long)(link.bytes_per_second * 8 / 1000));
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%d+%d ms, unlimited", link.latency_ms, link.jitter_ms);
+    }
+    return buffer;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ProxyConfig config;
+    if (!parse_args(argc, argv, &config)) {
+        usage();
+        return 2;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int listen_fd = listen_on(config.listen, config.up);
+    if (listen_fd < 0) {
+        std::fprintf(stderr, "cannot listen on %s: %s\n", config.listen.c_str(), std::strerror(errno));
+        return 1;
+    }
+
+    std::printf("godot_grpc_netproxy: %s -> %s\n", config.listen.c_str(), config.target.c_str());
+    std::printf("  up    %s\n  down  %s\n", describe(config.up).c_str(), describe(config.down).c_str());
+    if (config.stall_every_ms > 0) {
+        std::printf("  stalls of %d ms every ~%d ms\n", config.stall_ms, config.stall_every_ms);
+    }
+    if (config.reset_every_s > 0.0) {
+        std::printf("  resets every ~%.1f s\n", config.reset_every_s);
+    }
+    std::fflush(stdout);
+
+    int next_id = 1;
+    while (true) {
+        int client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::fprintf(stderr, "accept failed: %s\n", std::strerror(errno));
+            return 1;
+        }
+        set_no_delay(client_fd);
+
+        int server_fd = connect_to(config.target, config.down);
+        if (server_fd < 0) {
+            std::fprintf(stderr, "cannot connect to %s\n", config.target.c_str());
+            close(client_fd);
+            continue;
+        }
+
+        int id = next_id++;
+        std::fprintf(stderr, "[%d] connected\n", id);
+        std::thread([id, client_fd, server_fd, config] {
+            Connection connection(id, client_fd, server_fd, config);
+            connection.run();
+        }).detach();
+    }
+}
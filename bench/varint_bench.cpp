@@ -0,0 +1,112 @@
+// Microbenchmark for the packed varint kernels in src/util/varint_decode.cpp.
+//
+// Build with -DGODOT_GRPC_BUILD_BENCHMARKS=ON and run:
+//   ./varint_bench [values_per_run] [iterations]
+//
+// Each distribution is decoded by every kernel the CPU supports; results are
+// checked against the scalar kernel before timing.
+
+#include "util/varint_decode.h"
+#include "util/wire_format.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace godot_grpc;
+
+namespace {
+
+struct Distribution {
+    const char* name;
+    int max_bits;       // Values are uniform in [0, 2^max_bits)
+    bool zigzag_signed; // Encode small signed values as sint64
+    bool random_length; // Shift by a random amount so lengths vary per value
+};
+
+std::vector<uint8_t> make_run(const Distribution& dist, size_t count, std::mt19937_64& rng) {
+    wire::Buffer buffer;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t value = rng();
+        if (dist.max_bits < 64) {
+            value &= (uint64_t(1) << dist.max_bits) - 1;
+        }
+        if (dist.random_length) {
+            value >>= rng() % dist.max_bits;
+        }
+        if (dist.zigzag_signed) {
+            value = wire::zigzag_encode(static_cast<int64_t>(value) - (int64_t(1) << (dist.max_bits - 1)));
+        }
+        buffer.put_varint(value);
+    }
+    return std::vector<uint8_t>(buffer.data(), buffer.data() + buffer.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    const Distribution distributions[] = {
+        { "1-byte (ids < 128)", 7, false, false },
+        { "2-byte (< 16384)", 14, false, false },
+        { "sint32 deltas", 20, true, false },
+        { "random length", 64, false, true },
+        { "full 64-bit", 64, false, false },
+    };
+    const wire::VarintKernel kernels[] = {
+        wire::VarintKernel::SCALAR,
+        wire::VarintKernel::SSE41,
+        wire::VarintKernel::AVX2,
+    };
+
+    std::printf("active kernel: %s, %zu values x %d iterations\n\n",
+                wire::varint_kernel_name(wire::active_varint_kernel()), count, iterations);
+    std::printf("%-22s %-8s %12s %12s %9s\n", "distribution", "kernel", "ns/value", "MB/s", "speedup");
+
+    std::mt19937_64 rng(42);
+    for (const auto& dist : distributions) {
+        std::vector<uint8_t> run = make_run(dist, count, rng);
+
+        size_t counted = 0;
+        if (!wire::count_varints(run.data(), run.size(), &counted) || counted != count) {
+            std::fprintf(stderr, "count_varints mismatch for %s\n", dist.name);
+            return 1;
+        }
+
+        std::vector<uint64_t> expected(count);
+        wire::decode_varints_with(wire::VarintKernel::SCALAR, run.data(), run.size(), expected.data(), count);
+
+        double scalar_ns = 0.0;
+        for (auto kernel : kernels) {
+            if (!wire::varint_kernel_supported(kernel)) {
+                continue;
+            }
+
+            std::vector<uint64_t> out(count);
+            if (!wire::decode_varints_with(kernel, run.data(), run.size(), out.data(), count) || out != expected) {
+                std::fprintf(stderr, "%s kernel produced wrong results for %s\n", wire::varint_kernel_name(kernel), dist.name);
+                return 1;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                wire::decode_varints_with(kernel, run.data(), run.size(), out.data(), count);
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            double total_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            double ns_per_value = total_ns / (static_cast<double>(count) * iterations);
+            double mb_per_s = (static_cast<double>(run.size()) * iterations) / (total_ns / 1e9) / 1e6;
+            if (kernel == wire::VarintKernel::SCALAR) {
+                scalar_ns = ns_per_value;
+            }
+            std::printf("%-22s %-8s %12.3f %12.1f %8.2fx\n", dist.name, wire::varint_kernel_name(kernel),
+                        ns_per_value, mb_per_s, scalar_ns / ns_per_value);
+        }
+    }
+    return 0;
+}
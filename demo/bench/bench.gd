@@ -0,0 +1,345 @@
+extends Node
+
+## godot_grpc end-to-end benchmarks
+##
+## Drives GrpcClient against the demo server's Bench service and writes the
+## results as JSON. Everything runs through the real extension, so the numbers
+## include call_deferred, Variant conversion and signal dispatch.
+##
+## Run headless from the repository root:
+##   cd demo_server && make run &
+##   godot --headless --path demo res://bench/bench.tscn -- --out=$PWD/bench.json
+##
+## Options (after "--"):
+##   --endpoint=dns:///localhost:50051
+##   --out=user://bench_results.json   Absolute paths and user:// both work
+##   --scenarios=unary,stream_rate,ping_pong,concurrent_streams
+##   --quick                           Smaller counts for smoke runs
+##
+## Bench service messages (see demo_server/bench.proto):
+##   EchoRequest  { bytes data = 1; int32 response_size = 2; }
+##   Payload      { bytes data = 1; }
+##   FloodRequest { int32 count = 1; int32 size = 2; }
+##   Ping         { int64 sequence = 1; int64 client_time_us = 2; bytes data = 3; }
+
+const SERVICE := "/bench.Bench/"
+const STREAM_SIZES := [64, 1024, 16384, 65536]
+const CONCURRENCY := [1, 10, 100, 1000]
+const WAIT_TIMEOUT_MS := 60000
+
+var client: GrpcClient
+var options := {
+	"endpoint": "dns:///localhost:50051",
+	"out": "user://bench_results.json",
+	"scenarios": "unary,stream_rate,ping_pong,concurrent_streams",
+	"quick": false,
+}
+var results := {}
+
+var _writer := GrpcProtoWriter.new()
+
+# Per-stream counters filled by the signal handlers
+var _stream_messages := {}
+var _stream_bytes := {}
+var _stream_done := {}
+
+
+func _ready() -> void:
+	_parse_args()
+	Engine.max_fps = 0  # Let the main loop spin so deferred calls are flushed as fast as possible
+
+	client = GrpcClient.new()
+	client.set_log_level(1)  # ERROR
+	client.message.connect(_on_message)
+	client.finished.connect(_on_finished)
+	client.error.connect(_on_error)
+
+	if not client.connect(options.endpoint, {"max_receive_message_length": 16 * 1024 * 1024}):
+		push_error("bench: cannot connect to %s" % options.endpoint)
+		get_tree().quit(1)
+		return
+
+	results = {
+		"endpoint": options.endpoint,
+		"godot_version": Engine.get_version_info().string,
+		"os": OS.get_name(),
+		"processor_count": OS.get_processor_count(),
+		"started_at": Time.get_datetime_string_from_system(true),
+		"quick": options.quick,
+		"scenarios": {},
+		"allocations": {},
+	}
+
+	var scenarios: PackedStringArray = options.scenarios.split(",", false)
+	client.reset_alloc_stats()
+	if "unary" in scenarios:
+		results.scenarios.unary = await _bench_unary()
+		_alloc_checkpoint("unary")
+	if "stream_rate" in scenarios:
+		results.scenarios.stream_rate = await _bench_stream_rate()
+		_alloc_checkpoint("stream_rate")
+	if "ping_pong" in scenarios:
+		results.scenarios.ping_pong = await _bench_ping_pong()
+		_alloc_checkpoint("ping_pong")
+	if "concurrent_streams" in scenarios:
+		results.scenarios.concurrent_streams = await _bench_concurrent_streams()
+		_alloc_checkpoint("concurrent_streams")
+
+	client.close()
+	_write_results()
+	get_tree().quit(0)
+
+
+# ============================================================================
+# SCENARIOS
+# ============================================================================
+
+## Sequential unary Echo calls with a small payload
+func _bench_unary() -> Dictionary:
+	var duration_ms := 2000 if options.quick else 10000
+	var request := _echo_request(64, 64)
+	var latencies: Array[int] = []
+	var failures := 0
+
+	# Warm up the channel and connection
+	for i in 50:
+		client.unary(SERVICE + "Echo", request)
+
+	var start := Time.get_ticks_usec()
+	var deadline := start + duration_ms * 1000
+	while Time.get_ticks_usec() < deadline:
+		var t0 := Time.get_ticks_usec()
+		var response := client.unary(SERVICE + "Echo", request)
+		latencies.append(Time.get_ticks_usec() - t0)
+		if response.is_empty():
+			failures += 1
+	var elapsed_s := (Time.get_ticks_usec() - start) / 1e6
+
+	var result := _latency_stats(latencies)
+	result.calls = latencies.size()
+	result.failures = failures
+	result.calls_per_second = latencies.size() / elapsed_s
+	print("unary: %.0f calls/s, p50 %d us, p99 %d us" % [result.calls_per_second, result.p50_us, result.p99_us])
+	return result
+
+
+## Server-stream message rate for several payload sizes
+func _bench_stream_rate() -> Array:
+	var runs := []
+	for size in STREAM_SIZES:
+		var budget := (8 if options.quick else 128) * 1024 * 1024
+		var count := clampi(budget / size, 100, 200000)
+
+		var start := Time.get_ticks_usec()
+		var stream_id := client.server_stream_start(SERVICE + "Flood", _flood_request(count, size))
+		if stream_id < 0:
+			runs.append({"size": size, "error": "failed to start stream"})
+			continue
+		_track(stream_id)
+		var timed_out := not await _wait_until(func(): return _stream_done.has(stream_id))
+		var elapsed_s := (Time.get_ticks_usec() - start) / 1e6
+
+		var received: int = _stream_messages[stream_id]
+		var run := {
+			"size": size,
+			"requested": count,
+			"received": received,
+			"messages_per_second": received / elapsed_s,
+			"megabytes_per_second": _stream_bytes[stream_id] / elapsed_s / 1e6,
+			"status_code": _stream_done.get(stream_id, -1),
+			"timed_out": timed_out,
+		}
+		runs.append(run)
+		_untrack(stream_id)
+		print("stream_rate: %6d B  %.0f msg/s  %.1f MB/s" % [size, run.messages_per_second, run.megabytes_per_second])
+	return runs
+
+
+## Bidi round trips, one ping in flight at a time
+func _bench_ping_pong() -> Dictionary:
+	var round_trips := 500 if options.quick else 5000
+	var warmup := 100
+
+	var stream_id := client.bidi_stream_start(SERVICE + "PingPong")
+	if stream_id < 0:
+		return {"error": "failed to start stream"}
+	_track(stream_id)
+
+	var latencies: Array[int] = []
+	for i in warmup + round_trips:
+		var t0 := Time.get_ticks_usec()
+		client.stream_send(stream_id, _ping(i + 1, t0))
+		var answered := func(): return _stream_messages[stream_id] > i or _stream_done.has(stream_id)
+		if not await _wait_until(answered) or _stream_messages[stream_id] <= i:
+			break
+		if i >= warmup:
+			latencies.append(Time.get_ticks_usec() - t0)
+
+	client.stream_close_send(stream_id)
+	await _wait_until(func(): return _stream_done.has(stream_id))
+	_untrack(stream_id)
+
+	var result := _latency_stats(latencies)
+	result.round_trips = latencies.size()
+	print("ping_pong: p50 %d us, p99 %d us over %d round trips" % [result.p50_us, result.p99_us, latencies.size()])
+	return result
+
+
+## Many small server streams at once
+func _bench_concurrent_streams() -> Array:
+	var total_messages := 20000 if options.quick else 200000
+	var runs := []
+	for streams in CONCURRENCY:
+		var per_stream := maxi(total_messages / streams, 10)
+		var request := _flood_request(per_stream, 256)
+
+		var start := Time.get_ticks_usec()
+		var ids: Array[int] = []
+		for i in streams:
+			var stream_id := client.server_stream_start(SERVICE + "Flood", request)
+			if stream_id >= 0:
+				ids.append(stream_id)
+				_track(stream_id)
+		var open_us := Time.get_ticks_usec() - start
+
+		var timed_out := not await _wait_until(func():
+			for id in ids:
+				if not _stream_done.has(id):
+					return false
+			return true)
+		var elapsed_s := (Time.get_ticks_usec() - start) / 1e6
+
+		var received := 0
+		var failed := streams - ids.size()
+		for id in ids:
+			received += _stream_messages[id]
+			if _stream_done.get(id, -1) != 0:
+				failed += 1
+			_untrack(id)
+
+		var run := {
+			"streams": streams,
+			"messages_per_stream": per_stream,
+			"received": received,
+			"failed_streams": failed,
+			"open_ms": open_us / 1000.0,
+			"elapsed_ms": elapsed_s * 1000.0,
+			"messages_per_second": received / elapsed_s,
+			"timed_out": timed_out,
+		}
+		runs.append(run)
+		print("concurrent_streams: %4d streams  %.0f msg/s  open %.1f ms  failed %d" % [streams, run.messages_per_second, run.open_ms, failed])
+	return runs
+
+
+# ============================================================================
+# SIGNALS AND HELPERS
+# ============================================================================
+
+func _on_message(stream_id: int, data: PackedByteArray) -> void:
+	if not _stream_messages.has(stream_id):
+		return
+	_stream_messages[stream_id] += 1
+	_stream_bytes[stream_id] += data.size()
+
+
+func _on_finished(stream_id: int, status_code: int, _message: String) -> void:
+	if _stream_messages.has(stream_id):
+		_stream_done[stream_id] = status_code
+
+
+func _on_error(stream_id: int, status_code: int, _message: String) -> void:
+	if _stream_messages.has(stream_id):
+		_stream_done[stream_id] = status_code
+
+
+func _track(stream_id: int) -> void:
+	_stream_messages[stream_id] = 0
+	_stream_bytes[stream_id] = 0
+
+
+func _untrack(stream_id: int) -> void:
+	_stream_messages.erase(stream_id)
+	_stream_bytes.erase(stream_id)
+	_stream_done.erase(stream_id)
+
+
+## Yield frames until `condition` holds; false on timeout
+func _wait_until(condition: Callable) -> bool:
+	var deadline := Time.get_ticks_msec() + WAIT_TIMEOUT_MS
+	while not condition.call():
+		if Time.get_ticks_msec() > deadline:
+			return false
+		await get_tree().process_frame
+	return true
+
+
+## Store the allocation counts of the scenario that just ran (only in builds
+## with -DGODOT_GRPC_ALLOC_STATS=ON) and start counting afresh
+func _alloc_checkpoint(scenario: String) -> void:
+	var stats := client.get_alloc_stats()
+	if not stats.is_empty():
+		results.allocations[scenario] = stats
+	client.reset_alloc_stats()
+
+
+func _latency_stats(samples: Array[int]) -> Dictionary:
+	if samples.is_empty():
+		return {"samples": 0, "mean_us": 0, "p50_us": 0, "p90_us": 0, "p99_us": 0, "max_us": 0}
+	var sorted := samples.duplicate()
+	sorted.sort()
+	var total := 0
+	for sample in sorted:
+		total += sample
+	return {
+		"samples": sorted.size(),
+		"mean_us": total / float(sorted.size()),
+		"p50_us": sorted[int(sorted.size() * 0.50)],
+		"p90_us": sorted[int(sorted.size() * 0.90)],
+		"p99_us": sorted[mini(int(sorted.size() * 0.99), sorted.size() - 1)],
+		"max_us": sorted[-1],
+	}
+
+
+func _echo_request(size: int, response_size: int) -> PackedByteArray:
+	var data := PackedByteArray()
+	data.resize(size)
+	_writer.clear()
+	_writer.write_bytes(1, data)
+	_writer.write_varint(2, response_size)
+	return _writer.get_bytes()
+
+
+func _flood_request(count: int, size: int) -> PackedByteArray:
+	_writer.clear()
+	_writer.write_varint(1, count)
+	_writer.write_varint(2, size)
+	return _writer.get_bytes()
+
+
+func _ping(sequence: int, client_time_us: int) -> PackedByteArray:
+	_writer.clear()
+	_writer.write_varint(1, sequence)
+	_writer.write_varint(2, client_time_us)
+	return _writer.get_bytes()
+
+
+func _parse_args() -> void:
+	for arg in OS.get_cmdline_user_args():
+		if arg == "--quick":
+			options.quick = true
+		elif arg.begins_with("--") and "=" in arg:
+			var key := arg.substr(2, arg.find("=") - 2)
+			if options.has(key):
+				options[key] = arg.substr(arg.find("=") + 1)
+
+
+func _write_results() -> void:
+	results.finished_at = Time.get_datetime_string_from_system(true)
+	var file := FileAccess.open(options.out, FileAccess.WRITE)
+	if file == null:
+		push_error("bench: cannot write %s" % options.out)
+		return
+	file.store_string(JSON.stringify(results, "  "))
+	file.close()
+	print("Results written to %s" % ProjectSettings.globalize_path(options.out))
@@ -64,7 +64,7 @@ func demo_unary_call() -> void:
 
 	# In a real application, you would use a proper Protobuf library
 	# like godobuf (https://github.com/oniksan/godobuf) to serialize messages.
-	# For this demo, we'll create a simple manual serialization.
+	# For this demo, we encode fields by hand with GrpcProtoWriter.
 
 	var request_bytes := _create_hello_request("Godot Player")
 
@@ -154,49 +154,40 @@ func _exit_tree() -> void:
 		print("gRPC client closed")
 
 # ============================================================================
-# PROTOBUF HELPERS (Simplified for demo purposes)
-# In a real application, use a proper Protobuf library like godobuf
+# PROTOBUF HELPERS
+# Uses the extension's native GrpcProtoWriter/GrpcProtoReader for the wire
+# format. For larger schemas, use a proper Protobuf library like godobuf.
 # ============================================================================
 
+var _writer := GrpcProtoWriter.new()
+var _reader := GrpcProtoReader.new()
+
 ## Create a HelloRequest protobuf message
 ## Message format: field 1 (string name)
 func _create_hello_request(name: String) -> PackedByteArray:
-	var buffer := PackedByteArray()
-	# Field 1: string name
-	# Tag: (field_number << 3) | wire_type = (1 << 3) | 2 = 0x0a
-	buffer.append(0x0a)
-	buffer.append(name.length())
-	buffer.append_array(name.to_utf8_buffer())
-	return buffer
+	_writer.clear()
+	_writer.write_string(1, name)
+	return _writer.get_bytes()
 
 ## Parse a HelloReply protobuf message
 ## Message format: field 1 (string message)
 func _parse_hello_reply(data: PackedByteArray) -> String:
-	if data.size() < 2:
-		return ""
-	# Skip tag byte
-	var length := data[1]
-	if data.size() < 2 + length:
-		return ""
-	var message_bytes := data.slice(2, 2 + length)
-	return message_bytes.get_string_from_utf8()
+	var message := ""
+	_reader.set_bytes(data)
+	while _reader.next_field():
+		if _reader.get_field_number() == 1:
+			message = _reader.read_string()
+		else:
+			_reader.skip()
+	return message
 
 ## Create a MetricsRequest protobuf message
 ## Message format: field 1 (int32 interval_ms), field 2 (int32 count)
 func _create_metrics_request(interval_ms: int, count: int) -> PackedByteArray:
-	var buffer := PackedByteArray()
-
-	# Field 1: int32 interval_ms
-	# Tag: (1 << 3) | 0 = 0x08
-	buffer.append(0x08)
-	buffer.append_array(_encode_varint(interval_ms))
-
-	# Field 2: int32 count
-	# Tag: (2 << 3) | 0 = 0x10
-	buffer.append(0x10)
-	buffer.append_array(_encode_varint(count))
-
-	return buffer
+	_writer.clear()
+	_writer.write_varint(1, interval_ms)
+	_writer.write_varint(2, count)
+	return _writer.get_bytes()
 
 ## Parse a MetricData protobuf message
 ## Message format: field 1 (string name), field 2 (double value), field 3 (int64 timestamp)
@@ -207,57 +198,16 @@ func _parse_metric_data(data: PackedByteArray) -> Dictionary:
 		"timestamp": 0
 	}
 
-	var pos := 0
-	while pos < data.size():
-		if pos + 1 >= data.size():
-			break
-
-		var tag := data[pos]
-		var field_number := tag >> 3
-		var wire_type := tag & 0x07
-		pos += 1
-
-		if field_number == 1 and wire_type == 2:  # string name
-			var length := data[pos]
-			pos += 1
-			if pos + length <= data.size():
-				result.name = data.slice(pos, pos + length).get_string_from_utf8()
-				pos += length
-		elif field_number == 2 and wire_type == 1:  # double value
-			if pos + 8 <= data.size():
-				result.value = data.decode_double(pos)
-				pos += 8
-		elif field_number == 3 and wire_type == 0:  # int64 timestamp
-			var value_result := _decode_varint(data, pos)
-			result.timestamp = value_result.value
-			pos = value_result.next_pos
-		else:
-			# Unknown field, skip
-			break
+	_reader.set_bytes(data)
+	while _reader.next_field():
+		match _reader.get_field_number():
+			1:
+				result.name = _reader.read_string()
+			2:
+				result.value = _reader.read_double()
+			3:
+				result.timestamp = _reader.read_varint()
+			_:
+				_reader.skip()
 
 	return result
-
-## Encode an integer as a protobuf varint
-func _encode_varint(value: int) -> PackedByteArray:
-	var buffer := PackedByteArray()
-	while value > 127:
-		buffer.append((value & 0x7F) | 0x80)
-		value >>= 7
-	buffer.append(value & 0x7F)
-	return buffer
-
-## Decode a protobuf varint
-func _decode_varint(data: PackedByteArray, start_pos: int) -> Dictionary:
-	var value := 0
-	var shift := 0
-	var pos := start_pos
-
-	while pos < data.size():
-		var byte := data[pos]
-		value |= (byte & 0x7F) << shift
-		pos += 1
-		if (byte & 0x80) == 0:
-			break
-		shift += 7
-
-	return {"value": value, "next_pos": pos}
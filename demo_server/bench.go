@@ -0,0 +1,306 @@
+package main
+
+import (
+	"context"
+	"errors"
+	"io"
+	"log"
+	"math/bits"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// Bench service implementation
+//
+// Handlers avoid per-message logging and allocation so the server is never
+// the bottleneck of a client benchmark. Every method updates a methodCounters
+// entry; GetStats reports them and logBenchStats prints a summary while
+// there is traffic.
+type benchServer struct {
+	UnimplementedBenchServer
+
+	stats *benchStats
+}
+
+func newBenchServer() *benchServer {
+	return &benchServer{stats: newBenchStats()}
+}
+
+func (s *benchServer) Echo(ctx context.Context, req *EchoRequest) (*Payload, error) {
+	start := time.Now()
+	c := s.stats.method("Echo")
+	c.calls.Add(1)
+	c.messagesIn.Add(1)
+	c.bytesIn.Add(int64(len(req.GetData())))
+
+	reply := &Payload{Data: req.GetData()}
+	if size := int(req.GetResponseSize()); size > 0 {
+		reply.Data = make([]byte, size)
+	}
+
+	c.messagesOut.Add(1)
+	c.bytesOut.Add(int64(len(reply.Data)))
+	c.latency.record(time.Since(start))
+	return reply, nil
+}
+
+func (s *benchServer) Flood(req *FloodRequest, stream Bench_FloodServer) error {
+	c := s.stats.method("Flood")
+	c.calls.Add(1)
+	c.messagesIn.Add(1)
+
+	count := int(req.GetCount())
+	if count == 0 {
+		count = 1000
+	}
+	// Send serializes synchronously, so one payload can be reused for the whole stream
+	payload := &Payload{Data: make([]byte, max(int(req.GetSize()), 0))}
+
+	for i := 0; i < count; i++ {
+		// Send blocks while the client's flow-control window is full, so this
+		// loop runs exactly as fast as the client reads.
+		if err := stream.Send(payload); err != nil {
+			c.errors.Add(1)
+			return err
+		}
+		c.messagesOut.Add(1)
+		c.bytesOut.Add(int64(len(payload.Data)))
+	}
+	return nil
+}
+
+func (s *benchServer) Sink(stream Bench_SinkServer) error {
+	c := s.stats.method("Sink")
+	c.calls.Add(1)
+
+	var messages, total int64
+	var first time.Time
+	for {
+		payload, err := stream.Recv()
+		if errors.Is(err, io.EOF) {
+			break
+		}
+		if err != nil {
+			c.errors.Add(1)
+			return err
+		}
+		if messages == 0 {
+			first = time.Now()
+		}
+		messages++
+		total += int64(len(payload.GetData()))
+		c.messagesIn.Add(1)
+		c.bytesIn.Add(int64(len(payload.GetData())))
+	}
+
+	summary := &SinkSummary{Messages: messages, Bytes: total}
+	if messages > 0 {
+		summary.ElapsedUs = time.Since(first).Microseconds()
+	}
+	c.messagesOut.Add(1)
+	return stream.SendAndClose(summary)
+}
+
+func (s *benchServer) PingPong(stream Bench_PingPongServer) error {
+	c := s.stats.method("PingPong")
+	c.calls.Add(1)
+
+	for {
+		ping, err := stream.Recv()
+		if errors.Is(err, io.EOF) {
+			return nil
+		}
+		if err != nil {
+			c.errors.Add(1)
+			return err
+		}
+		received := time.Now()
+		c.messagesIn.Add(1)
+		c.bytesIn.Add(int64(len(ping.GetData())))
+
+		ping.ServerTimeUs = received.UnixMicro()
+		if err := stream.Send(ping); err != nil {
+			c.errors.Add(1)
+			return err
+		}
+		c.messagesOut.Add(1)
+		c.bytesOut.Add(int64(len(ping.GetData())))
+		c.latency.record(time.Since(received))
+	}
+}
+
+func (s *benchServer) GetStats(ctx context.Context, req *StatsRequest) (*BenchStats, error) {
+	return s.stats.snapshot(req.GetReset()), nil
+}
+
+// ============================================================================
+// COUNTERS
+// ============================================================================
+
+// Latency histogram with 4 sub-buckets per power of two (~25% resolution),
+// lock-free so concurrent handlers never contend on it.
+const latencyBuckets = 8 + 61*4
+
+type latencyHistogram struct {
+	buckets [latencyBuckets]atomic.Int64
+	max     atomic.Int64
+}
+
+func latencyBucket(us int64) int {
+	if us < 8 {
+		return int(max(us, 0))
+	}
+	exp := bits.Len64(uint64(us)) - 1 // >= 3
+	sub := int(us>>(exp-2)) & 3
+	return 8 + (exp-3)*4 + sub
+}
+
+// Largest value that falls into bucket i
+func latencyBucketLimit(i int) int64 {
+	if i < 8 {
+		return int64(i)
+	}
+	exp := (i-8)/4 + 3
+	sub := int64((i - 8) % 4)
+	return ((4+sub+1)<<(exp-2) - 1)
+}
+
+func (h *latencyHistogram) record(d time.Duration) {
+	us := d.Microseconds()
+	h.buckets[latencyBucket(us)].Add(1)
+	for {
+		current := h.max.Load()
+		if us <= current || h.max.CompareAndSwap(current, us) {
+			return
+		}
+	}
+}
+
+// Returns the sample count and the p50/p99 bucket limits
+func (h *latencyHistogram) percentiles() (samples, p50, p99 int64) {
+	var counts [latencyBuckets]int64
+	for i := range h.buckets {
+		counts[i] = h.buckets[i].Load()
+		samples += counts[i]
+	}
+	if samples == 0 {
+		return 0, 0, 0
+	}
+	var seen int64
+	p50 = -1
+	for i, n := range counts {
+		seen += n
+		if p50 < 0 && seen*2 >= samples {
+			p50 = latencyBucketLimit(i)
+		}
+		if seen*100 >= samples*99 {
+			p99 = latencyBucketLimit(i)
+			break
+		}
+	}
+	return samples, p50, min(p99, h.max.Load())
+}
+
+func (h *latencyHistogram) reset() {
+	for i := range h.buckets {
+		h.buckets[i].Store(0)
+	}
+	h.max.Store(0)
+}
+
+type methodCounters struct {
+	calls       atomic.Int64
+	errors      atomic.Int64
+	messagesIn  atomic.Int64
+	messagesOut atomic.Int64
+	bytesIn     atomic.Int64
+	bytesOut    atomic.Int64
+	latency     latencyHistogram
+}
+
+type benchStats struct {
+	methods map[string]*methodCounters // Fixed at construction, read without locking
+
+	mu    sync.Mutex
+	since time.Time
+}
+
+var benchMethods = []string{"Echo", "Flood", "Sink", "PingPong"}
+
+func newBenchStats() *benchStats {
+	s := &benchStats{methods: make(map[string]*methodCounters), since: time.Now()}
+	for _, name := range benchMethods {
+		s.methods[name] = &methodCounters{}
+	}
+	return s
+}
+
+func (s *benchStats) method(name string) *methodCounters {
+	return s.methods[name]
+}
+
+func (s *benchStats) snapshot(reset bool) *BenchStats {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	out := &BenchStats{UptimeMs: time.Since(s.since).Milliseconds()}
+	for _, name := range benchMethods {
+		c := s.methods[name]
+		samples, p50, p99 := c.latency.percentiles()
+		out.Methods = append(out.Methods, &MethodStats{
+			Method:         name,
+			Calls:          c.calls.Load(),
+			Errors:         c.errors.Load(),
+			MessagesIn:     c.messagesIn.Load(),
+			MessagesOut:    c.messagesOut.Load(),
+			BytesIn:        c.bytesIn.Load(),
+			BytesOut:       c.bytesOut.Load(),
+			LatencySamples: samples,
+			LatencyP50Us:   p50,
+			LatencyP99Us:   p99,
+			LatencyMaxUs:   c.latency.max.Load(),
+		})
+		if reset {
+			c.calls.Store(0)
+			c.errors.Store(0)
+			c.messagesIn.Store(0)
+			c.messagesOut.Store(0)
+			c.bytesIn.Store(0)
+			c.bytesOut.Store(0)
+			c.latency.reset()
+		}
+	}
+	if reset {
+		s.since = time.Now()
+	}
+	return out
+}
+
+// Logs per-method throughput every interval, skipping idle intervals
+func logBenchStats(s *benchStats, interval time.Duration) {
+	type totals struct{ messagesIn, messagesOut, bytesOut int64 }
+	last := make(map[string]totals)
+
+	for range time.Tick(interval) {
+		seconds := interval.Seconds()
+		for _, name := range benchMethods {
+			c := s.methods[name]
+			now := totals{c.messagesIn.Load(), c.messagesOut.Load(), c.bytesOut.Load()}
+			prev := last[name]
+			last[name] = now
+			// Counters go backwards after a GetStats reset; treat that interval as a restart
+			if now.messagesIn < prev.messagesIn || now.messagesOut < prev.messagesOut {
+				prev = totals{}
+			}
+			if now == prev {
+				continue
+			}
+			log.Printf("bench %-8s in %9.0f msg/s  out %9.0f msg/s  %8.2f MB/s out",
+				name,
+				float64(now.messagesIn-prev.messagesIn)/seconds,
+				float64(now.messagesOut-prev.messagesOut)/seconds,
+				float64(now.bytesOut-prev.bytesOut)/seconds/1e6)
+		}
+	}
+}
@@ -14,6 +14,9 @@ import (
 
 const (
 	port = ":50051"
+
+	// How often the Bench service logs throughput while it has traffic
+	benchStatsInterval = 5 * time.Second
 )
 
 // HelloWorld service implementation
@@ -89,6 +92,9 @@ func main() {
 	// Register services
 	RegisterGreeterServer(s, &greeterServer{})
 	RegisterMonitorServer(s, &monitorServer{})
+	bench := newBenchServer()
+	RegisterBenchServer(s, bench)
+	go logBenchStats(bench.stats, benchStatsInterval)
 
 	// Register reflection service on gRPC server.
 	reflection.Register(s)
@@ -97,6 +103,7 @@ func main() {
 	log.Println("Available services:")
 	log.Println("  - helloworld.Greeter/SayHello (unary)")
 	log.Println("  - metrics.Monitor/StreamMetrics (server-streaming)")
+	log.Println("  - bench.Bench/Echo, Flood, Sink, PingPong, GetStats (benchmarks)")
 
 	if err := s.Serve(lis); err != nil {
 		log.Fatalf("Failed to serve: %v", err)
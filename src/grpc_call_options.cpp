@@ -0,0 +1,177 @@
+#include "grpc_call_options.h"
+#include "util/status_map.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <chrono>
+
+namespace godot_grpc {
+
+namespace {
+
+bool parse_compression(const godot::String& name, bool* has_compression, grpc_compression_algorithm* algorithm) {
+    if (name.is_empty()) {
+        *has_compression = false;
+        *algorithm = GRPC_COMPRESS_NONE;
+        return true;
+    }
+    *has_compression = true;
+    if (name == "none" || name == "identity") {
+        *algorithm = GRPC_COMPRESS_NONE;
+    } else if (name == "deflate") {
+        *algorithm = GRPC_COMPRESS_DEFLATE;
+    } else if (name == "gzip") {
+        *algorithm = GRPC_COMPRESS_GZIP;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+traffic::Metadata metadata_pairs(const godot::Dictionary& metadata) {
+    traffic::Metadata pairs;
+    godot::Array keys = metadata.keys();
+    pairs.reserve(static_cast<size_t>(keys.size()));
+    for (int i = 0; i < keys.size(); ++i) {
+        godot::String key = keys[i];
+        godot::String value = metadata[key];
+        // gRPC rejects calls with uppercase metadata keys
+        pairs.emplace_back(key.to_lower().utf8().get_data(), value.utf8().get_data());
+    }
+    return pairs;
+}
+
+// `metadata` with keys lowercased, as they are sent
+godot::Dictionary lowercase_keys(const godot::Dictionary& metadata) {
+    godot::Dictionary result;
+    godot::Array keys = metadata.keys();
+    for (int i = 0; i < keys.size(); ++i) {
+        godot::String key = keys[i];
+        result[key.to_lower()] = metadata[key];
+    }
+    return result;
+}
+
+// Add `pairs` to `metadata`, replacing the pairs of any key they supply, as
+// AddMetadata() would otherwise send both
+void override_metadata(traffic::Metadata* metadata, const traffic::Metadata& pairs) {
+    auto supplied = [&pairs](const std::pair<std::string, std::string>& pair) {
+        for (const auto& added : pairs) {
+            if (added.first == pair.first) {
+                return true;
+            }
+        }
+        return false;
+    };
+    metadata->erase(std::remove_if(metadata->begin(), metadata->end(), supplied), metadata->end());
+    metadata->insert(metadata->end(), pairs.begin(), pairs.end());
+}
+
+} // namespace
+
+void CallOptions::apply(grpc::ClientContext& context) const {
+    if (deadline_ms >= 0) {
+        context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(deadline_ms));
+    }
+    for (const auto& pair : metadata) {
+        context.AddMetadata(pair.first, pair.second);
+    }
+    if (has_compression) {
+        context.set_compression_algorithm(compression);
+    }
+}
+
+bool CallOptions::parse(const godot::Dictionary& call_opts, CallOptions* out, std::string* error) {
+    if (call_opts.has("call_options")) {
+        godot::Ref<GrpcCallOptions> base = call_opts["call_options"];
+        if (base.is_null()) {
+            *error = "call_options must be a GrpcCallOptions";
+            return false;
+        }
+        *out = base->native();
+    }
+
+    if (call_opts.has("deadline_ms")) {
+        out->deadline_ms = call_opts["deadline_ms"];
+    }
+
+    if (call_opts.has("metadata")) {
+        override_metadata(&out->metadata, metadata_pairs(call_opts["metadata"]));
+    }
+
+    if (call_opts.has("compression")) {
+        godot::String name = call_opts["compression"];
+        if (!parse_compression(name, &out->has_compression, &out->compression)) {
+            *error = "unknown compression \"" + std::string(name.utf8().get_data()) + "\"";
+            return false;
+        }
+    }
+    return true;
+}
+
+void GrpcCallOptions::_bind_methods() {
+    godot::ClassDB::bind_static_method("GrpcCallOptions", godot::D_METHOD("from_dictionary", "call_opts"), &GrpcCallOptions::from_dictionary);
+
+    godot::ClassDB::bind_method(godot::D_METHOD("set_deadline_ms", "deadline_ms"), &GrpcCallOptions::set_deadline_ms);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_deadline_ms"), &GrpcCallOptions::get_deadline_ms);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_metadata", "metadata"), &GrpcCallOptions::set_metadata);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_metadata"), &GrpcCallOptions::get_metadata);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_compression", "compression"), &GrpcCallOptions::set_compression);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_compression"), &GrpcCallOptions::get_compression);
+
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "deadline_ms"), "set_deadline_ms", "get_deadline_ms");
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::DICTIONARY, "metadata"), "set_metadata", "get_metadata");
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::STRING, "compression", godot::PROPERTY_HINT_ENUM_SUGGESTION, "none,deflate,gzip"), "set_compression", "get_compression");
+}
+
+godot::Ref<GrpcCallOptions> GrpcCallOptions::from_dictionary(const godot::Dictionary& call_opts) {
+    godot::Ref<GrpcCallOptions> result;
+    result.instantiate();
+    std::string error;
+    if (!CallOptions::parse(call_opts, &result->options_, &error)) {
+        Logger::error("GrpcCallOptions: " + error);
+        return godot::Ref<GrpcCallOptions>();
+    }
+    godot::Ref<GrpcCallOptions> base = call_opts.get("call_options", godot::Variant());
+    if (base.is_valid()) {
+        result->metadata_ = base->metadata_.duplicate();
+        result->compression_ = base->compression_;
+    }
+    if (call_opts.has("metadata")) {
+        result->metadata_.merge(lowercase_keys(call_opts["metadata"]), true);
+    }
+    if (call_opts.has("compression")) {
+        result->compression_ = call_opts["compression"];
+    }
+    return result;
+}
+
+void GrpcCallOptions::set_deadline_ms(int deadline_ms) {
+    options_.deadline_ms = deadline_ms;
+}
+
+int GrpcCallOptions::get_deadline_ms() const {
+    return options_.deadline_ms;
+}
+
+void GrpcCallOptions::set_metadata(const godot::Dictionary& metadata) {
+    metadata_ = lowercase_keys(metadata);
+    options_.metadata = metadata_pairs(metadata_);
+}
+
+godot::Dictionary GrpcCallOptions::get_metadata() const {
+    return metadata_.duplicate();
+}
+
+void GrpcCallOptions::set_compression(const godot::String& compression) {
+    if (!parse_compression(compression, &options_.has_compression, &options_.compression)) {
+        Logger::error("GrpcCallOptions: unknown compression \"" + std::string(compression.utf8().get_data()) + "\"");
+        return;
+    }
+    compression_ = compression;
+}
+
+godot::String GrpcCallOptions::get_compression() const {
+    return compression_;
+}
+
+} // namespace godot_grpc
@@ -0,0 +1,80 @@
+#ifndef GODOT_GRPC_CALL_OPTIONS_H
+#define GODOT_GRPC_CALL_OPTIONS_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "util/traffic_log.h"
+#include <grpc/compression.h>
+#include <grpcpp/client_context.h>
+
+namespace godot_grpc {
+
+/**
+ * The per-call settings create_context() applies, in native form.
+ */
+struct CallOptions {
+    int deadline_ms = -1;  // -1 = no deadline
+    traffic::Metadata metadata;  // UTF-8 pairs, keys lowercased
+    bool has_compression = false;
+    grpc_compression_algorithm compression = GRPC_COMPRESS_NONE;
+
+    void apply(grpc::ClientContext& context) const;
+
+    /**
+     * Parse the context keys of a call_opts Dictionary (deadline_ms,
+     * metadata, compression, and call_options as a base). Other keys are
+     * left for the caller. Returns false with `error` set on a bad value.
+     */
+    static bool parse(const godot::Dictionary& call_opts, CallOptions* out, std::string* error);
+};
+
+/**
+ * GrpcCallOptions: Call options parsed once and reused.
+ *
+ * Passed as call_opts instead of a Dictionary, the deadline, metadata and
+ * compression are applied straight from their native form, so a call made
+ * every frame with the same options does no Dictionary lookups or String
+ * conversions for them. Stream decoding options (columnar, delta,
+ * snapshot_buffer) still go in a Dictionary, which can carry a
+ * GrpcCallOptions under "call_options".
+ */
+class GrpcCallOptions : public godot::RefCounted {
+    GDCLASS(GrpcCallOptions, godot::RefCounted)
+
+public:
+    GrpcCallOptions() = default;
+    ~GrpcCallOptions() = default;
+
+    /**
+     * Build from a call_opts Dictionary. Returns null (and logs why) if a
+     * value is invalid.
+     */
+    static godot::Ref<GrpcCallOptions> from_dictionary(const godot::Dictionary& call_opts);
+
+    void set_deadline_ms(int deadline_ms);
+    int get_deadline_ms() const;
+
+    // Keys and values are converted here, once
+    void set_metadata(const godot::Dictionary& metadata);
+    godot::Dictionary get_metadata() const;
+
+    // "gzip", "deflate", or "none" / "" for the channel default
+    void set_compression(const godot::String& compression);
+    godot::String get_compression() const;
+
+    // Native API
+    const CallOptions& native() const { return options_; }
+
+protected:
+    static void _bind_methods();
+
+private:
+    CallOptions options_;
+    godot::Dictionary metadata_;
+    godot::String compression_;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_CALL_OPTIONS_H
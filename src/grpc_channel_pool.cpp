@@ -1,11 +1,16 @@
 #include "grpc_channel_pool.h"
+#include "util/runtime_init.h"
 #include "util/status_map.h"
+#include "util/tls_config.h"
 
 namespace godot_grpc {
 
 bool GrpcChannelPool::create_channel(const std::string& endpoint, const ChannelOptions& options) {
     Logger::info("Creating gRPC channel to " + endpoint);
 
+    // Waits for GrpcRuntime.initialize_async() if it is still running
+    runtime::ensure_initialized();
+
     // Build channel arguments
     grpc::ChannelArguments args;
 
@@ -32,12 +37,29 @@ bool GrpcChannelPool::create_channel(const std::string& endpoint, const ChannelO
         args.SetMaxReceiveMessageSize(options.max_receive_message_length);
     }
 
+    if (options.local_subchannel_pool) {
+        args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    }
+
     // Create channel credentials
     std::shared_ptr<grpc::ChannelCredentials> creds;
-    if (options.enable_tls) {
-        grpc::SslCredentialsOptions ssl_opts;
-        creds = grpc::SslCredentials(ssl_opts);
-        Logger::info("Using TLS credentials");
+    tls::Config tls_config;
+    tls_config.root_certs_pem = options.root_certs_pem;
+    tls_config.client_cert_pem = options.client_cert_pem;
+    tls_config.client_key_pem = options.client_key_pem;
+    tls_config.session_resumption = options.tls_session_resumption;
+    bool custom_tls = !tls_config.root_certs_pem.empty() || !tls_config.client_cert_pem.empty() ||
+                      !tls_config.client_key_pem.empty();
+    if (options.enable_tls || custom_tls) {
+        std::string error;
+        if (!tls::validate(tls_config, &error)) {
+            Logger::error("Invalid TLS options: " + error);
+            return false;
+        }
+        creds = tls::credentials(tls_config, &args);
+        Logger::info(std::string("Using TLS credentials") +
+            (tls_config.root_certs_pem.empty() ? "" : ", custom roots") +
+            (tls_config.client_cert_pem.empty() ? "" : ", client certificate"));
     } else {
         creds = grpc::InsecureChannelCredentials();
         Logger::debug("Using insecure credentials");
@@ -19,9 +19,19 @@ struct ChannelOptions {
     std::string authority;
     std::multimap<std::string, std::string> metadata;
 
+    // TLS material (PEM); setting any of these implies enable_tls
+    std::string root_certs_pem;  // Trusted roots instead of the system store
+    std::string client_cert_pem; // Client certificate chain for mutual TLS
+    std::string client_key_pem;  // Its private key
+    bool tls_session_resumption = true;
+
     // Additional channel arguments
     int max_send_message_length = -1; // -1 = unlimited
     int max_receive_message_length = -1; // -1 = unlimited
+
+    // Give this channel its own subchannels (and so its own connection)
+    // instead of sharing them with other channels to the same target
+    bool local_subchannel_pool = false;
 };
 
 /**
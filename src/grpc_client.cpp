@@ -1,6 +1,12 @@
 #include "grpc_client.h"
+#include "grpc_columnar.h"
+#include "grpc_delta.h"
+#include "grpc_reflection.h"
 #include "util/status_map.h"
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <grpcpp/support/byte_buffer.h>
 #include <grpcpp/support/slice.h>
@@ -9,69 +15,226 @@
 
 namespace godot_grpc {
 
-GrpcClient::GrpcClient()
-    : next_stream_id_(1)
-{
+namespace {
+
+traffic::CallType traffic_call_type(StreamType stream_type) {
+    switch (stream_type) {
+        case StreamType::SERVER_STREAMING: return traffic::SERVER_STREAMING;
+        case StreamType::CLIENT_STREAMING: return traffic::CLIENT_STREAMING;
+        case StreamType::BIDIRECTIONAL: return traffic::BIDIRECTIONAL;
+    }
+    return traffic::BIDIRECTIONAL;
+}
+
+// Record the outcome of a unary call started with start_call()
+void record_unary_result(traffic::Writer& log, uint64_t call_id, bool ok, const grpc::Status& status,
+                         const grpc::ByteBuffer& response_buffer) {
+    if (ok && status.ok()) {
+        record_byte_buffer(log, traffic::RECEIVE, call_id, response_buffer);
+    }
+    log.finish(call_id, static_cast<int>(status.error_code()), status.error_message());
+}
+
+godot::Dictionary stats_to_dictionary(const methods::Stats& stats) {
+    uint64_t calls = stats.calls.load(std::memory_order_relaxed);
+    godot::Dictionary entry;
+    entry["calls"] = static_cast<int64_t>(calls);
+    entry["errors"] = static_cast<int64_t>(stats.errors.load(std::memory_order_relaxed));
+    entry["messages_sent"] = static_cast<int64_t>(stats.messages_sent.load(std::memory_order_relaxed));
+    entry["messages_received"] = static_cast<int64_t>(stats.messages_received.load(std::memory_order_relaxed));
+    entry["bytes_sent"] = static_cast<int64_t>(stats.bytes_sent.load(std::memory_order_relaxed));
+    entry["bytes_received"] = static_cast<int64_t>(stats.bytes_received.load(std::memory_order_relaxed));
+    double latency_ms = stats.latency_us_total.load(std::memory_order_relaxed) / 1000.0;
+    entry["avg_latency_ms"] = calls > 0 ? latency_ms / calls : 0.0;
+    entry["max_latency_ms"] = stats.latency_us_max.load(std::memory_order_relaxed) / 1000.0;
+    return entry;
+}
+
+} // namespace
+
+GrpcClient::GrpcClient() {
     Logger::debug("GrpcClient created");
 }
 
 GrpcClient::~GrpcClient() {
     Logger::debug("GrpcClient destroyed");
+    clear_call_credentials();
+    replay_stop();
     close();
+    stop_json_worker();
 }
 
 void GrpcClient::_bind_methods() {
     // Lifecycle methods
     godot::ClassDB::bind_method(godot::D_METHOD("connect", "endpoint", "options"), &GrpcClient::connect, DEFVAL(godot::Dictionary()));
     godot::ClassDB::bind_method(godot::D_METHOD("close"), &GrpcClient::close);
+    godot::ClassDB::bind_method(godot::D_METHOD("close_async", "drain_ms"), &GrpcClient::close_async, DEFVAL(0));
+    godot::ClassDB::bind_method(godot::D_METHOD("_finish_close_async"), &GrpcClient::_finish_close_async);
     godot::ClassDB::bind_method(godot::D_METHOD("is_connected"), &GrpcClient::is_connected);
 
+    // Call credentials
+    godot::ClassDB::bind_method(godot::D_METHOD("set_call_credentials", "options"), &GrpcClient::set_call_credentials);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_call_token", "token", "expires_in_s"), &GrpcClient::set_call_token, DEFVAL(0.0));
+    godot::ClassDB::bind_method(godot::D_METHOD("clear_call_credentials"), &GrpcClient::clear_call_credentials);
+
+    // Prepared methods
+    godot::ClassDB::bind_method(godot::D_METHOD("prepare_method", "full_method"), &GrpcClient::prepare_method);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_method_stats"), &GrpcClient::get_method_stats);
+    godot::ClassDB::bind_method(godot::D_METHOD("reset_method_stats"), &GrpcClient::reset_method_stats);
+
     // Unary RPC
-    godot::ClassDB::bind_method(godot::D_METHOD("unary", "full_method", "request_bytes", "call_opts"), &GrpcClient::unary, DEFVAL(godot::Dictionary()));
+    godot::ClassDB::bind_method(godot::D_METHOD("unary", "full_method", "request_bytes", "call_opts"), &GrpcClient::unary, DEFVAL(godot::Variant()));
 
     // Server-streaming RPC
-    godot::ClassDB::bind_method(godot::D_METHOD("server_stream_start", "full_method", "request_bytes", "call_opts"), &GrpcClient::server_stream_start, DEFVAL(godot::Dictionary()));
+    godot::ClassDB::bind_method(godot::D_METHOD("server_stream_start", "full_method", "request_bytes", "call_opts"), &GrpcClient::server_stream_start, DEFVAL(godot::Variant()));
     godot::ClassDB::bind_method(godot::D_METHOD("server_stream_cancel", "stream_id"), &GrpcClient::server_stream_cancel);
 
     // Client-streaming RPC
-    godot::ClassDB::bind_method(godot::D_METHOD("client_stream_start", "full_method", "call_opts"), &GrpcClient::client_stream_start, DEFVAL(godot::Dictionary()));
+    godot::ClassDB::bind_method(godot::D_METHOD("client_stream_start", "full_method", "call_opts"), &GrpcClient::client_stream_start, DEFVAL(godot::Variant()));
 
     // Bidirectional streaming RPC
-    godot::ClassDB::bind_method(godot::D_METHOD("bidi_stream_start", "full_method", "call_opts"), &GrpcClient::bidi_stream_start, DEFVAL(godot::Dictionary()));
+    godot::ClassDB::bind_method(godot::D_METHOD("bidi_stream_start", "full_method", "call_opts"), &GrpcClient::bidi_stream_start, DEFVAL(godot::Variant()));
 
     // Stream management
     godot::ClassDB::bind_method(godot::D_METHOD("stream_send", "stream_id", "message_bytes"), &GrpcClient::stream_send);
     godot::ClassDB::bind_method(godot::D_METHOD("stream_close_send", "stream_id"), &GrpcClient::stream_close_send);
     godot::ClassDB::bind_method(godot::D_METHOD("stream_cancel", "stream_id"), &GrpcClient::stream_cancel);
 
+    // JSON transcoding
+    godot::ClassDB::bind_method(godot::D_METHOD("unary_json", "full_method", "json", "call_opts"), &GrpcClient::unary_json, DEFVAL(godot::Variant()));
+    godot::ClassDB::bind_method(godot::D_METHOD("set_schema", "schema"), &GrpcClient::set_schema);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_schema"), &GrpcClient::get_schema);
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::OBJECT, "schema", godot::PROPERTY_HINT_RESOURCE_TYPE, "GrpcSchema"), "set_schema", "get_schema");
+
+    // Schema discovery
+    godot::ClassDB::bind_method(godot::D_METHOD("fetch_schema", "service", "refresh"), &GrpcClient::fetch_schema, DEFVAL(false));
+
+    // Recording and replay
+    godot::ClassDB::bind_method(godot::D_METHOD("set_recorder", "recorder"), &GrpcClient::set_recorder);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_recorder"), &GrpcClient::get_recorder);
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::OBJECT, "recorder", godot::PROPERTY_HINT_RESOURCE_TYPE, "GrpcRecorder"), "set_recorder", "get_recorder");
+    godot::ClassDB::bind_method(godot::D_METHOD("replay_start", "path", "speed"), &GrpcClient::replay_start, DEFVAL(1.0));
+    godot::ClassDB::bind_method(godot::D_METHOD("replay_stop"), &GrpcClient::replay_stop);
+    godot::ClassDB::bind_method(godot::D_METHOD("is_replaying"), &GrpcClient::is_replaying);
+
     // Logging
     godot::ClassDB::bind_method(godot::D_METHOD("set_log_level", "level"), &GrpcClient::set_log_level);
     godot::ClassDB::bind_method(godot::D_METHOD("get_log_level"), &GrpcClient::get_log_level);
 
+    // Allocation profiling
+    godot::ClassDB::bind_method(godot::D_METHOD("get_alloc_stats"), &GrpcClient::get_alloc_stats);
+    godot::ClassDB::bind_method(godot::D_METHOD("reset_alloc_stats"), &GrpcClient::reset_alloc_stats);
+
     // Signals for streaming
     ADD_SIGNAL(godot::MethodInfo("message", godot::PropertyInfo(godot::Variant::INT, "stream_id"), godot::PropertyInfo(godot::Variant::PACKED_BYTE_ARRAY, "data")));
     ADD_SIGNAL(godot::MethodInfo("finished", godot::PropertyInfo(godot::Variant::INT, "stream_id"), godot::PropertyInfo(godot::Variant::INT, "status_code"), godot::PropertyInfo(godot::Variant::STRING, "message")));
+    ADD_SIGNAL(godot::MethodInfo("columns", godot::PropertyInfo(godot::Variant::INT, "stream_id"), godot::PropertyInfo(godot::Variant::DICTIONARY, "columns")));
     ADD_SIGNAL(godot::MethodInfo("error", godot::PropertyInfo(godot::Variant::INT, "stream_id"), godot::PropertyInfo(godot::Variant::INT, "status_code"), godot::PropertyInfo(godot::Variant::STRING, "message")));
+
+    // Signal for close_async
+    ADD_SIGNAL(godot::MethodInfo("closed"));
+
+    // Signal for unary_json
+    ADD_SIGNAL(godot::MethodInfo("json_response", godot::PropertyInfo(godot::Variant::INT, "request_id"), godot::PropertyInfo(godot::Variant::INT, "status_code"), godot::PropertyInfo(godot::Variant::STRING, "json"), godot::PropertyInfo(godot::Variant::STRING, "message")));
+
+    // Signals for replay
+    ADD_SIGNAL(godot::MethodInfo("replay_stream_started", godot::PropertyInfo(godot::Variant::INT, "stream_id"), godot::PropertyInfo(godot::Variant::STRING, "method")));
+    ADD_SIGNAL(godot::MethodInfo("replay_finished", godot::PropertyInfo(godot::Variant::INT, "messages")));
+
+    // Signal for call credentials
+    ADD_SIGNAL(godot::MethodInfo("call_credentials_refresh_failed", godot::PropertyInfo(godot::Variant::STRING, "message")));
 }
 
 bool GrpcClient::connect(const godot::String& endpoint, const godot::Dictionary& options) {
     std::string endpoint_str = endpoint.utf8().get_data();
     ChannelOptions channel_opts = parse_channel_options(options);
 
-    return channel_pool_.create_channel(endpoint_str, channel_opts);
+    bool connected = channel_pool_.create_channel(endpoint_str, channel_opts);
+    std::lock_guard<std::mutex> lock(auth_stub_mutex_);
+    auth_stub_ = channel_pool_.get_stub();
+    return connected;
 }
 
 void GrpcClient::close() {
-    // Cancel all active streams
+    // Let every stream wind down at once, then join them outside the table's locks
+    std::vector<std::unique_ptr<GrpcStream>> streams = streams_.take_all();
+    for (auto& stream : streams) {
+        stream->shutdown();
+    }
+    release_streams(streams);
+    release_channel();
+}
+
+void GrpcClient::close_async(int drain_ms) {
+    std::vector<std::unique_ptr<GrpcStream>> streams = streams_.take_all();
+    if (drain_ms > 0) {
+        for (auto& stream : streams) {
+            stream->close_send();
+        }
+    }
+    release_channel();
+
+    // Streams call back into the client until joined, so the teardown thread
+    // keeps it alive with a reference taken here. _finish_close_async() gives
+    // it back on the main thread, as it may be the last one
+    reference();
+    GrpcClient* self = this;
+    std::thread([self, streams = std::move(streams), drain_ms]() mutable {
+        size_t undrained = 0;
+        if (drain_ms > 0) {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(drain_ms);
+            for (auto& stream : streams) {
+                if (!stream->wait_writer_finished(deadline)) {
+                    undrained++;
+                }
+            }
+        }
+        for (auto& stream : streams) {
+            stream->shutdown();
+        }
+        size_t count = streams.size();
+        streams.clear();
+
+        if (undrained > 0) {
+            Logger::warn("close_async: " + std::to_string(undrained) + " of " + std::to_string(count) +
+                         " streams still had messages to send after " + std::to_string(drain_ms) + " ms");
+        }
+        Logger::debug("close_async: " + std::to_string(count) + " streams closed");
+        self->finished_closes_.fetch_add(1);
+        self->call_deferred("_finish_close_async");
+    }).detach();
+}
+
+void GrpcClient::_finish_close_async() {
+    // Bound for call_deferred(), so scripts can call it too. Only this
+    // (main thread) method decrements, so the check cannot go stale
+    if (finished_closes_.load() == 0) {
+        return;
+    }
+    finished_closes_.fetch_sub(1);
+
+    // Hold the teardown thread's reference past unreference(), so the client
+    // is released only after `closed` has been emitted
+    godot::Ref<GrpcClient> self(this);
+    unreference();
+    emit_signal("closed");
+}
+
+void GrpcClient::release_channel() {
+    // Drop queued JSON calls and cancel the one in flight
     {
-        std::lock_guard<std::mutex> lock(streams_mutex_);
-        for (auto& pair : active_streams_) {
-            pair.second->cancel();
+        std::lock_guard<std::mutex> lock(json_mutex_);
+        json_queue_.clear();
+        if (json_active_context_) {
+            json_active_context_->TryCancel();
         }
-        active_streams_.clear();
     }
 
     // Close the channel
+    {
+        std::lock_guard<std::mutex> lock(auth_stub_mutex_);
+        auth_stub_.reset();
+    }
     channel_pool_.close();
 }
 
@@ -79,13 +242,143 @@ bool GrpcClient::is_connected() const {
     return channel_pool_.is_connected();
 }
 
+bool GrpcClient::set_call_credentials(const godot::Dictionary& options) {
+    clear_call_credentials();
+
+    auth::TokenSettings settings;
+    if (options.has("header")) {
+        // gRPC only accepts lowercase metadata keys
+        settings.header = godot::String(options["header"]).to_lower().utf8().get_data();
+    }
+    if (options.has("prefix")) {
+        settings.prefix = godot::String(options["prefix"]).utf8().get_data();
+    }
+    if (options.has("refresh_margin_s")) {
+        settings.refresh_margin_s = options["refresh_margin_s"];
+    }
+    if (options.has("token")) {
+        settings.token = godot::String(options["token"]).utf8().get_data();
+        settings.expires_in_s = options.get("expires_in_s", 0.0);
+    }
+
+    godot::Callable refresh_callable = options.get("refresh_callable", godot::Callable());
+    std::string refresh_method = godot::String(options.get("refresh_method", "")).utf8().get_data();
+    if (refresh_callable.is_valid() && !refresh_method.empty()) {
+        Logger::error("set_call_credentials: give refresh_callable or refresh_method, not both");
+        return false;
+    }
+    if (settings.token.empty() && !refresh_callable.is_valid() && refresh_method.empty()) {
+        Logger::error("set_call_credentials: needs a token, refresh_callable or refresh_method");
+        return false;
+    }
+
+    auth::TokenCache::RefreshFunction refresh;
+    if (refresh_callable.is_valid()) {
+        // The script answers later through set_call_token()
+        refresh = [refresh_callable](auth::TokenCache&) {
+            refresh_callable.call_deferred();
+        };
+    } else if (!refresh_method.empty()) {
+        auth::UnaryRefresh spec;
+        spec.method = refresh_method;
+        godot::PackedByteArray request = options.get("refresh_request", godot::PackedByteArray());
+        spec.request.assign(reinterpret_cast<const char*>(request.ptr()), static_cast<size_t>(request.size()));
+        spec.token_field = static_cast<uint32_t>(static_cast<int>(options.get("token_field", 1)));
+        spec.expires_in_field = static_cast<uint32_t>(static_cast<int>(options.get("expires_in_field", 2)));
+        spec.timeout_ms = options.get("refresh_timeout_ms", 10000);
+        refresh = auth::unary_refresher(spec, [this]() { return get_auth_stub(); });
+    }
+
+    auto on_failure = [this](const std::string& message) {
+        call_deferred("emit_signal", "call_credentials_refresh_failed", godot::String::utf8(message.c_str()));
+    };
+
+    bool allow_insecure = options.get("allow_insecure", false);
+    auto token_cache = std::make_shared<auth::TokenCache>(settings, refresh, on_failure);
+    auto call_credentials = auth::make_call_credentials(token_cache, allow_insecure);
+    std::lock_guard<std::mutex> lock(credentials_mutex_);
+    token_cache_ = std::move(token_cache);
+    call_credentials_ = std::move(call_credentials);
+    return true;
+}
+
+void GrpcClient::set_call_token(const godot::String& token, double expires_in_s) {
+    std::shared_ptr<auth::TokenCache> token_cache;
+    {
+        std::lock_guard<std::mutex> lock(credentials_mutex_);
+        token_cache = token_cache_;
+    }
+    if (!token_cache) {
+        Logger::error("set_call_token: call set_call_credentials() first");
+        return;
+    }
+    token_cache->set_token(token.utf8().get_data(), expires_in_s);
+}
+
+void GrpcClient::clear_call_credentials() {
+    std::shared_ptr<auth::TokenCache> token_cache;
+    {
+        std::lock_guard<std::mutex> lock(credentials_mutex_);
+        token_cache = std::move(token_cache_);
+        call_credentials_.reset();
+    }
+    // Calls in flight keep the cache alive, but its thread (which refers to
+    // this client) stops here. stop() cancels a refresh call in progress, so
+    // this does not wait for its timeout.
+    if (token_cache) {
+        token_cache->stop();
+    }
+}
+
+std::shared_ptr<grpc::GenericStub> GrpcClient::get_auth_stub() {
+    std::lock_guard<std::mutex> lock(auth_stub_mutex_);
+    return auth_stub_;
+}
+
+int GrpcClient::prepare_method(const godot::String& full_method) {
+    std::string name = full_method.utf8().get_data();
+    if (!methods::Table::valid_name(name)) {
+        Logger::error("prepare_method expects \"/package.Service/Method\", got \"" + name + "\"");
+        return -1;
+    }
+    int handle = methods_.intern(name);
+    if (handle < 0) {
+        Logger::error("prepare_method: already " + std::to_string(methods::Table::MAX_METHODS) +
+                      " methods, cannot add " + name);
+    }
+    return handle;
+}
+
+godot::Dictionary GrpcClient::get_method_stats() const {
+    godot::Dictionary result;
+    for (size_t i = 0; i < methods_.size(); ++i) {
+        const methods::Method& method = methods_.at(i);
+        result[godot::String::utf8(method.name.c_str())] = stats_to_dictionary(method.stats);
+    }
+    if (methods_.untracked_stats().calls.load(std::memory_order_relaxed) > 0) {
+        result["(untracked)"] = stats_to_dictionary(methods_.untracked_stats());
+    }
+    return result;
+}
+
+void GrpcClient::reset_method_stats() {
+    methods_.reset_stats();
+}
+
 godot::PackedByteArray GrpcClient::unary(
-    const godot::String& full_method,
+    const godot::Variant& full_method,
     const godot::PackedByteArray& request_bytes,
-    const godot::Dictionary& call_opts
+    const godot::Variant& call_opts
 ) {
-    std::string method = full_method.utf8().get_data();
-    Logger::debug("Unary call to " + method);
+    methods::Resolved entry;
+    if (!resolve_method(full_method, &entry)) {
+        return godot::PackedByteArray();
+    }
+    const std::string& method = *entry.name;
+    methods::Stats& stats = *entry.stats;
+    if (Logger::enabled(LogLevel::DEBUG)) {
+        Logger::debug("Unary call to " + method);
+    }
 
     auto stub = channel_pool_.get_stub();
     if (!stub) {
@@ -94,8 +387,15 @@ godot::PackedByteArray GrpcClient::unary(
         return godot::PackedByteArray();
     }
 
+    GODOT_GRPC_ALLOC_SCOPE(alloc::UNARY_CALL);
+
     // Create context
-    auto context = create_context(call_opts);
+    CallOptions parsed_options;
+    const CallOptions* options = resolve_call_options(call_opts, &parsed_options);
+    if (!options) {
+        return godot::PackedByteArray();
+    }
+    auto context = create_context(*options);
 
     // Prepare request ByteBuffer
     grpc::ByteBuffer request_buffer;
@@ -103,11 +403,24 @@ godot::PackedByteArray GrpcClient::unary(
         const uint8_t* data = request_bytes.ptr();
         size_t size = request_bytes.size();
         grpc::Slice slice(data, size);
+        GODOT_GRPC_ALLOC_NOTE_SLICE(size);
         request_buffer.Clear();
         grpc::ByteBuffer temp(&slice, 1);
         request_buffer.Swap(&temp);
     }
 
+    std::shared_ptr<traffic::Writer> traffic_log = recorder_.is_valid() ? recorder_->get_writer() : nullptr;
+    uint64_t traffic_call_id = 0;
+    if (traffic_log) {
+        traffic_call_id = traffic_log->start_call(traffic::UNARY, 0, method, options->metadata);
+        traffic_log->message(traffic::SEND, traffic_call_id, request_bytes.ptr(), request_bytes.size());
+    }
+
+    stats.add(stats.calls, 1);
+    stats.add(stats.messages_sent, 1);
+    stats.add(stats.bytes_sent, request_bytes.size());
+    auto started = std::chrono::steady_clock::now();
+
     // Use async API in blocking mode
     grpc::CompletionQueue cq;
     grpc::ByteBuffer response_buffer;
@@ -124,63 +437,95 @@ godot::PackedByteArray GrpcClient::unary(
     bool ok = false;
     cq.Next(&got_tag, &ok);
 
+    stats.record_latency(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started).count());
+
+    if (traffic_log) {
+        record_unary_result(*traffic_log, traffic_call_id, ok, status, response_buffer);
+    }
+
     if (!ok || !status.ok()) {
+        stats.add(stats.errors, 1);
         std::string error_msg = StatusMap::format_error(status);
         Logger::error("Unary call failed: " + error_msg);
         godot::UtilityFunctions::push_error(("GrpcClient: " + error_msg).c_str());
         return godot::PackedByteArray();
     }
 
-    // Convert response ByteBuffer to PackedByteArray
+    stats.add(stats.messages_received, 1);
+    stats.add(stats.bytes_received, response_buffer.Length());
+
+    // Convert response ByteBuffer to PackedByteArray, sized once up front
     std::vector<grpc::Slice> slices;
     (void)response_buffer.Dump(&slices);
 
     godot::PackedByteArray response_bytes;
+    response_bytes.resize(static_cast<int64_t>(response_buffer.Length()));
+    GODOT_GRPC_ALLOC_NOTE_STREAM_BYTES(response_bytes.size());
+    size_t offset = 0;
     for (const auto& slice : slices) {
-        size_t slice_size = slice.size();
-        int64_t old_size = response_bytes.size();
-        response_bytes.resize(old_size + slice_size);
-        memcpy(response_bytes.ptrw() + old_size, slice.begin(), slice_size);
+        memcpy(response_bytes.ptrw() + offset, slice.begin(), slice.size());
+        offset += slice.size();
     }
 
-    Logger::debug("Unary call succeeded, response size: " + std::to_string(response_bytes.size()));
+    if (Logger::enabled(LogLevel::DEBUG)) {
+        Logger::debug("Unary call succeeded, response size: " + std::to_string(response_bytes.size()));
+    }
     return response_bytes;
 }
 
-int GrpcClient::server_stream_start(
-    const godot::String& full_method,
+int64_t GrpcClient::server_stream_start(
+    const godot::Variant& full_method,
     const godot::PackedByteArray& request_bytes,
-    const godot::Dictionary& call_opts
+    const godot::Variant& call_opts
 ) {
-    return start_stream(StreamType::SERVER_STREAMING, full_method, request_bytes, call_opts);
+    methods::Resolved method;
+    if (!resolve_method(full_method, &method)) {
+        return -1;
+    }
+    return start_stream(StreamType::SERVER_STREAMING, method, request_bytes, call_opts);
 }
 
-int GrpcClient::client_stream_start(
-    const godot::String& full_method,
-    const godot::Dictionary& call_opts
+int64_t GrpcClient::client_stream_start(
+    const godot::Variant& full_method,
+    const godot::Variant& call_opts
 ) {
-    return start_stream(StreamType::CLIENT_STREAMING, full_method, godot::PackedByteArray(), call_opts);
+    methods::Resolved method;
+    if (!resolve_method(full_method, &method)) {
+        return -1;
+    }
+    return start_stream(StreamType::CLIENT_STREAMING, method, godot::PackedByteArray(), call_opts);
 }
 
-int GrpcClient::bidi_stream_start(
-    const godot::String& full_method,
-    const godot::Dictionary& call_opts
+int64_t GrpcClient::bidi_stream_start(
+    const godot::Variant& full_method,
+    const godot::Variant& call_opts
 ) {
-    return start_stream(StreamType::BIDIRECTIONAL, full_method, godot::PackedByteArray(), call_opts);
+    methods::Resolved method;
+    if (!resolve_method(full_method, &method)) {
+        return -1;
+    }
+    return start_stream(StreamType::BIDIRECTIONAL, method, godot::PackedByteArray(), call_opts);
 }
 
-int GrpcClient::start_stream(
+int64_t GrpcClient::start_stream(
     StreamType stream_type,
-    const godot::String& full_method,
+    const methods::Resolved& method_entry,
     const godot::PackedByteArray& request_bytes,
-    const godot::Dictionary& call_opts
+    const godot::Variant& call_opts,
+    StreamRawMessageHandler native_handler
 ) {
-    std::string method = full_method.utf8().get_data();
-    std::string type_str =
+    const std::string& method = *method_entry.name;
+    const char* type_str =
         (stream_type == StreamType::SERVER_STREAMING ? "server-streaming" :
          stream_type == StreamType::CLIENT_STREAMING ? "client-streaming" : "bidirectional");
 
-    Logger::debug("Starting " + type_str + " stream for " + method);
+    if (Logger::enabled(LogLevel::DEBUG)) {
+        Logger::debug(std::string("Starting ") + type_str + " stream for " + method);
+    }
+
+    // Join streams that finished since the last start
+    reap_finished_streams();
 
     auto stub = channel_pool_.get_stub();
     if (!stub) {
@@ -189,16 +534,50 @@ int GrpcClient::start_stream(
         return -1;
     }
 
-    // Create context
-    auto context = create_context(call_opts);
+    CallOptions parsed_options;
+    const CallOptions* options = resolve_call_options(call_opts, &parsed_options);
+    if (!options) {
+        return -1;
+    }
 
-    // Allocate stream ID
-    int stream_id;
-    {
-        std::lock_guard<std::mutex> lock(streams_mutex_);
-        stream_id = next_stream_id_++;
+    // Optional columnar decoding, delta decoding or snapshot buffering on the
+    // reader thread, unless native code installed its own handler. These
+    // options only come in Dictionary form.
+    StreamRawMessageHandler raw_handler = std::move(native_handler);
+    if (!raw_handler && call_opts.get_type() == godot::Variant::DICTIONARY) {
+        godot::Dictionary stream_opts = call_opts;
+        if (stream_opts.has("columnar") && (stream_opts.has("snapshot_buffer") || stream_opts.has("delta"))) {
+            Logger::error("columnar cannot be combined with snapshot_buffer or delta");
+            return -1;
+        }
+        godot::Ref<GrpcSnapshotBuffer> snapshot_buffer;
+        if (stream_opts.has("snapshot_buffer")) {
+            snapshot_buffer = stream_opts["snapshot_buffer"];
+            if (snapshot_buffer.is_null()) {
+                Logger::error("snapshot_buffer option requires a GrpcSnapshotBuffer");
+                return -1;
+            }
+        }
+        if (stream_opts.has("columnar")) {
+            raw_handler = create_columnar_handler(stream_opts["columnar"]);
+            if (!raw_handler) {
+                return -1;
+            }
+        } else if (stream_opts.has("delta")) {
+            raw_handler = create_delta_handler(stream_opts["delta"], stream_type, snapshot_buffer);
+        } else if (snapshot_buffer.is_valid()) {
+            raw_handler = [snapshot_buffer](GrpcStream&, const grpc::ByteBuffer& message) {
+                snapshot_buffer->push_buffer(message);
+                return true;
+            };
+        }
     }
 
+    // Create context
+    auto context = create_context(*options);
+
+    int64_t stream_id = StreamTable::allocate_id();
+
     // Create stream with callbacks
     auto stream = std::make_unique<GrpcStream>(
         stream_id,
@@ -207,79 +586,451 @@ int GrpcClient::start_stream(
         method,
         request_bytes,
         std::move(context),
-        [this](int id, const godot::PackedByteArray& data) {
+        [this](int64_t id, const godot::PackedByteArray& data) {
             this->on_stream_message(id, data);
         },
-        [this](int id, int code, const std::string& msg) {
+        [this](int64_t id, int code, const std::string& msg) {
             this->on_stream_finished(id, code, msg);
         },
-        [this](int id, int code, const std::string& msg) {
+        [this](int64_t id, int code, const std::string& msg) {
             this->on_stream_error(id, code, msg);
         }
     );
 
+    if (raw_handler) {
+        stream->set_raw_message_handler(std::move(raw_handler));
+    }
+
+    method_entry.stats->add(method_entry.stats->calls, 1);
+    stream->set_method_stats(method_entry.stats);
+
+    if (recorder_.is_valid()) {
+        if (std::shared_ptr<traffic::Writer> traffic_log = recorder_->get_writer()) {
+            uint64_t call_id = traffic_log->start_call(traffic_call_type(stream_type), stream_id, method, options->metadata);
+            stream->set_traffic_log(traffic_log, call_id);
+        }
+    }
+
     // Start the stream
     stream->start();
 
-    // Store the stream
-    {
-        std::lock_guard<std::mutex> lock(streams_mutex_);
-        active_streams_[stream_id] = std::move(stream);
-    }
+    streams_.add(std::move(stream));
 
-    Logger::info("Stream " + std::to_string(stream_id) + " (" + type_str + ") started");
+    if (Logger::enabled(LogLevel::INFO)) {
+        Logger::info("Stream " + std::to_string(stream_id) + " (" + type_str + ") started");
+    }
     return stream_id;
 }
 
-bool GrpcClient::stream_send(int stream_id, const godot::PackedByteArray& message_bytes) {
-    std::lock_guard<std::mutex> lock(streams_mutex_);
+int64_t GrpcClient::bidi_stream_start_with_handler(
+    const godot::Variant& full_method,
+    const godot::Variant& call_opts,
+    StreamRawMessageHandler handler
+) {
+    methods::Resolved method;
+    if (!resolve_method(full_method, &method)) {
+        return -1;
+    }
+    return start_stream(StreamType::BIDIRECTIONAL, method, godot::PackedByteArray(), call_opts, std::move(handler));
+}
 
-    auto it = active_streams_.find(stream_id);
-    if (it == active_streams_.end()) {
+bool GrpcClient::stream_send(int64_t stream_id, const godot::PackedByteArray& message_bytes) {
+    bool queued = false;
+    if (!streams_.with_stream(stream_id, [&](GrpcStream& stream) { queued = stream.send(message_bytes); })) {
         Logger::warn("Stream " + std::to_string(stream_id) + " not found for send");
         godot::UtilityFunctions::push_warning("GrpcClient: Stream not found");
         return false;
     }
+    return queued;
+}
 
-    return it->second->send(message_bytes);
+void GrpcClient::stream_close_send(int64_t stream_id) {
+    if (!streams_.with_stream(stream_id, [](GrpcStream& stream) { stream.close_send(); })) {
+        Logger::warn("Stream " + std::to_string(stream_id) + " not found for close_send");
+    }
 }
 
-void GrpcClient::stream_close_send(int stream_id) {
-    std::lock_guard<std::mutex> lock(streams_mutex_);
+void GrpcClient::stream_cancel(int64_t stream_id) {
+    std::vector<std::unique_ptr<GrpcStream>> streams;
+    streams.push_back(streams_.take(stream_id));
+    if (!streams.front()) {
+        Logger::warn("Stream " + std::to_string(stream_id) + " not found for cancel");
+        return;
+    }
 
-    auto it = active_streams_.find(stream_id);
-    if (it != active_streams_.end()) {
-        Logger::debug("Closing send on stream " + std::to_string(stream_id));
-        it->second->close_send();
-    } else {
-        Logger::warn("Stream " + std::to_string(stream_id) + " not found for close_send");
+    Logger::debug("Cancelling stream " + std::to_string(stream_id));
+    streams.front()->cancel();
+    release_streams(streams);
+}
+
+void GrpcClient::server_stream_cancel(int64_t stream_id) {
+    std::vector<std::unique_ptr<GrpcStream>> streams;
+    streams.push_back(streams_.take(stream_id));
+    if (!streams.front()) {
+        Logger::warn("Stream " + std::to_string(stream_id) + " not found");
+        return;
     }
+
+    Logger::debug("Cancelling server stream " + std::to_string(stream_id));
+    streams.front()->cancel();
+    release_streams(streams);
 }
 
-void GrpcClient::stream_cancel(int stream_id) {
-    std::lock_guard<std::mutex> lock(streams_mutex_);
+int GrpcClient::unary_json(
+    const godot::Variant& full_method,
+    const godot::String& json,
+    const godot::Variant& call_opts
+) {
+    if (schema_.is_null()) {
+        Logger::error("unary_json requires a schema");
+        godot::UtilityFunctions::push_error("GrpcClient: unary_json requires a schema");
+        return -1;
+    }
 
-    auto it = active_streams_.find(stream_id);
-    if (it != active_streams_.end()) {
-        Logger::debug("Cancelling stream " + std::to_string(stream_id));
-        it->second->cancel();
-        active_streams_.erase(it);
-    } else {
-        Logger::warn("Stream " + std::to_string(stream_id) + " not found for cancel");
+    auto stub = channel_pool_.get_stub();
+    if (!stub) {
+        Logger::error("No active connection for unary_json call");
+        godot::UtilityFunctions::push_error("GrpcClient: Not connected");
+        return -1;
+    }
+
+    methods::Resolved method;
+    if (!resolve_method(full_method, &method)) {
+        return -1;
+    }
+
+    CallOptions parsed_options;
+    const CallOptions* options = resolve_call_options(call_opts, &parsed_options);
+    if (!options) {
+        return -1;
+    }
+
+    JsonCall call;
+    call.method = *method.name;
+    call.stats = method.stats;
+    call.json = json.utf8().get_data();
+    call.schema = schema_->snapshot();
+    call.stub = stub;
+    call.context = create_context(*options);
+    if (recorder_.is_valid()) {
+        call.traffic_log = recorder_->get_writer();
+        call.metadata = options->metadata;
+    }
+
+    std::lock_guard<std::mutex> lock(json_mutex_);
+    call.request_id = next_json_request_id_++;
+    int request_id = call.request_id;
+    json_queue_.push_back(std::move(call));
+
+    if (!json_thread_.joinable()) {
+        json_stop_ = false;
+        json_thread_ = std::thread(&GrpcClient::json_worker_loop, this);
     }
+    json_cv_.notify_one();
+
+    Logger::debug("Queued unary_json call " + std::to_string(request_id) + " to " + *method.name);
+    return request_id;
+}
+
+void GrpcClient::set_schema(const godot::Ref<GrpcSchema>& schema) {
+    schema_ = schema;
 }
 
-void GrpcClient::server_stream_cancel(int stream_id) {
-    std::lock_guard<std::mutex> lock(streams_mutex_);
+godot::Ref<GrpcSchema> GrpcClient::get_schema() const {
+    return schema_;
+}
+
+void GrpcClient::json_worker_loop() {
+    std::unique_lock<std::mutex> lock(json_mutex_);
+    while (true) {
+        json_cv_.wait(lock, [this] { return json_stop_ || !json_queue_.empty(); });
+        if (json_stop_) {
+            break;
+        }
+
+        JsonCall call = std::move(json_queue_.front());
+        json_queue_.pop_front();
+        json_active_context_ = call.context.get();
+        lock.unlock();
+
+        run_json_call(call);
+
+        lock.lock();
+        json_active_context_ = nullptr;
+    }
+}
+
+void GrpcClient::run_json_call(JsonCall& call) {
+    methods::Stats& stats = *call.stats;
+    stats.add(stats.calls, 1);
+    auto fail = [this, &call, &stats](int status_code, const std::string& message) {
+        stats.add(stats.errors, 1);
+        Logger::error("unary_json call " + std::to_string(call.request_id) + " failed: " + message);
+        call_deferred("emit_signal", "json_response", call.request_id, status_code, godot::String(),
+                      godot::String::utf8(message.c_str()));
+    };
+
+    const google::protobuf::MethodDescriptor* method = call.schema ? call.schema->find_method(call.method) : nullptr;
+    if (!method) {
+        fail(grpc::StatusCode::UNIMPLEMENTED, "method " + call.method + " not found in schema");
+        return;
+    }
+
+    std::string request;
+    std::string error;
+    if (!call.schema->json_to_binary(method->input_type(), call.json, &request, &error)) {
+        fail(grpc::StatusCode::INVALID_ARGUMENT, error);
+        return;
+    }
+
+    grpc::Slice slice(request);
+    grpc::ByteBuffer request_buffer(&slice, 1);
+    stats.add(stats.messages_sent, 1);
+    stats.add(stats.bytes_sent, request.size());
+
+    uint64_t traffic_call_id = 0;
+    if (call.traffic_log) {
+        traffic_call_id = call.traffic_log->start_call(traffic::UNARY, 0, call.method, call.metadata);
+        call.traffic_log->message(traffic::SEND, traffic_call_id,
+                                  reinterpret_cast<const uint8_t*>(request.data()), request.size());
+    }
+
+    grpc::CompletionQueue cq;
+    grpc::ByteBuffer response_buffer;
+    grpc::Status status;
+
+    auto started = std::chrono::steady_clock::now();
+    std::unique_ptr<grpc::GenericClientAsyncResponseReader> rpc(
+        call.stub->PrepareUnaryCall(call.context.get(), call.method, request_buffer, &cq)
+    );
+    rpc->StartCall();
+    rpc->Finish(&response_buffer, &status, (void*)1);
+
+    void* got_tag;
+    bool ok = false;
+    cq.Next(&got_tag, &ok);
+    stats.record_latency(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started).count());
+
+    if (call.traffic_log) {
+        record_unary_result(*call.traffic_log, traffic_call_id, ok, status, response_buffer);
+    }
+
+    if (!ok || !status.ok()) {
+        fail(status.error_code(), StatusMap::format_error(status));
+        return;
+    }
 
-    auto it = active_streams_.find(stream_id);
-    if (it != active_streams_.end()) {
-        Logger::debug("Cancelling server stream " + std::to_string(stream_id));
-        it->second->cancel();
-        active_streams_.erase(it);
+    stats.add(stats.messages_received, 1);
+    stats.add(stats.bytes_received, response_buffer.Length());
+
+    std::vector<grpc::Slice> slices;
+    (void)response_buffer.Dump(&slices);
+    std::string response;
+    response.reserve(response_buffer.Length());
+    for (const auto& part : slices) {
+        response.append(reinterpret_cast<const char*>(part.begin()), part.size());
+    }
+
+    std::string json;
+    if (!call.schema->binary_to_json(method->output_type(), response, &json, &error)) {
+        fail(grpc::StatusCode::INTERNAL, error);
+        return;
+    }
+
+    Logger::debug("unary_json call " + std::to_string(call.request_id) + " succeeded");
+    call_deferred("emit_signal", "json_response", call.request_id, static_cast<int>(grpc::StatusCode::OK),
+                  godot::String::utf8(json.c_str()), godot::String());
+}
+
+void GrpcClient::stop_json_worker() {
+    {
+        std::lock_guard<std::mutex> lock(json_mutex_);
+        json_stop_ = true;
+        json_queue_.clear();
+        if (json_active_context_) {
+            json_active_context_->TryCancel();
+        }
+    }
+    json_cv_.notify_one();
+    if (json_thread_.joinable()) {
+        json_thread_.join();
+    }
+}
+
+godot::Ref<GrpcSchema> GrpcClient::fetch_schema(const godot::String& service, bool refresh) {
+    std::string service_name = service.utf8().get_data();
+    std::string cache_key = channel_pool_.get_endpoint() + "|" + service_name;
+
+    // 1. In-memory cache
+    if (!refresh) {
+        std::lock_guard<std::mutex> lock(schema_cache_mutex_);
+        auto it = schema_cache_.find(cache_key);
+        if (it != schema_cache_.end()) {
+            return it->second;
+        }
+    }
+
+    godot::Ref<GrpcSchema> schema;
+    schema.instantiate();
+    godot::String disk_path = godot::String::utf8(schema_cache_path(service_name).c_str());
+
+    // 2. On-disk cache
+    if (!refresh && godot::FileAccess::file_exists(disk_path) && schema->load_descriptor_set_file(disk_path)) {
+        Logger::debug("Loaded schema for " + service_name + " from disk cache");
     } else {
-        Logger::warn("Stream " + std::to_string(stream_id) + " not found");
+        // 3. Server reflection
+        auto stub = channel_pool_.get_stub();
+        if (!stub) {
+            Logger::error("No active connection for schema reflection");
+            godot::UtilityFunctions::push_error("GrpcClient: Not connected");
+            return godot::Ref<GrpcSchema>();
+        }
+
+        std::string descriptor_set;
+        std::string error;
+        if (!GrpcReflection::fetch_descriptor_set(stub, service_name, 5000, &descriptor_set, &error)) {
+            Logger::error("Schema reflection for " + service_name + " failed: " + error);
+            godot::UtilityFunctions::push_error(("GrpcClient: " + error).c_str());
+            return godot::Ref<GrpcSchema>();
+        }
+
+        godot::PackedByteArray bytes;
+        bytes.resize(descriptor_set.size());
+        memcpy(bytes.ptrw(), descriptor_set.data(), descriptor_set.size());
+        if (!schema->load_descriptor_set(bytes)) {
+            return godot::Ref<GrpcSchema>();
+        }
+
+        // Persist for the next session; failure only costs a round trip later
+        godot::DirAccess::make_dir_recursive_absolute(disk_path.get_base_dir());
+        godot::Ref<godot::FileAccess> file = godot::FileAccess::open(disk_path, godot::FileAccess::WRITE);
+        if (file.is_valid()) {
+            file->store_buffer(bytes);
+            file->close();
+        } else {
+            Logger::warn("Could not write schema cache for " + service_name);
+        }
+        Logger::info("Fetched schema for " + service_name + " via reflection");
     }
+
+    std::lock_guard<std::mutex> lock(schema_cache_mutex_);
+    schema_cache_[cache_key] = schema;
+    return schema;
+}
+
+std::string GrpcClient::schema_cache_path(const std::string& service) const {
+    // One directory per endpoint so different servers never share descriptors
+    std::string endpoint = channel_pool_.get_endpoint();
+    for (char& c : endpoint) {
+        bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                    c == '.' || c == '-' || c == '_';
+        if (!safe) {
+            c = '_';
+        }
+    }
+    return "user://grpc_schema_cache/" + endpoint + "/" + service + ".pb";
+}
+
+void GrpcClient::set_recorder(const godot::Ref<GrpcRecorder>& recorder) {
+    recorder_ = recorder;
+}
+
+godot::Ref<GrpcRecorder> GrpcClient::get_recorder() const {
+    return recorder_;
+}
+
+bool GrpcClient::replay_start(const godot::String& path, double speed) {
+    replay_stop();
+
+    auto reader = std::make_shared<traffic::Reader>();
+    std::string error;
+    std::string global_path = godot::ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+    if (!reader->open(global_path, &error)) {
+        Logger::error("Replay failed: " + error);
+        godot::UtilityFunctions::push_error(("GrpcClient: " + error).c_str());
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(replay_mutex_);
+        replay_stop_ = false;
+    }
+    replaying_.store(true);
+    replay_thread_ = std::thread(&GrpcClient::replay_loop, this, reader, speed);
+    Logger::info("Replaying " + global_path);
+    return true;
+}
+
+void GrpcClient::replay_stop() {
+    {
+        std::lock_guard<std::mutex> lock(replay_mutex_);
+        replay_stop_ = true;
+    }
+    replay_cv_.notify_all();
+    if (replay_thread_.joinable()) {
+        replay_thread_.join();
+    }
+}
+
+bool GrpcClient::is_replaying() const {
+    return replaying_.load();
+}
+
+void GrpcClient::replay_loop(std::shared_ptr<traffic::Reader> reader, double speed) {
+    std::map<uint64_t, int64_t> stream_ids;  // Recorded call ID -> replayed stream ID
+    int64_t messages = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    traffic::Record record;
+    while (reader->next(&record)) {
+        bool is_new_stream = record.kind == traffic::CALL_START && record.call_type != traffic::UNARY;
+        auto it = stream_ids.find(record.call_id);
+        bool is_stream_event = (record.kind == traffic::RECEIVE || record.kind == traffic::FINISH) && it != stream_ids.end();
+        if (!is_new_stream && !is_stream_event) {
+            continue;
+        }
+
+        // Wait for the record's (scaled) time, or just check for a stop request
+        {
+            std::unique_lock<std::mutex> lock(replay_mutex_);
+            if (speed > 0.0) {
+                auto due = start + std::chrono::microseconds(static_cast<int64_t>(record.time_us / speed));
+                replay_cv_.wait_until(lock, due, [this] { return replay_stop_; });
+            }
+            if (replay_stop_) {
+                break;
+            }
+        }
+
+        if (is_new_stream) {
+            int64_t stream_id = StreamTable::allocate_id();
+            stream_ids[record.call_id] = stream_id;
+            call_deferred("emit_signal", "replay_stream_started", stream_id, godot::String::utf8(record.method.c_str()));
+        } else if (record.kind == traffic::RECEIVE) {
+            godot::PackedByteArray data;
+            data.resize(static_cast<int64_t>(record.payload.size()));
+            if (!record.payload.empty()) {
+                memcpy(data.ptrw(), record.payload.data(), record.payload.size());
+            }
+            on_stream_message(it->second, data);
+            messages++;
+        } else {
+            if (record.status_code == 0) {
+                on_stream_finished(it->second, record.status_code, record.message);
+            } else {
+                on_stream_error(it->second, record.status_code, record.message);
+            }
+            stream_ids.erase(it);
+        }
+    }
+
+    if (!reader->error().empty()) {
+        Logger::error("Replay stopped: " + reader->error());
+    }
+    Logger::info("Replay delivered " + std::to_string(messages) + " messages");
+    replaying_.store(false);
+    call_deferred("emit_signal", "replay_finished", messages);
 }
 
 void GrpcClient::set_log_level(int level) {
@@ -290,27 +1041,70 @@ int GrpcClient::get_log_level() const {
     return static_cast<int>(Logger::get_level());
 }
 
-std::unique_ptr<grpc::ClientContext> GrpcClient::create_context(const godot::Dictionary& call_opts) {
-    auto context = std::make_unique<grpc::ClientContext>();
+godot::Dictionary GrpcClient::get_alloc_stats() const {
+    godot::Dictionary stats;
+#ifdef GODOT_GRPC_ALLOC_STATS
+    for (int i = 0; i < alloc::OP_COUNT; ++i) {
+        alloc::Op op = static_cast<alloc::Op>(i);
+        alloc::Counters counters = alloc::snapshot(op);
+        godot::Dictionary entry;
+        entry["operations"] = static_cast<int64_t>(counters.operations);
+        entry["allocations"] = static_cast<int64_t>(counters.allocations);
+        entry["bytes"] = static_cast<int64_t>(counters.bytes);
+        double operations = counters.operations > 0 ? static_cast<double>(counters.operations) : 1.0;
+        entry["allocations_per_op"] = counters.allocations / operations;
+        entry["bytes_per_op"] = counters.bytes / operations;
+        stats[alloc::op_name(op)] = entry;
+    }
+#endif
+    return stats;
+}
 
-    // Set deadline if specified
-    if (call_opts.has("deadline_ms")) {
-        int deadline_ms = call_opts["deadline_ms"];
-        auto deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(deadline_ms);
-        context->set_deadline(deadline);
-    }
-
-    // Set metadata if specified
-    if (call_opts.has("metadata")) {
-        godot::Dictionary metadata = call_opts["metadata"];
-        godot::Array keys = metadata.keys();
-        for (int i = 0; i < keys.size(); ++i) {
-            godot::String key = keys[i];
-            godot::String value = metadata[key];
-            context->AddMetadata(key.utf8().get_data(), value.utf8().get_data());
+void GrpcClient::reset_alloc_stats() {
+    alloc::reset();
+}
+
+const CallOptions* GrpcClient::resolve_call_options(const godot::Variant& call_opts, CallOptions* scratch) {
+    switch (call_opts.get_type()) {
+        case godot::Variant::NIL:
+            return scratch;
+        case godot::Variant::OBJECT: {
+            GrpcCallOptions* prepared = godot::Object::cast_to<GrpcCallOptions>(static_cast<godot::Object*>(call_opts));
+            if (prepared) {
+                return &prepared->native();
+            }
+            break;
+        }
+        case godot::Variant::DICTIONARY: {
+            std::string error;
+            if (!CallOptions::parse(call_opts, scratch, &error)) {
+                Logger::error("Invalid call options: " + error);
+                godot::UtilityFunctions::push_error(("GrpcClient: invalid call options: " + error).c_str());
+                return nullptr;
+            }
+            return scratch;
         }
+        default:
+            break;
+    }
+    Logger::error("call_opts must be a Dictionary or GrpcCallOptions");
+    godot::UtilityFunctions::push_error("GrpcClient: call_opts must be a Dictionary or GrpcCallOptions");
+    return nullptr;
+}
+
+std::unique_ptr<grpc::ClientContext> GrpcClient::create_context(const CallOptions& options) {
+    auto context = std::make_unique<grpc::ClientContext>();
+
+    std::shared_ptr<grpc::CallCredentials> call_credentials;
+    {
+        std::lock_guard<std::mutex> lock(credentials_mutex_);
+        call_credentials = call_credentials_;
+    }
+    if (call_credentials) {
+        context->set_credentials(call_credentials);
     }
 
+    options.apply(*context);
     return context;
 }
 
@@ -334,6 +1128,25 @@ ChannelOptions GrpcClient::parse_channel_options(const godot::Dictionary& option
         opts.authority = authority.utf8().get_data();
     }
 
+    if (options.has("root_certs_pem")) {
+        godot::String pem = options["root_certs_pem"];
+        opts.root_certs_pem = pem.utf8().get_data();
+    }
+
+    if (options.has("client_cert_pem")) {
+        godot::String pem = options["client_cert_pem"];
+        opts.client_cert_pem = pem.utf8().get_data();
+    }
+
+    if (options.has("client_key_pem")) {
+        godot::String pem = options["client_key_pem"];
+        opts.client_key_pem = pem.utf8().get_data();
+    }
+
+    if (options.has("tls_session_resumption")) {
+        opts.tls_session_resumption = options["tls_session_resumption"];
+    }
+
     if (options.has("max_send_message_length")) {
         opts.max_send_message_length = options["max_send_message_length"];
     }
@@ -345,35 +1158,153 @@ ChannelOptions GrpcClient::parse_channel_options(const godot::Dictionary& option
     return opts;
 }
 
-void GrpcClient::on_stream_message(int stream_id, const godot::PackedByteArray& data) {
-    Logger::trace("Stream " + std::to_string(stream_id) + " message callback");
+StreamRawMessageHandler GrpcClient::create_columnar_handler(const godot::Dictionary& spec) {
+    godot::Ref<GrpcSchema> schema = spec.get("schema", godot::Variant());
+    if (schema.is_null()) {
+        Logger::error("columnar option requires a GrpcSchema in 'schema'");
+        return nullptr;
+    }
+
+    std::string message_type = godot::String(spec.get("message_type", "")).utf8().get_data();
+    std::string field = godot::String(spec.get("field", "")).utf8().get_data();
+    auto decoder = std::make_shared<ColumnarDecoder>();
+    if (!decoder->init(schema->snapshot(), message_type, field)) {
+        return nullptr;
+    }
+
+    // The decoder keeps the schema snapshot (and so its plans) alive for the
+    // stream's lifetime, even if the GrpcSchema is reloaded meanwhile
+    return [this, decoder](GrpcStream& stream, const grpc::ByteBuffer& buffer) {
+        int64_t stream_id = stream.get_id();
+        godot::Dictionary columns;
+        if (decoder->decode(buffer, columns)) {
+            call_deferred("emit_signal", "columns", stream_id, columns);
+        } else {
+            Logger::error("Stream " + std::to_string(stream_id) + " received a message that failed columnar decode");
+        }
+        return true;
+    };
+}
+
+StreamRawMessageHandler GrpcClient::create_delta_handler(
+    const godot::Dictionary& spec,
+    StreamType stream_type,
+    const godot::Ref<GrpcSnapshotBuffer>& snapshot_buffer
+) {
+    int max_baselines = spec.get("baselines", 8);
+    bool ack = static_cast<bool>(spec.get("ack", true)) && stream_type == StreamType::BIDIRECTIONAL;
+
+    struct DeltaState {
+        explicit DeltaState(size_t max_baselines) : decoder(max_baselines) {}
+        DeltaDecoder decoder;
+        bool keyframe_requested = false;
+    };
+    auto state = std::make_shared<DeltaState>(static_cast<size_t>(max_baselines > 0 ? max_baselines : 1));
+
+    return [this, state, ack, snapshot_buffer](GrpcStream& stream, const grpc::ByteBuffer& buffer) {
+        int64_t stream_id = stream.get_id();
+        godot::PackedByteArray payload;
+        uint64_t sequence = 0;
+        switch (state->decoder.decode(buffer, payload, &sequence)) {
+            case DeltaDecoder::APPLIED:
+                state->keyframe_requested = false;
+                if (ack) {
+                    stream.send(DeltaDecoder::make_ack(sequence, false));
+                }
+                if (snapshot_buffer.is_valid()) {
+                    snapshot_buffer->push(payload);
+                } else {
+                    call_deferred("emit_signal", "message", stream_id, payload);
+                }
+                break;
+            case DeltaDecoder::NEED_KEYFRAME:
+                // Ask once; frames keep arriving against the lost baseline until the server reacts
+                Logger::warn("Stream " + std::to_string(stream_id) + " delta frame " + std::to_string(sequence) +
+                             " references an unknown baseline");
+                if (ack && !state->keyframe_requested) {
+                    stream.send(DeltaDecoder::make_ack(sequence, true));
+                    state->keyframe_requested = true;
+                }
+                break;
+            case DeltaDecoder::MALFORMED:
+                Logger::error("Stream " + std::to_string(stream_id) + " received a malformed delta frame");
+                break;
+        }
+        return true;
+    };
+}
+
+void GrpcClient::release_streams(std::vector<std::unique_ptr<GrpcStream>>& streams) {
+    for (auto& stream : streams) {
+        if (stream->on_stream_thread()) {
+            streams_.park(std::move(stream));
+        }
+    }
+    streams.clear();
+}
+
+bool GrpcClient::resolve_method(const godot::Variant& full_method, methods::Resolved* out) {
+    switch (full_method.get_type()) {
+        case godot::Variant::INT: {
+            methods::Method* method = methods_.find(static_cast<int>(full_method));
+            if (method) {
+                out->name = &method->name;
+                out->stats = &method->stats;
+                return true;
+            }
+            Logger::error("Unknown method handle " + std::to_string(static_cast<int64_t>(full_method)));
+            godot::UtilityFunctions::push_error("GrpcClient: unknown method handle");
+            return false;
+        }
+        case godot::Variant::STRING:
+        case godot::Variant::STRING_NAME: {
+            godot::String name = full_method;
+            std::string utf8 = name.utf8().get_data();
+            if (methods_.resolve(utf8, out)) {
+                return true;
+            }
+            Logger::error("Method name must be \"/package.Service/Method\", got \"" + utf8 + "\"");
+            godot::UtilityFunctions::push_error("GrpcClient: malformed method name");
+            return false;
+        }
+        default:
+            break;
+    }
+    Logger::error("full_method must be a String or a prepare_method() handle");
+    godot::UtilityFunctions::push_error("GrpcClient: full_method must be a String or a prepare_method() handle");
+    return false;
+}
+
+void GrpcClient::reap_finished_streams() {
+    std::vector<std::unique_ptr<GrpcStream>> streams = streams_.take_finished();
+    release_streams(streams);
+}
+
+void GrpcClient::on_stream_message(int64_t stream_id, const godot::PackedByteArray& data) {
+    if (Logger::enabled(LogLevel::TRACE)) {
+        Logger::trace("Stream " + std::to_string(stream_id) + " message callback");
+    }
 
     // Emit signal via call_deferred to ensure we're on the main thread
     call_deferred("emit_signal", "message", stream_id, data);
 }
 
-void GrpcClient::on_stream_finished(int stream_id, int status_code, const std::string& message) {
+void GrpcClient::on_stream_finished(int64_t stream_id, int status_code, const std::string& message) {
     Logger::trace("Stream " + std::to_string(stream_id) + " finished callback");
 
-    // Clean up the stream
-    {
-        std::lock_guard<std::mutex> lock(streams_mutex_);
-        active_streams_.erase(stream_id);
-    }
+    // Retire the stream; this is its own reader thread, so it cannot be destroyed here
+    streams_.retire(stream_id);
 
     // Emit signal via call_deferred
     godot::String msg(message.c_str());
     call_deferred("emit_signal", "finished", stream_id, status_code, msg);
 }
 
-void GrpcClient::on_stream_error(int stream_id, int status_code, const std::string& message) {
+void GrpcClient::on_stream_error(int64_t stream_id, int status_code, const std::string& message) {
     Logger::trace("Stream " + std::to_string(stream_id) + " error callback");
 
-    // Clean up the stream
-    {
-        std::lock_guard<std::mutex> lock(streams_mutex_);
-        active_streams_.erase(stream_id);
-    }
+    // Retire the stream; this is its own reader thread, so it cannot be destroyed here
+    streams_.retire(stream_id);
 
     // Emit signal via call_deferred
     godot::String msg(message.c_str());
@@ -5,11 +5,23 @@
 #include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/string.hpp>
+#include "grpc_call_options.h"
 #include "grpc_channel_pool.h"
 #include "grpc_stream.h"
+#include "grpc_stream_table.h"
+#include "grpc_recorder.h"
+#include "grpc_schema.h"
+#include "grpc_snapshot_buffer.h"
+#include "util/call_credentials.h"
+#include "util/method_table.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <map>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace godot_grpc {
 
@@ -39,6 +51,9 @@ public:
      *   - keepalive_seconds (int): Keepalive interval in seconds
      *   - enable_tls (bool): Enable TLS encryption
      *   - authority (String): Custom authority header
+     *   - root_certs_pem (String): Trusted CA certificates instead of the system roots
+     *   - client_cert_pem, client_key_pem (String): Client certificate and key for mutual TLS
+     *   - tls_session_resumption (bool): Resume TLS sessions on reconnect (default true)
      *   - max_send_message_length (int): Max send message size in bytes
      *   - max_receive_message_length (int): Max receive message size in bytes
      * @return true if connection was successful
@@ -46,47 +61,138 @@ public:
     bool connect(const godot::String& endpoint, const godot::Dictionary& options = godot::Dictionary());
 
     /**
-     * Close the connection and cancel all in-flight calls.
+     * Close the connection and cancel all in-flight calls. Blocks until every
+     * stream's threads have exited; see close_async() for many streams.
      */
     void close();
 
+    /**
+     * Close the connection without blocking. Streams are taken off the client
+     * and the channel released at once, so connect() may follow immediately;
+     * the streams are cancelled and their threads joined on a background
+     * thread, which keeps the client alive until `closed` is emitted.
+     *
+     * @param drain_ms Give client and bidirectional streams up to this long
+     *   to write the messages already queued (followed by WritesDone) before
+     *   they are cancelled; 0 cancels at once
+     */
+    void close_async(int drain_ms = 0);
+
     /**
      * Check if the client is connected.
      */
     bool is_connected() const;
 
+    // Call credentials
+    /**
+     * Attach a bearer token to every call made from now on, cached natively
+     * and refreshed on a background thread before it expires. Replaces any
+     * previous call credentials.
+     *
+     * @param options Dictionary with optional keys:
+     *   - token (String), expires_in_s (float): Initial token and its lifetime (0 = never expires)
+     *   - header (String): Metadata key (default "authorization")
+     *   - prefix (String): Prepended to the token (default "Bearer ")
+     *   - refresh_margin_s (float): Refresh this long before expiry (default 60)
+     *   - refresh_callable (Callable): Called on the main thread when a new token
+     *     is due; answer with set_call_token()
+     *   - refresh_method (String): Or refresh with this unary call, made natively
+     *   - refresh_request (PackedByteArray): Its request message
+     *   - token_field (int), expires_in_field (int): Response fields holding the
+     *     token (string, default 1) and its lifetime in seconds (varint, default 2)
+     *   - refresh_timeout_ms (int): Deadline of the refresh call (default 10000)
+     *   - allow_insecure (bool): Also send the token over plaintext channels
+     * @return false if the options are inconsistent
+     */
+    bool set_call_credentials(const godot::Dictionary& options);
+
+    /**
+     * Replace the cached token, e.g. from a refresh_callable.
+     *
+     * @param token New token
+     * @param expires_in_s Lifetime in seconds (0 = never expires)
+     */
+    void set_call_token(const godot::String& token, double expires_in_s = 0.0);
+
+    /**
+     * Stop attaching the token and stop refreshing it.
+     */
+    void clear_call_credentials();
+
+    // Prepared methods
+    /**
+     * Intern a method name for calls made with it from now on.
+     *
+     * Every call method below takes the handle in place of the name; the
+     * name is then neither converted nor looked up per call. Methods passed
+     * by name are interned on first use, so preparing is optional and
+     * get_method_stats() covers them too. A client interns at most 1024
+     * methods; calls by other names after that are counted as "(untracked)".
+     *
+     * @param full_method Method name in format "/package.Service/Method"
+     * @return Handle (positive integer, the same for the same name), or -1
+     *   if the name is malformed or the method table is full
+     */
+    int prepare_method(const godot::String& full_method);
+
+    /**
+     * Per-method counters, keyed by method name: { calls, errors,
+     * messages_sent, messages_received, bytes_sent, bytes_received,
+     * avg_latency_ms, max_latency_ms }. Latencies cover unary calls only.
+     * Calls by name made once the method table was full are summed under
+     * "(untracked)".
+     */
+    godot::Dictionary get_method_stats() const;
+
+    /**
+     * Zero the per-method counters. Handles stay valid.
+     */
+    void reset_method_stats();
+
     // Unary RPC
     /**
      * Make a unary RPC call.
      *
-     * @param full_method Method name in format "/package.Service/Method"
+     * @param full_method Method name in format "/package.Service/Method", or a
+     *   handle from prepare_method()
      * @param request_bytes Serialized request message
-     * @param call_opts Dictionary with optional keys:
+     * @param call_opts GrpcCallOptions, or a Dictionary with optional keys:
      *   - deadline_ms (int): Deadline in milliseconds from now
      *   - metadata (Dictionary): Custom metadata key-value pairs
+     *   - compression (String): "gzip", "deflate" or "none"
+     *   - call_options (GrpcCallOptions): Base for the keys above
      * @return Serialized response message bytes, or empty array on error
      */
     godot::PackedByteArray unary(
-        const godot::String& full_method,
+        const godot::Variant& full_method,
         const godot::PackedByteArray& request_bytes,
-        const godot::Dictionary& call_opts = godot::Dictionary()
+        const godot::Variant& call_opts = godot::Variant()
     );
 
     // Server-streaming RPC
     /**
      * Start a server-streaming RPC call.
      *
-     * @param full_method Method name in format "/package.Service/Method"
+     * @param full_method Method name in format "/package.Service/Method", or a
+     *   handle from prepare_method()
      * @param request_bytes Serialized request message
-     * @param call_opts Dictionary with optional keys:
-     *   - deadline_ms (int): Deadline in milliseconds from now
-     *   - metadata (Dictionary): Custom metadata key-value pairs
-     * @return Stream ID (positive integer) on success, -1 on error
+     * @param call_opts GrpcCallOptions, or a Dictionary with the keys of
+     * unary() and:
+     *   - columnar (Dictionary): Decode each message on the reader thread
+     *     and emit `columns` instead of `message`. Keys: schema (GrpcSchema),
+     *     message_type (String), field (String, a repeated message field).
+     *     See GrpcSchema::decode_columns().
+     *   - snapshot_buffer (GrpcSnapshotBuffer): Push each message into the
+     *     buffer on the reader thread instead of emitting `message`.
+     *   - delta (Dictionary): Messages are DeltaFrames (see grpc_delta.h);
+     *     emit the reconstructed payloads. Keys: baselines (int, default 8),
+     *     ack (bool, default true; bidirectional streams only).
+     * @return Stream ID (positive integer, unique across clients) on success, -1 on error
      */
-    int server_stream_start(
-        const godot::String& full_method,
+    int64_t server_stream_start(
+        const godot::Variant& full_method,
         const godot::PackedByteArray& request_bytes,
-        const godot::Dictionary& call_opts = godot::Dictionary()
+        const godot::Variant& call_opts = godot::Variant()
     );
 
     /**
@@ -94,36 +200,38 @@ public:
      *
      * @param stream_id Stream ID returned from server_stream_start
      */
-    void server_stream_cancel(int stream_id);
+    void server_stream_cancel(int64_t stream_id);
 
     // Client-streaming RPC
     /**
      * Start a client-streaming RPC call.
      *
-     * @param full_method Method name in format "/package.Service/Method"
-     * @param call_opts Dictionary with optional keys:
-     *   - deadline_ms (int): Deadline in milliseconds from now
-     *   - metadata (Dictionary): Custom metadata key-value pairs
-     * @return Stream ID (positive integer) on success, -1 on error
+     * @param full_method Method name in format "/package.Service/Method", or a
+     *   handle from prepare_method()
+     * @param call_opts Same as unary()
+     * @return Stream ID (positive integer, unique across clients) on success, -1 on error
      */
-    int client_stream_start(
-        const godot::String& full_method,
-        const godot::Dictionary& call_opts = godot::Dictionary()
+    int64_t client_stream_start(
+        const godot::Variant& full_method,
+        const godot::Variant& call_opts = godot::Variant()
     );
 
     // Bidirectional streaming RPC
     /**
      * Start a bidirectional streaming RPC call.
      *
-     * @param full_method Method name in format "/package.Service/Method"
-     * @param call_opts Dictionary with optional keys:
-     *   - deadline_ms (int): Deadline in milliseconds from now
-     *   - metadata (Dictionary): Custom metadata key-value pairs
-     * @return Stream ID (positive integer) on success, -1 on error
+     * @param full_method Method name in format "/package.Service/Method", or a
+     *   handle from prepare_method()
+     * @param call_opts GrpcCallOptions, or a Dictionary with the keys of
+     * unary() and:
+     *   - columnar, snapshot_buffer: As for server_stream_start
+     *   - delta (Dictionary): As for server_stream_start; each reconstructed
+     *     payload is acknowledged on the stream with a DeltaAck
+     * @return Stream ID (positive integer, unique across clients) on success, -1 on error
      */
-    int bidi_stream_start(
-        const godot::String& full_method,
-        const godot::Dictionary& call_opts = godot::Dictionary()
+    int64_t bidi_stream_start(
+        const godot::Variant& full_method,
+        const godot::Variant& call_opts = godot::Variant()
     );
 
     // Stream management (for client and bidirectional streams)
@@ -134,7 +242,7 @@ public:
      * @param message_bytes Serialized message to send
      * @return true if message was queued successfully, false otherwise
      */
-    bool stream_send(int stream_id, const godot::PackedByteArray& message_bytes);
+    bool stream_send(int64_t stream_id, const godot::PackedByteArray& message_bytes);
 
     /**
      * Close the send side of a stream (signal no more writes).
@@ -142,14 +250,101 @@ public:
      *
      * @param stream_id Stream ID to close send on
      */
-    void stream_close_send(int stream_id);
+    void stream_close_send(int64_t stream_id);
 
     /**
      * Cancel any active stream.
      *
      * @param stream_id Stream ID to cancel
      */
-    void stream_cancel(int stream_id);
+    void stream_cancel(int64_t stream_id);
+
+    // JSON transcoding
+    /**
+     * Make a unary RPC call with JSON request and response bodies.
+     *
+     * The JSON is converted with the descriptors of `schema` (see
+     * GrpcSchema::load_descriptor_set_file), sent as a regular binary call and
+     * the response converted back, all on a background I/O thread. The result
+     * arrives through the `json_response` signal; field names in the response
+     * are the proto field names. Intended for consoles and tooling rather than
+     * per-frame traffic.
+     *
+     * @param full_method Method name in format "/package.Service/Method", or a
+     *   handle from prepare_method()
+     * @param json Request message as protobuf JSON
+     * @param call_opts Same keys as unary()
+     * @return Request ID (positive integer) matched by `json_response`, or -1 on error
+     */
+    int unary_json(
+        const godot::Variant& full_method,
+        const godot::String& json,
+        const godot::Variant& call_opts = godot::Variant()
+    );
+
+    /**
+     * Schema used by unary_json().
+     */
+    void set_schema(const godot::Ref<GrpcSchema>& schema);
+    godot::Ref<GrpcSchema> get_schema() const;
+
+    // Schema discovery
+    /**
+     * Fetch the schema of a service through gRPC server reflection.
+     *
+     * Looks in the in-memory cache, then in the on-disk cache under
+     * user://grpc_schema_cache/, and only then queries the server's
+     * grpc.reflection.v1alpha.ServerReflection service. Fetched descriptors
+     * are written to both caches.
+     *
+     * @param service Fully-qualified service name (e.g. "helloworld.Greeter")
+     * @param refresh Bypass both caches and query the server
+     * @return Schema covering the service and its imports, or null on error
+     */
+    godot::Ref<GrpcSchema> fetch_schema(const godot::String& service, bool refresh = false);
+
+    // Recording and replay
+    /**
+     * Recorder that captures this client's traffic while it is recording.
+     * Only calls started after recording begins are captured.
+     */
+    void set_recorder(const godot::Ref<GrpcRecorder>& recorder);
+    godot::Ref<GrpcRecorder> get_recorder() const;
+
+    /**
+     * Feed the stream messages of a recorded log back through the `message`,
+     * `finished` and `error` signals, without a server.
+     *
+     * Each recorded stream gets a fresh stream ID, announced by
+     * `replay_stream_started` before its first message. Unary calls and sent
+     * messages are skipped. Messages are delivered from a background thread
+     * exactly like live ones, so handlers see the same deferred calls.
+     *
+     * @param path Log written by GrpcRecorder
+     * @param speed 1.0 for the original timing, 2.0 for twice as fast, 0 for
+     *   as fast as possible
+     * @return false if the log cannot be read
+     */
+    bool replay_start(const godot::String& path, double speed = 1.0);
+
+    /**
+     * Stop a running replay. Messages already queued are still delivered.
+     */
+    void replay_stop();
+
+    bool is_replaying() const;
+
+    // Native API
+    /**
+     * Start a bidirectional stream whose received messages all go to
+     * `handler` on the reader thread (used by GrpcMux). Call options that
+     * install their own handler (columnar, snapshot_buffer, delta) are ignored.
+     */
+    int64_t bidi_stream_start_with_handler(
+        const godot::Variant& full_method,
+        const godot::Variant& call_opts,
+        StreamRawMessageHandler handler
+    );
 
     // Logging
     /**
@@ -164,36 +359,144 @@ public:
      */
     int get_log_level() const;
 
+    // Allocation profiling
+    /**
+     * Heap allocations per hot-path operation, shared by all clients:
+     * { "unary_call": { operations, allocations, bytes, allocations_per_op,
+     * bytes_per_op }, "stream_receive": {...}, "stream_send": {...} }.
+     * Empty unless built with -DGODOT_GRPC_ALLOC_STATS=ON.
+     */
+    godot::Dictionary get_alloc_stats() const;
+
+    /**
+     * Zero the allocation counters, e.g. before a benchmark run.
+     */
+    void reset_alloc_stats();
+
 protected:
     static void _bind_methods();
 
 private:
-    // Helper to parse call options
-    std::unique_ptr<grpc::ClientContext> create_context(const godot::Dictionary& call_opts);
+    // Context options of call_opts (a GrpcCallOptions or Dictionary); a
+    // Dictionary is parsed into `scratch`. Logs and returns nullptr if invalid.
+    const CallOptions* resolve_call_options(const godot::Variant& call_opts, CallOptions* scratch);
+
+    // Name and counters for a method name or prepare_method() handle,
+    // interning names on first use. Logs and returns false if invalid.
+    bool resolve_method(const godot::Variant& full_method, methods::Resolved* out);
+
+    // Helper to build a call's context
+    std::unique_ptr<grpc::ClientContext> create_context(const CallOptions& options);
+
+    // Drop queued JSON calls, cancel the one in flight and close the channel
+    void release_channel();
 
     // Helper to parse channel options
     ChannelOptions parse_channel_options(const godot::Dictionary& options);
 
+    // Stub for native token refreshes (called from the refresh thread)
+    std::shared_ptr<grpc::GenericStub> get_auth_stub();
+
     // Helper to start a stream of a specific type
-    int start_stream(
+    int64_t start_stream(
         StreamType stream_type,
-        const godot::String& full_method,
+        const methods::Resolved& method,
         const godot::PackedByteArray& request_bytes,
-        const godot::Dictionary& call_opts
+        const godot::Variant& call_opts,
+        StreamRawMessageHandler native_handler = nullptr
+    );
+
+    // Build a reader-thread handler for the "columnar" call option
+    StreamRawMessageHandler create_columnar_handler(const godot::Dictionary& spec);
+
+    // Build a reader-thread handler for the "delta" call option
+    StreamRawMessageHandler create_delta_handler(
+        const godot::Dictionary& spec,
+        StreamType stream_type,
+        const godot::Ref<GrpcSnapshotBuffer>& snapshot_buffer
     );
 
+    // Replay thread body
+    void replay_loop(std::shared_ptr<traffic::Reader> reader, double speed);
+
+    // Main thread (deferred): emit `closed` and drop close_async()'s reference
+    void _finish_close_async();
+
+    // Destroy streams taken out of streams_; any the calling thread belongs
+    // to are parked in it instead
+    void release_streams(std::vector<std::unique_ptr<GrpcStream>>& streams);
+    void reap_finished_streams();
+
     // Stream callbacks (called from background threads)
-    void on_stream_message(int stream_id, const godot::PackedByteArray& data);
-    void on_stream_finished(int stream_id, int status_code, const std::string& message);
-    void on_stream_error(int stream_id, int status_code, const std::string& message);
+    void on_stream_message(int64_t stream_id, const godot::PackedByteArray& data);
+    void on_stream_finished(int64_t stream_id, int status_code, const std::string& message);
+    void on_stream_error(int64_t stream_id, int status_code, const std::string& message);
+
+    // JSON worker (runs unary_json calls off the main thread)
+    struct JsonCall {
+        int request_id;
+        std::string method;
+        std::string json;
+        // Snapshot taken when queued, so a reload cannot free its descriptors mid-call
+        std::shared_ptr<const LoadedSchema> schema;
+        std::shared_ptr<grpc::GenericStub> stub;
+        std::unique_ptr<grpc::ClientContext> context;
+        std::shared_ptr<traffic::Writer> traffic_log;
+        traffic::Metadata metadata;
+        methods::Stats* stats;
+    };
+    void json_worker_loop();
+    void run_json_call(JsonCall& call);
+    void stop_json_worker();
+
+    // Schema cache helpers
+    std::string schema_cache_path(const std::string& service) const;
 
     // Channel management
     GrpcChannelPool channel_pool_;
 
-    // Active streams
-    std::mutex streams_mutex_;
-    std::map<int, std::unique_ptr<GrpcStream>> active_streams_;
-    int next_stream_id_;
+    // Methods called so far. Declared before the streams and JSON calls,
+    // which count into its entries, so it outlives them.
+    methods::Table methods_;
+
+    // Schemas fetched via reflection, keyed by endpoint and service
+    std::mutex schema_cache_mutex_;
+    std::map<std::string, godot::Ref<GrpcSchema>> schema_cache_;
+
+    // Active streams, and finished ones until the next reap_finished_streams()
+    StreamTable streams_;
+
+    // close_async() teardowns that finished and still hold their reference,
+    // so a stray _finish_close_async() call cannot release one it lacks
+    std::atomic<int> finished_closes_{0};
+
+    // unary_json() state
+    godot::Ref<GrpcSchema> schema_;
+    std::thread json_thread_;
+    std::mutex json_mutex_;
+    std::condition_variable json_cv_;
+    std::deque<JsonCall> json_queue_;
+    grpc::ClientContext* json_active_context_ = nullptr;
+    bool json_stop_ = false;
+    int next_json_request_id_ = 1;
+
+    // Call credentials, applied to each context by create_context() and
+    // swapped under credentials_mutex_. The refresh thread reads the stub
+    // through auth_stub_mutex_, as the channel pool is only used from the
+    // main thread.
+    std::mutex credentials_mutex_;
+    std::shared_ptr<auth::TokenCache> token_cache_;
+    std::shared_ptr<grpc::CallCredentials> call_credentials_;
+    std::mutex auth_stub_mutex_;
+    std::shared_ptr<grpc::GenericStub> auth_stub_;
+
+    // Recording and replay
+    godot::Ref<GrpcRecorder> recorder_;
+    std::thread replay_thread_;
+    std::mutex replay_mutex_;
+    std::condition_variable replay_cv_;
+    bool replay_stop_ = false;
+    std::atomic<bool> replaying_{false};
 };
 
 } // namespace godot_grpc
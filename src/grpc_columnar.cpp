@@ -0,0 +1,447 @@
+#include "grpc_columnar.h"
+#include "grpc_schema.h"
+#include "util/status_map.h"
+#include "util/varint_decode.h"
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <grpcpp/support/slice.h>
+#include <cstring>
+
+namespace godot_grpc {
+
+using google::protobuf::FieldDescriptor;
+
+namespace {
+
+// Typed storage for one column while a message is being decoded
+struct ColumnData {
+    godot::PackedInt64Array ints;
+    godot::PackedFloat32Array floats;
+    godot::PackedFloat64Array doubles;
+    godot::PackedStringArray strings;
+    int64_t* int_ptr = nullptr;
+    float* float_ptr = nullptr;
+    double* double_ptr = nullptr;
+    godot::String* string_ptr = nullptr;
+
+    // Repeated fields: every entity's values, and where each entity starts
+    std::vector<int64_t> int_values;
+    std::vector<float> float_values;
+    std::vector<double> double_values;
+    godot::PackedInt64Array offsets;
+    int64_t* offset_ptr = nullptr;
+
+    int64_t value_count() const {
+        return static_cast<int64_t>(int_values.size() + float_values.size() + double_values.size()) + strings.size();
+    }
+};
+
+godot::Variant scalar_default(const FieldDescriptor* fd) {
+    switch (fd->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_INT32: return static_cast<int64_t>(fd->default_value_int32());
+        case FieldDescriptor::CPPTYPE_INT64: return fd->default_value_int64();
+        case FieldDescriptor::CPPTYPE_UINT32: return static_cast<int64_t>(fd->default_value_uint32());
+        case FieldDescriptor::CPPTYPE_UINT64: return static_cast<int64_t>(fd->default_value_uint64());
+        case FieldDescriptor::CPPTYPE_DOUBLE: return fd->default_value_double();
+        case FieldDescriptor::CPPTYPE_FLOAT: return static_cast<double>(fd->default_value_float());
+        case FieldDescriptor::CPPTYPE_BOOL: return static_cast<int64_t>(fd->default_value_bool());
+        case FieldDescriptor::CPPTYPE_ENUM: return static_cast<int64_t>(fd->default_value_enum()->number());
+        case FieldDescriptor::CPPTYPE_STRING: {
+            const std::string& value = fd->default_value_string();
+            return godot::String::utf8(value.data(), static_cast<int64_t>(value.size()));
+        }
+        default:
+            return godot::Variant();
+    }
+}
+
+bool is_column_kind(DecodePlan::Kind kind) {
+    return kind != DecodePlan::KIND_BYTES && kind != DecodePlan::KIND_MESSAGE &&
+           kind != DecodePlan::KIND_MAP && kind != DecodePlan::KIND_UNSUPPORTED;
+}
+
+bool read_length(const uint8_t* data, size_t size, size_t* pos, size_t* out_length) {
+    uint64_t length;
+    if (!wire::decode_varint(data, size, pos, &length) || length > size - *pos) {
+        return false;
+    }
+    *out_length = static_cast<size_t>(length);
+    return true;
+}
+
+// Append a run of numeric values (a packed field, or one unpacked value)
+// whose elements have wire type `wire_type`.
+bool append_run(DecodePlan::Kind kind, uint32_t wire_type, const uint8_t* run, size_t size, ColumnData& target) {
+    if (wire_type == wire::VARINT) {
+        size_t count;
+        if (!wire::count_varints(run, size, &count)) {
+            return false;
+        }
+        size_t base = target.int_values.size();
+        target.int_values.resize(base + count);
+        int64_t* out = target.int_values.data() + base;
+        if (count > 0 && !wire::decode_varints(run, size, reinterpret_cast<uint64_t*>(out), count)) {
+            return false;
+        }
+        if (kind == DecodePlan::KIND_BOOL) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = out[i] != 0;
+            }
+        } else if (kind != DecodePlan::KIND_INT64 && kind != DecodePlan::KIND_UINT64) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = DecodePlan::varint_value(kind, static_cast<uint64_t>(out[i]));
+            }
+        }
+        return true;
+    }
+
+    size_t width = wire_type == wire::FIXED32 ? 4 : 8;
+    if (size % width != 0) {
+        return false;
+    }
+    size_t count = size / width;
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* value = run + i * width;
+        switch (kind) {
+            case DecodePlan::KIND_FLOAT:
+                target.float_values.push_back(wire::bits_to_float(wire::load_fixed32(value)));
+                break;
+            case DecodePlan::KIND_DOUBLE:
+                target.double_values.push_back(wire::bits_to_double(wire::load_fixed64(value)));
+                break;
+            default:
+                target.int_values.push_back(width == 4 ? DecodePlan::fixed32_value(kind, wire::load_fixed32(value))
+                                                       : static_cast<int64_t>(wire::load_fixed64(value)));
+                break;
+        }
+    }
+    return true;
+}
+
+// Read one value of a repeated column; `wire_type` is as found on the wire
+bool read_repeated(DecodePlan::Kind kind, uint32_t element_wire_type, uint32_t wire_type,
+                   const uint8_t* data, size_t size, size_t* pos, ColumnData& target) {
+    if (kind == DecodePlan::KIND_STRING) {
+        size_t length;
+        if (!read_length(data, size, pos, &length)) {
+            return false;
+        }
+        target.strings.push_back(godot::String::utf8(reinterpret_cast<const char*>(data + *pos), static_cast<int64_t>(length)));
+        *pos += length;
+        return true;
+    }
+
+    size_t start = *pos;
+    size_t length;
+    if (wire_type == wire::LENGTH_DELIMITED) {
+        if (!read_length(data, size, pos, &length)) {
+            return false;
+        }
+        start = *pos;
+    } else if (wire_type == wire::VARINT) {
+        uint64_t ignored;
+        if (!wire::decode_varint(data, size, pos, &ignored)) {
+            return false;
+        }
+        length = *pos - start;
+        *pos = start;
+    } else {
+        length = wire_type == wire::FIXED32 ? 4 : 8;
+        if (size - *pos < length) {
+            return false;
+        }
+    }
+    *pos += length;
+    return append_run(kind, element_wire_type, data + start, length, target);
+}
+
+} // namespace
+
+bool ColumnarDecoder::init(std::shared_ptr<const LoadedSchema> schema, const std::string& message_type, const std::string& field) {
+    schema_.reset();
+    element_ = nullptr;
+    columns_.clear();
+    entry_to_column_.clear();
+    repeated_columns_.clear();
+
+    const DecodePlan* plan = schema ? schema->find_plan(message_type) : nullptr;
+    if (!plan) {
+        Logger::error("Columnar decode: unknown message type " + message_type);
+        return false;
+    }
+
+    const FieldDescriptor* fd = plan->descriptor->FindFieldByName(field);
+    if (!fd || !fd->is_repeated() || fd->is_map() || fd->type() != FieldDescriptor::TYPE_MESSAGE) {
+        Logger::error("Columnar decode: " + plan->descriptor->full_name() + "." + field +
+                      " is not a repeated message field");
+        return false;
+    }
+
+    schema_ = std::move(schema);
+    field_number_ = static_cast<uint32_t>(fd->number());
+    element_ = plan->entries[plan->find_entry(field_number_)].message;
+
+    entry_to_column_.assign(element_->entries.size(), -1);
+    for (size_t i = 0; i < element_->entries.size(); ++i) {
+        const DecodePlan::Entry& entry = element_->entries[i];
+        if (!is_column_kind(entry.kind)) {
+            continue;
+        }
+        entry_to_column_[i] = static_cast<int>(columns_.size());
+        if (entry.repeated) {
+            repeated_columns_.push_back(static_cast<int>(columns_.size()));
+        }
+        godot::Variant default_value = entry.repeated ? godot::Variant() : scalar_default(element_->descriptor->field(static_cast<int>(i)));
+        columns_.push_back(Column{ entry.kind, entry.wire_type, entry.repeated, entry.key, default_value });
+    }
+    return true;
+}
+
+bool ColumnarDecoder::count_elements(const uint8_t* data, size_t size, size_t* out_count) const {
+    size_t count = 0;
+    size_t pos = 0;
+    while (pos < size) {
+        uint64_t tag;
+        if (!wire::decode_varint(data, size, &pos, &tag)) {
+            return false;
+        }
+        uint32_t field_number = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+        if (field_number == field_number_ && wire_type == wire::LENGTH_DELIMITED) {
+            ++count;
+        }
+        if (!wire::skip_field(data, size, &pos, wire_type, field_number)) {
+            return false;
+        }
+    }
+    *out_count = count;
+    return true;
+}
+
+bool ColumnarDecoder::decode(const uint8_t* data, size_t size, godot::Dictionary& out) const {
+    out.clear();
+    if (!element_) {
+        return false;
+    }
+
+    // First pass sizes every column once
+    size_t count;
+    if (!count_elements(data, size, &count)) {
+        return false;
+    }
+
+    std::vector<ColumnData> columns(columns_.size());
+    for (size_t c = 0; c < columns_.size(); ++c) {
+        const Column& column = columns_[c];
+        ColumnData& target = columns[c];
+        if (column.repeated) {
+            target.offsets.resize(static_cast<int64_t>(count) + 1);
+            target.offset_ptr = target.offsets.ptrw();
+            continue;
+        }
+        switch (column.kind) {
+            case DecodePlan::KIND_FLOAT:
+                target.floats.resize(static_cast<int64_t>(count));
+                target.floats.fill(static_cast<float>(static_cast<double>(column.default_value)));
+                target.float_ptr = target.floats.ptrw();
+                break;
+            case DecodePlan::KIND_DOUBLE:
+                target.doubles.resize(static_cast<int64_t>(count));
+                target.doubles.fill(static_cast<double>(column.default_value));
+                target.double_ptr = target.doubles.ptrw();
+                break;
+            case DecodePlan::KIND_STRING:
+                target.strings.resize(static_cast<int64_t>(count));
+                target.strings.fill(static_cast<godot::String>(column.default_value));
+                target.string_ptr = target.strings.ptrw();
+                break;
+            default:
+                target.ints.resize(static_cast<int64_t>(count));
+                target.ints.fill(static_cast<int64_t>(column.default_value));
+                target.int_ptr = target.ints.ptrw();
+                break;
+        }
+    }
+
+    // Second pass fills row `index` from each element
+    size_t index = 0;
+    size_t pos = 0;
+    while (pos < size) {
+        uint64_t tag;
+        if (!wire::decode_varint(data, size, &pos, &tag)) {
+            return false;
+        }
+        uint32_t field_number = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+        if (field_number != field_number_ || wire_type != wire::LENGTH_DELIMITED) {
+            if (!wire::skip_field(data, size, &pos, wire_type, field_number)) {
+                return false;
+            }
+            continue;
+        }
+
+        size_t length;
+        if (!read_length(data, size, &pos, &length)) {
+            return false;
+        }
+        const uint8_t* element = data + pos;
+        pos += length;
+
+        for (int c : repeated_columns_) {
+            columns[c].offset_ptr[index] = columns[c].value_count();
+        }
+
+        size_t element_pos = 0;
+        while (element_pos < length) {
+            if (!wire::decode_varint(element, length, &element_pos, &tag)) {
+                return false;
+            }
+            field_number = static_cast<uint32_t>(tag >> 3);
+            wire_type = static_cast<uint32_t>(tag & 0x7);
+
+            int entry_index = element_->find_entry(field_number);
+            int column_index = entry_index >= 0 ? entry_to_column_[entry_index] : -1;
+            const Column* column = column_index >= 0 ? &columns_[column_index] : nullptr;
+            // Repeated numeric fields may arrive packed or one value per tag
+            bool packed = column && column->repeated && wire_type == wire::LENGTH_DELIMITED &&
+                          column->kind != DecodePlan::KIND_STRING;
+            if (!column || (wire_type != column->wire_type && !packed)) {
+                if (!wire::skip_field(element, length, &element_pos, wire_type, field_number, 1)) {
+                    return false;
+                }
+                continue;
+            }
+
+            DecodePlan::Kind kind = column->kind;
+            ColumnData& target = columns[column_index];
+            if (column->repeated) {
+                if (!read_repeated(kind, column->wire_type, wire_type, element, length, &element_pos, target)) {
+                    return false;
+                }
+                continue;
+            }
+            switch (wire_type) {
+                case wire::VARINT: {
+                    uint64_t raw;
+                    if (!wire::decode_varint(element, length, &element_pos, &raw)) {
+                        return false;
+                    }
+                    target.int_ptr[index] = kind == DecodePlan::KIND_BOOL ? (raw != 0) : DecodePlan::varint_value(kind, raw);
+                    break;
+                }
+                case wire::FIXED32: {
+                    if (length - element_pos < 4) {
+                        return false;
+                    }
+                    uint32_t raw = wire::load_fixed32(element + element_pos);
+                    element_pos += 4;
+                    if (kind == DecodePlan::KIND_FLOAT) {
+                        target.float_ptr[index] = wire::bits_to_float(raw);
+                    } else {
+                        target.int_ptr[index] = DecodePlan::fixed32_value(kind, raw);
+                    }
+                    break;
+                }
+                case wire::FIXED64: {
+                    if (length - element_pos < 8) {
+                        return false;
+                    }
+                    uint64_t raw = wire::load_fixed64(element + element_pos);
+                    element_pos += 8;
+                    if (kind == DecodePlan::KIND_DOUBLE) {
+                        target.double_ptr[index] = wire::bits_to_double(raw);
+                    } else {
+                        target.int_ptr[index] = static_cast<int64_t>(raw);
+                    }
+                    break;
+                }
+                default: {
+                    size_t string_length;
+                    if (!read_length(element, length, &element_pos, &string_length)) {
+                        return false;
+                    }
+                    target.string_ptr[index] = godot::String::utf8(
+                        reinterpret_cast<const char*>(element + element_pos), static_cast<int64_t>(string_length));
+                    element_pos += string_length;
+                    break;
+                }
+            }
+        }
+        ++index;
+    }
+
+    for (int c : repeated_columns_) {
+        ColumnData& target = columns[c];
+        target.offset_ptr[count] = target.value_count();
+        godot::Dictionary ragged;
+        switch (columns_[c].kind) {
+            case DecodePlan::KIND_FLOAT: {
+                godot::PackedFloat32Array values;
+                values.resize(static_cast<int64_t>(target.float_values.size()));
+                if (!target.float_values.empty()) {
+                    memcpy(values.ptrw(), target.float_values.data(), target.float_values.size() * sizeof(float));
+                }
+                ragged["values"] = values;
+                break;
+            }
+            case DecodePlan::KIND_DOUBLE: {
+                godot::PackedFloat64Array values;
+                values.resize(static_cast<int64_t>(target.double_values.size()));
+                if (!target.double_values.empty()) {
+                    memcpy(values.ptrw(), target.double_values.data(), target.double_values.size() * sizeof(double));
+                }
+                ragged["values"] = values;
+                break;
+            }
+            case DecodePlan::KIND_STRING:
+                ragged["values"] = target.strings;
+                break;
+            default: {
+                godot::PackedInt64Array values;
+                values.resize(static_cast<int64_t>(target.int_values.size()));
+                if (!target.int_values.empty()) {
+                    memcpy(values.ptrw(), target.int_values.data(), target.int_values.size() * sizeof(int64_t));
+                }
+                ragged["values"] = values;
+                break;
+            }
+        }
+        ragged["offsets"] = target.offsets;
+        out[columns_[c].key] = ragged;
+    }
+
+    for (size_t c = 0; c < columns_.size(); ++c) {
+        if (columns_[c].repeated) {
+            continue;
+        }
+        switch (columns_[c].kind) {
+            case DecodePlan::KIND_FLOAT: out[columns_[c].key] = columns[c].floats; break;
+            case DecodePlan::KIND_DOUBLE: out[columns_[c].key] = columns[c].doubles; break;
+            case DecodePlan::KIND_STRING: out[columns_[c].key] = columns[c].strings; break;
+            default: out[columns_[c].key] = columns[c].ints; break;
+        }
+    }
+    return true;
+}
+
+bool ColumnarDecoder::decode(const grpc::ByteBuffer& buffer, godot::Dictionary& out) {
+    grpc::Slice slice;
+    if (buffer.TrySingleSlice(&slice).ok()) {
+        return decode(slice.begin(), slice.size(), out);
+    }
+
+    std::vector<grpc::Slice> slices;
+    if (!buffer.Dump(&slices).ok()) {
+        return false;
+    }
+    scratch_.clear();
+    scratch_.reserve(buffer.Length());
+    for (const auto& part : slices) {
+        scratch_.insert(scratch_.end(), part.begin(), part.end());
+    }
+    return decode(scratch_.data(), scratch_.size(), out);
+}
+
+} // namespace godot_grpc
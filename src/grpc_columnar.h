@@ -0,0 +1,83 @@
+#ifndef GODOT_GRPC_COLUMNAR_H
+#define GODOT_GRPC_COLUMNAR_H
+
+#include "grpc_decode_plan.h"
+#include <godot_cpp/variant/dictionary.hpp>
+#include <grpcpp/support/byte_buffer.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace godot_grpc {
+
+class LoadedSchema;
+
+/**
+ * ColumnarDecoder: Decodes a repeated sub-message field as struct-of-arrays.
+ *
+ * For a message like
+ *   message WorldState { repeated Entity entities = 1; }
+ *   message Entity { uint32 id = 1; float x = 2; float y = 3; }
+ * decoding field "entities" yields
+ *   { "id": PackedInt64Array, "x": PackedFloat32Array, "y": PackedFloat32Array }
+ * with one element per entity and no per-entity Dictionary.
+ *
+ * Scalar fields of the element type become columns (integers, enums and
+ * bools as PackedInt64Array, float as PackedFloat32Array, double as
+ * PackedFloat64Array, string as PackedStringArray); bytes, message and map
+ * fields are skipped. Entities missing a field get its default value so
+ * columns stay aligned.
+ *
+ * Repeated scalar fields of the element type are ragged: their column is a
+ * Dictionary { "values": <packed array of every entity's values>,
+ * "offsets": PackedInt64Array } where entity i owns
+ * values[offsets[i]] .. values[offsets[i + 1] - 1]. Packed varint runs go
+ * through the bulk (SIMD) varint kernel.
+ *
+ * The decoder holds the LoadedSchema its plans come from, so a reload of
+ * the GrpcSchema does not free them. It also holds a scratch buffer and
+ * must only be used from one thread at a time.
+ */
+class ColumnarDecoder {
+public:
+    /**
+     * Prepare to decode repeated message field `field` of `message_type`.
+     * Returns false if the type is unknown, or the field does not exist or
+     * is not a repeated message field.
+     */
+    bool init(std::shared_ptr<const LoadedSchema> schema, const std::string& message_type, const std::string& field);
+
+    /**
+     * Decode a serialized root message into `out` (cleared first).
+     */
+    bool decode(const uint8_t* data, size_t size, godot::Dictionary& out) const;
+
+    /**
+     * Decode straight from a received ByteBuffer. Single-slice buffers are
+     * read in place; fragmented ones are gathered into the scratch buffer.
+     */
+    bool decode(const grpc::ByteBuffer& buffer, godot::Dictionary& out);
+
+private:
+    struct Column {
+        DecodePlan::Kind kind;
+        uint32_t wire_type;  // Wire type of a single value
+        bool repeated;
+        godot::String key;
+        godot::Variant default_value;
+    };
+
+    bool count_elements(const uint8_t* data, size_t size, size_t* out_count) const;
+
+    std::shared_ptr<const LoadedSchema> schema_;
+    const DecodePlan* element_ = nullptr;
+    uint32_t field_number_ = 0;
+    std::vector<Column> columns_;
+    std::vector<int> entry_to_column_; // Element entry index -> column index, or -1
+    std::vector<int> repeated_columns_;
+    std::vector<uint8_t> scratch_;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_COLUMNAR_H
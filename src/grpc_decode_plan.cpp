@@ -0,0 +1,510 @@
+#include "grpc_decode_plan.h"
+#include "util/varint_decode.h"
+#include "util/wire_format.h"
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <google/protobuf/descriptor.pb.h>
+#include <algorithm>
+
+namespace godot_grpc {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+
+namespace {
+
+// Same nesting limit as the protobuf parser
+using wire::MAX_DEPTH;
+
+// Field numbers above this are resolved by a scan instead of the dense table
+constexpr uint32_t MAX_DENSE_FIELD_NUMBER = 1024;
+
+godot::String to_godot_string(const std::string& value) {
+    return godot::String::utf8(value.data(), static_cast<int64_t>(value.size()));
+}
+
+DecodePlan::Kind kind_of(const FieldDescriptor* fd) {
+    switch (fd->type()) {
+        case FieldDescriptor::TYPE_INT32: return DecodePlan::KIND_INT32;
+        case FieldDescriptor::TYPE_INT64: return DecodePlan::KIND_INT64;
+        case FieldDescriptor::TYPE_UINT32: return DecodePlan::KIND_UINT32;
+        case FieldDescriptor::TYPE_UINT64: return DecodePlan::KIND_UINT64;
+        case FieldDescriptor::TYPE_SINT32: return DecodePlan::KIND_SINT32;
+        case FieldDescriptor::TYPE_SINT64: return DecodePlan::KIND_SINT64;
+        case FieldDescriptor::TYPE_BOOL: return DecodePlan::KIND_BOOL;
+        case FieldDescriptor::TYPE_ENUM: return DecodePlan::KIND_ENUM;
+        case FieldDescriptor::TYPE_FIXED32: return DecodePlan::KIND_FIXED32;
+        case FieldDescriptor::TYPE_SFIXED32: return DecodePlan::KIND_SFIXED32;
+        case FieldDescriptor::TYPE_FLOAT: return DecodePlan::KIND_FLOAT;
+        case FieldDescriptor::TYPE_FIXED64: return DecodePlan::KIND_FIXED64;
+        case FieldDescriptor::TYPE_SFIXED64: return DecodePlan::KIND_SFIXED64;
+        case FieldDescriptor::TYPE_DOUBLE: return DecodePlan::KIND_DOUBLE;
+        case FieldDescriptor::TYPE_STRING: return DecodePlan::KIND_STRING;
+        case FieldDescriptor::TYPE_BYTES: return DecodePlan::KIND_BYTES;
+        case FieldDescriptor::TYPE_MESSAGE: return fd->is_map() ? DecodePlan::KIND_MAP : DecodePlan::KIND_MESSAGE;
+        default: return DecodePlan::KIND_UNSUPPORTED;
+    }
+}
+
+uint32_t wire_type_of(DecodePlan::Kind kind) {
+    switch (kind) {
+        case DecodePlan::KIND_FIXED32:
+        case DecodePlan::KIND_SFIXED32:
+        case DecodePlan::KIND_FLOAT:
+            return wire::FIXED32;
+        case DecodePlan::KIND_FIXED64:
+        case DecodePlan::KIND_SFIXED64:
+        case DecodePlan::KIND_DOUBLE:
+            return wire::FIXED64;
+        case DecodePlan::KIND_STRING:
+        case DecodePlan::KIND_BYTES:
+        case DecodePlan::KIND_MESSAGE:
+        case DecodePlan::KIND_MAP:
+            return wire::LENGTH_DELIMITED;
+        case DecodePlan::KIND_UNSUPPORTED:
+            return wire::START_GROUP;
+        default:
+            return wire::VARINT;
+    }
+}
+
+// Repeated fields whose container is a reference type and must be created per decode
+bool needs_fresh_container(const DecodePlan::Entry& entry) {
+    return entry.kind == DecodePlan::KIND_MAP ||
+           (entry.repeated && (entry.kind == DecodePlan::KIND_BOOL || entry.kind == DecodePlan::KIND_BYTES ||
+                               entry.kind == DecodePlan::KIND_MESSAGE));
+}
+
+godot::Variant default_value(const DecodePlan::Entry& entry, const FieldDescriptor* fd) {
+    if (entry.presence || needs_fresh_container(entry)) {
+        return godot::Variant();
+    }
+    if (entry.repeated) {
+        switch (entry.kind) {
+            case DecodePlan::KIND_FLOAT: return godot::PackedFloat32Array();
+            case DecodePlan::KIND_DOUBLE: return godot::PackedFloat64Array();
+            case DecodePlan::KIND_STRING: return godot::PackedStringArray();
+            default: return godot::PackedInt64Array();
+        }
+    }
+    switch (fd->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_INT32: return static_cast<int64_t>(fd->default_value_int32());
+        case FieldDescriptor::CPPTYPE_INT64: return fd->default_value_int64();
+        case FieldDescriptor::CPPTYPE_UINT32: return static_cast<int64_t>(fd->default_value_uint32());
+        case FieldDescriptor::CPPTYPE_UINT64: return static_cast<int64_t>(fd->default_value_uint64());
+        case FieldDescriptor::CPPTYPE_DOUBLE: return fd->default_value_double();
+        case FieldDescriptor::CPPTYPE_FLOAT: return static_cast<double>(fd->default_value_float());
+        case FieldDescriptor::CPPTYPE_BOOL: return fd->default_value_bool();
+        case FieldDescriptor::CPPTYPE_ENUM: return static_cast<int64_t>(fd->default_value_enum()->number());
+        case FieldDescriptor::CPPTYPE_STRING:
+            if (entry.kind == DecodePlan::KIND_BYTES) {
+                const std::string& value = fd->default_value_string();
+                godot::PackedByteArray bytes;
+                bytes.resize(value.size());
+                if (!value.empty()) {
+                    memcpy(bytes.ptrw(), value.data(), value.size());
+                }
+                return bytes;
+            }
+            return to_godot_string(fd->default_value_string());
+        default:
+            return godot::Variant();
+    }
+}
+
+bool read_length(const uint8_t* data, size_t size, size_t* pos, size_t* out_length) {
+    uint64_t length;
+    if (!wire::decode_varint(data, size, pos, &length) || length > size - *pos) {
+        return false;
+    }
+    *out_length = static_cast<size_t>(length);
+    return true;
+}
+
+template <typename Slots>
+bool decode_slots(const DecodePlan& plan, const uint8_t* data, size_t size, Slots& slots, int depth);
+
+bool decode_nested(const DecodePlan& plan, const uint8_t* data, size_t size, godot::Dictionary& out, int depth);
+
+// Read one element of `entry` (wire type already checked) into `out`.
+bool read_value(const DecodePlan::Entry& entry, const uint8_t* data, size_t size, size_t* pos, godot::Variant& out, int depth) {
+    switch (entry.wire_type) {
+        case wire::VARINT: {
+            uint64_t raw;
+            if (!wire::decode_varint(data, size, pos, &raw)) {
+                return false;
+            }
+            if (entry.kind == DecodePlan::KIND_BOOL) {
+                out = raw != 0;
+            } else {
+                out = DecodePlan::varint_value(entry.kind, raw);
+            }
+            return true;
+        }
+        case wire::FIXED32: {
+            if (size - *pos < 4) {
+                return false;
+            }
+            uint32_t raw = wire::load_fixed32(data + *pos);
+            *pos += 4;
+            if (entry.kind == DecodePlan::KIND_FLOAT) {
+                out = static_cast<double>(wire::bits_to_float(raw));
+            } else {
+                out = DecodePlan::fixed32_value(entry.kind, raw);
+            }
+            return true;
+        }
+        case wire::FIXED64: {
+            if (size - *pos < 8) {
+                return false;
+            }
+            uint64_t raw = wire::load_fixed64(data + *pos);
+            *pos += 8;
+            if (entry.kind == DecodePlan::KIND_DOUBLE) {
+                out = wire::bits_to_double(raw);
+            } else {
+                out = static_cast<int64_t>(raw);
+            }
+            return true;
+        }
+        case wire::LENGTH_DELIMITED: {
+            size_t length;
+            if (!read_length(data, size, pos, &length)) {
+                return false;
+            }
+            const uint8_t* value = data + *pos;
+            *pos += length;
+            if (entry.kind == DecodePlan::KIND_STRING) {
+                out = godot::String::utf8(reinterpret_cast<const char*>(value), static_cast<int64_t>(length));
+            } else if (entry.kind == DecodePlan::KIND_BYTES) {
+                godot::PackedByteArray bytes;
+                bytes.resize(length);
+                if (length > 0) {
+                    memcpy(bytes.ptrw(), value, length);
+                }
+                out = bytes;
+            } else {
+                godot::Dictionary nested;
+                if (!decode_nested(*entry.message, value, length, nested, depth + 1)) {
+                    return false;
+                }
+                out = nested;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// Append one value to a Packed*Array held in a Variant without copying it:
+// the slot is emptied first so the array is uniquely owned while it grows.
+template <typename Packed, typename T>
+void append_packed(godot::Variant& slot, const T& value) {
+    Packed values = slot;
+    slot = godot::Variant();
+    values.push_back(value);
+    slot = values;
+}
+
+void append_value(const DecodePlan::Entry& entry, godot::Variant& slot, const godot::Variant& value) {
+    switch (entry.kind) {
+        case DecodePlan::KIND_FLOAT:
+            append_packed<godot::PackedFloat32Array>(slot, static_cast<float>(static_cast<double>(value)));
+            break;
+        case DecodePlan::KIND_DOUBLE:
+            append_packed<godot::PackedFloat64Array>(slot, static_cast<double>(value));
+            break;
+        case DecodePlan::KIND_STRING:
+            append_packed<godot::PackedStringArray>(slot, static_cast<godot::String>(value));
+            break;
+        case DecodePlan::KIND_BOOL:
+        case DecodePlan::KIND_BYTES:
+        case DecodePlan::KIND_MESSAGE: {
+            godot::Array values = slot;
+            values.push_back(value);
+            break;
+        }
+        default:
+            append_packed<godot::PackedInt64Array>(slot, static_cast<int64_t>(value));
+            break;
+    }
+}
+
+// Decode a packed run of numeric elements, sizing the target array once.
+bool read_packed(const DecodePlan::Entry& entry, const uint8_t* data, size_t size, godot::Variant& slot) {
+    size_t count = 0;
+    if (entry.wire_type == wire::VARINT) {
+        if (!wire::count_varints(data, size, &count)) {
+            return false;
+        }
+    } else {
+        size_t width = entry.wire_type == wire::FIXED32 ? 4 : 8;
+        if (size % width != 0) {
+            return false;
+        }
+        count = size / width;
+    }
+
+    if (entry.kind == DecodePlan::KIND_BOOL) {
+        godot::Array values = slot;
+        size_t pos = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t raw;
+            if (!wire::decode_varint(data, size, &pos, &raw)) {
+                return false;
+            }
+            values.push_back(raw != 0);
+        }
+        return true;
+    }
+
+    if (entry.kind == DecodePlan::KIND_FLOAT) {
+        godot::PackedFloat32Array values = slot;
+        slot = godot::Variant();
+        int64_t base = values.size();
+        values.resize(base + static_cast<int64_t>(count));
+        float* out = values.ptrw() + base;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = wire::bits_to_float(wire::load_fixed32(data + i * 4));
+        }
+        slot = values;
+        return true;
+    }
+
+    if (entry.kind == DecodePlan::KIND_DOUBLE) {
+        godot::PackedFloat64Array values = slot;
+        slot = godot::Variant();
+        int64_t base = values.size();
+        values.resize(base + static_cast<int64_t>(count));
+        double* out = values.ptrw() + base;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = wire::bits_to_double(wire::load_fixed64(data + i * 8));
+        }
+        slot = values;
+        return true;
+    }
+
+    godot::PackedInt64Array values = slot;
+    slot = godot::Variant();
+    int64_t base = values.size();
+    values.resize(base + static_cast<int64_t>(count));
+    int64_t* out = values.ptrw() + base;
+    if (entry.wire_type == wire::VARINT) {
+        if (count > 0 && !wire::decode_varints(data, size, reinterpret_cast<uint64_t*>(out), count)) {
+            slot = values;
+            return false;
+        }
+        if (entry.kind != DecodePlan::KIND_INT64 && entry.kind != DecodePlan::KIND_UINT64) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = DecodePlan::varint_value(entry.kind, static_cast<uint64_t>(out[i]));
+            }
+        }
+    } else if (entry.wire_type == wire::FIXED32) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = DecodePlan::fixed32_value(entry.kind, wire::load_fixed32(data + i * 4));
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<int64_t>(wire::load_fixed64(data + i * 8));
+        }
+    }
+    slot = values;
+    return true;
+}
+
+bool read_map_entry(const DecodePlan::Entry& entry, const uint8_t* data, size_t size, godot::Variant& slot, int depth) {
+    const DecodePlan& entry_plan = *entry.message;
+    godot::Variant kv[2] = { entry_plan.defaults[0], entry_plan.defaults[1] };
+    if (!decode_slots(entry_plan, data, size, kv, depth + 1)) {
+        return false;
+    }
+    // Absent message values decode as the default (empty) message
+    if (kv[1].get_type() == godot::Variant::NIL && entry_plan.entries[1].kind == DecodePlan::KIND_MESSAGE) {
+        godot::Dictionary value;
+        if (!decode_nested(*entry_plan.entries[1].message, nullptr, 0, value, depth + 1)) {
+            return false;
+        }
+        kv[1] = value;
+    }
+    godot::Dictionary map = slot;
+    map[kv[0]] = kv[1];
+    return true;
+}
+
+template <typename Slots>
+void reset_slots(const DecodePlan& plan, Slots& slots) {
+    for (size_t i = 0; i < plan.entries.size(); ++i) {
+        const DecodePlan::Entry& entry = plan.entries[i];
+        if (entry.kind == DecodePlan::KIND_MAP) {
+            slots[i] = godot::Dictionary();
+        } else if (needs_fresh_container(entry)) {
+            slots[i] = godot::Array();
+        } else {
+            slots[i] = plan.defaults[i];
+        }
+    }
+}
+
+template <typename Slots>
+bool decode_slots(const DecodePlan& plan, const uint8_t* data, size_t size, Slots& slots, int depth) {
+    if (depth > MAX_DEPTH) {
+        return false;
+    }
+
+    size_t pos = 0;
+    while (pos < size) {
+        uint64_t tag;
+        if (!wire::decode_varint(data, size, &pos, &tag)) {
+            return false;
+        }
+        uint32_t field_number = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+        if (field_number == 0) {
+            return false;
+        }
+
+        int index = plan.find_entry(field_number);
+        if (index < 0 || plan.entries[index].kind == DecodePlan::KIND_UNSUPPORTED) {
+            if (!wire::skip_field(data, size, &pos, wire_type, field_number, depth)) {
+                return false;
+            }
+            continue;
+        }
+
+        const DecodePlan::Entry& entry = plan.entries[index];
+        godot::Variant& slot = slots[index];
+
+        if (entry.kind == DecodePlan::KIND_MAP && wire_type == wire::LENGTH_DELIMITED) {
+            size_t length;
+            if (!read_length(data, size, &pos, &length) || !read_map_entry(entry, data + pos, length, slot, depth)) {
+                return false;
+            }
+            pos += length;
+        } else if (entry.repeated && wire_type == wire::LENGTH_DELIMITED && entry.wire_type != wire::LENGTH_DELIMITED) {
+            size_t length;
+            if (!read_length(data, size, &pos, &length) || !read_packed(entry, data + pos, length, slot)) {
+                return false;
+            }
+            pos += length;
+        } else if (wire_type == entry.wire_type) {
+            if (entry.repeated) {
+                godot::Variant value;
+                if (!read_value(entry, data, size, &pos, value, depth)) {
+                    return false;
+                }
+                append_value(entry, slot, value);
+            } else {
+                // Last occurrence wins; split sub-messages are not merged
+                if (!read_value(entry, data, size, &pos, slot, depth)) {
+                    return false;
+                }
+                if (entry.oneof >= 0) {
+                    for (size_t i = 0; i < plan.entries.size(); ++i) {
+                        if (plan.entries[i].oneof == entry.oneof && static_cast<int>(i) != index) {
+                            slots[i] = godot::Variant();
+                        }
+                    }
+                }
+            }
+        } else {
+            // Mismatched wire type: treated as an unknown field, like protobuf does
+            if (!wire::skip_field(data, size, &pos, wire_type, field_number, depth)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool decode_nested(const DecodePlan& plan, const uint8_t* data, size_t size, godot::Dictionary& out, int depth) {
+    std::vector<godot::Variant> slots(plan.entries.size());
+    reset_slots(plan, slots);
+    if (!decode_slots(plan, data, size, slots, depth)) {
+        return false;
+    }
+
+    out.clear();
+    for (size_t i = 0; i < plan.entries.size(); ++i) {
+        if (plan.entries[i].presence && slots[i].get_type() == godot::Variant::NIL) {
+            continue;
+        }
+        out[plan.entries[i].key] = slots[i];
+    }
+    return true;
+}
+
+} // namespace
+
+void DecodePlan::build(const Descriptor* message_descriptor, const Resolver& resolve) {
+    descriptor = message_descriptor;
+    entries.clear();
+    defaults.clear();
+    by_number.clear();
+
+    uint32_t max_dense = 0;
+    entries.reserve(descriptor->field_count());
+    defaults.reserve(descriptor->field_count());
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+        const FieldDescriptor* fd = descriptor->field(i);
+        Entry entry;
+        entry.field_number = static_cast<uint32_t>(fd->number());
+        entry.kind = kind_of(fd);
+        entry.wire_type = wire_type_of(entry.kind);
+        entry.repeated = fd->is_repeated() && entry.kind != KIND_MAP;
+        entry.presence = !fd->is_repeated() && fd->has_presence();
+        if (descriptor->options().map_entry()) {
+            // Map keys and scalar values are always materialized
+            entry.presence = entry.kind == KIND_MESSAGE;
+        }
+        entry.oneof = fd->real_containing_oneof() ? fd->real_containing_oneof()->index() : -1;
+        entry.key = to_godot_string(fd->name());
+        entry.message = nullptr;
+        if (entry.kind == KIND_MESSAGE || entry.kind == KIND_MAP) {
+            entry.message = resolve(fd->message_type());
+        }
+        defaults.push_back(default_value(entry, fd));
+        entries.push_back(entry);
+
+        if (entry.field_number <= MAX_DENSE_FIELD_NUMBER) {
+            max_dense = std::max(max_dense, entry.field_number);
+        }
+    }
+
+    by_number.assign(max_dense + 1, -1);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].field_number <= max_dense) {
+            by_number[entries[i].field_number] = static_cast<int32_t>(i);
+        }
+    }
+}
+
+int DecodePlan::find_entry(uint32_t field_number) const {
+    if (field_number < by_number.size()) {
+        return by_number[field_number];
+    }
+    // Sparse high field numbers are rare; a linear scan keeps the table small
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].field_number == field_number) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool DecodePlan::decode_dictionary(const uint8_t* data, size_t size, godot::Dictionary& out) const {
+    return decode_nested(*this, data, size, out, 0);
+}
+
+bool DecodePlan::decode_array(const uint8_t* data, size_t size, godot::Array& out) const {
+    if (out.size() != static_cast<int64_t>(entries.size())) {
+        out.resize(static_cast<int64_t>(entries.size()));
+    }
+    reset_slots(*this, out);
+    return decode_slots(*this, data, size, out, 0);
+}
+
+} // namespace godot_grpc
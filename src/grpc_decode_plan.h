@@ -0,0 +1,116 @@
+#ifndef GODOT_GRPC_DECODE_PLAN_H
+#define GODOT_GRPC_DECODE_PLAN_H
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/variant.hpp>
+#include "util/wire_format.h"
+#include <google/protobuf/descriptor.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace godot_grpc {
+
+/**
+ * DecodePlan: A message type compiled into a flat decode table.
+ *
+ * Each field becomes an Entry holding its field number, value kind and the
+ * output slot it writes to. Decoding walks the wire bytes once and resolves
+ * every tag through a dense field-number table, so no descriptor, reflection
+ * or hash lookups happen per field. Plans are immutable once built and can
+ * be shared between threads.
+ *
+ * Output matches GrpcSchema::message_to_dictionary(): slots are in
+ * declaration order, fields with explicit presence (messages, oneof members,
+ * proto2/optional scalars) are only reported when set.
+ */
+struct DecodePlan {
+    enum Kind : uint8_t {
+        KIND_INT32,
+        KIND_INT64,
+        KIND_UINT32,
+        KIND_UINT64,
+        KIND_SINT32,
+        KIND_SINT64,
+        KIND_BOOL,
+        KIND_ENUM,
+        KIND_FIXED32,
+        KIND_SFIXED32,
+        KIND_FLOAT,
+        KIND_FIXED64,
+        KIND_SFIXED64,
+        KIND_DOUBLE,
+        KIND_STRING,
+        KIND_BYTES,
+        KIND_MESSAGE,
+        KIND_MAP,
+        KIND_UNSUPPORTED // proto2 groups: skipped
+    };
+
+    struct Entry {
+        uint32_t field_number;
+        Kind kind;
+        uint32_t wire_type;        // Wire type of a single element
+        bool repeated;
+        bool presence;             // Only reported when set
+        int oneof;                 // Oneof index, or -1
+        godot::String key;         // Dictionary key (field name)
+        const DecodePlan* message; // Plan for message/map-entry fields, else nullptr
+    };
+
+    using Resolver = std::function<const DecodePlan*(const google::protobuf::Descriptor*)>;
+
+    /**
+     * Compile `descriptor`. Nested message types are obtained through
+     * `resolve`, which may return a plan that is still being built
+     * (recursive types).
+     */
+    void build(const google::protobuf::Descriptor* descriptor, const Resolver& resolve);
+
+    /**
+     * Decode into a Dictionary keyed by field name. `out` is cleared first.
+     * Returns false on malformed input.
+     */
+    bool decode_dictionary(const uint8_t* data, size_t size, godot::Dictionary& out) const;
+
+    /**
+     * Decode into `out` indexed by slot (see field_names). The Array is
+     * resized to the slot count and reused as-is when it already has that
+     * size; absent presence fields are set to null.
+     */
+    bool decode_array(const uint8_t* data, size_t size, godot::Array& out) const;
+
+    int find_entry(uint32_t field_number) const;
+
+    // Convert a raw varint / fixed32 to the int value of an integer kind
+    static int64_t varint_value(Kind kind, uint64_t raw) {
+        switch (kind) {
+            case KIND_INT32:
+            case KIND_ENUM:
+                return static_cast<int32_t>(raw);
+            case KIND_UINT32:
+                return static_cast<uint32_t>(raw);
+            case KIND_SINT32:
+                return static_cast<int32_t>(wire::zigzag_decode(raw));
+            case KIND_SINT64:
+                return wire::zigzag_decode(raw);
+            default:
+                return static_cast<int64_t>(raw);
+        }
+    }
+
+    static int64_t fixed32_value(Kind kind, uint32_t raw) {
+        return kind == KIND_SFIXED32 ? static_cast<int64_t>(static_cast<int32_t>(raw)) : static_cast<int64_t>(raw);
+    }
+
+    const google::protobuf::Descriptor* descriptor = nullptr;
+    std::vector<Entry> entries;          // Slot order == declaration order
+    std::vector<int32_t> by_number;      // Dense field number -> entry index (-1 if unknown)
+    std::vector<godot::Variant> defaults; // Initial slot values (shared COW values only)
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_DECODE_PLAN_H
@@ -0,0 +1,141 @@
+#include "grpc_delta.h"
+#include "util/delta_codec.h"
+#include "util/wire_format.h"
+#include <grpcpp/support/slice.h>
+
+namespace godot_grpc {
+
+namespace {
+
+// Bound on the `size` field so a corrupt frame cannot force a huge allocation
+constexpr uint64_t MAX_PAYLOAD_SIZE = 64ull * 1024 * 1024;
+
+} // namespace
+
+DeltaDecoder::DeltaDecoder(size_t max_baselines)
+    : baselines_(max_baselines > 0 ? max_baselines : 1)
+{
+}
+
+const DeltaDecoder::Baseline* DeltaDecoder::find_baseline(uint64_t sequence) const {
+    for (const auto& baseline : baselines_) {
+        if (baseline.sequence == sequence && sequence != 0) {
+            return &baseline;
+        }
+    }
+    return nullptr;
+}
+
+DeltaDecoder::Result DeltaDecoder::decode(const grpc::ByteBuffer& buffer, godot::PackedByteArray& out, uint64_t* out_sequence) {
+    grpc::Slice slice;
+    if (buffer.TrySingleSlice(&slice).ok()) {
+        return decode(slice.begin(), slice.size(), out, out_sequence);
+    }
+
+    std::vector<grpc::Slice> slices;
+    if (!buffer.Dump(&slices).ok()) {
+        return MALFORMED;
+    }
+    scratch_.clear();
+    scratch_.reserve(buffer.Length());
+    for (const auto& part : slices) {
+        scratch_.insert(scratch_.end(), part.begin(), part.end());
+    }
+    return decode(scratch_.data(), scratch_.size(), out, out_sequence);
+}
+
+DeltaDecoder::Result DeltaDecoder::decode(const uint8_t* data, size_t size, godot::PackedByteArray& out, uint64_t* out_sequence) {
+    uint64_t sequence = 0;
+    uint64_t baseline_sequence = 0;
+    uint64_t target_size = 0;
+    bool has_size = false;
+    const uint8_t* payload = nullptr;
+    size_t payload_size = 0;
+
+    size_t pos = 0;
+    while (pos < size) {
+        uint64_t tag;
+        if (!wire::decode_varint(data, size, &pos, &tag)) {
+            return MALFORMED;
+        }
+        uint32_t field_number = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+        if (field_number >= 1 && field_number <= 4 && wire_type == (field_number == 3 ? wire::LENGTH_DELIMITED : wire::VARINT)) {
+            uint64_t value;
+            if (!wire::decode_varint(data, size, &pos, &value)) {
+                return MALFORMED;
+            }
+            switch (field_number) {
+                case 1: sequence = value; break;
+                case 2: baseline_sequence = value; break;
+                case 3:
+                    if (value > size - pos) {
+                        return MALFORMED;
+                    }
+                    payload = data + pos;
+                    payload_size = static_cast<size_t>(value);
+                    pos += payload_size;
+                    break;
+                case 4: target_size = value; has_size = true; break;
+            }
+        } else if (!wire::skip_field(data, size, &pos, wire_type, field_number)) {
+            return MALFORMED;
+        }
+    }
+    if (sequence == 0) {
+        return MALFORMED;
+    }
+    *out_sequence = sequence;
+
+    godot::PackedByteArray result;
+    if (baseline_sequence == 0) {
+        // Keyframe: the payload is the full message
+        result.resize(static_cast<int64_t>(payload_size));
+        if (payload_size > 0) {
+            memcpy(result.ptrw(), payload, payload_size);
+        }
+    } else {
+        const Baseline* baseline = find_baseline(baseline_sequence);
+        if (!baseline) {
+            return NEED_KEYFRAME;
+        }
+        size_t baseline_size = static_cast<size_t>(baseline->payload.size());
+        if (!has_size) {
+            target_size = baseline_size;
+        }
+        if (target_size > MAX_PAYLOAD_SIZE) {
+            return MALFORMED;
+        }
+        result.resize(static_cast<int64_t>(target_size));
+        if (!wire::apply_xor_delta(baseline->payload.ptr(), baseline_size, payload, payload_size,
+                                   result.ptrw(), static_cast<size_t>(target_size))) {
+            return MALFORMED;
+        }
+    }
+
+    // Replace the oldest baseline
+    Baseline& slot = baselines_[next_slot_];
+    slot.sequence = sequence;
+    slot.payload = result;
+    next_slot_ = (next_slot_ + 1) % baselines_.size();
+
+    out = result;
+    return APPLIED;
+}
+
+godot::PackedByteArray DeltaDecoder::make_ack(uint64_t sequence, bool need_keyframe) {
+    wire::Buffer buffer;
+    buffer.put_varint(wire::make_tag(1, wire::VARINT));
+    buffer.put_varint(sequence);
+    if (need_keyframe) {
+        buffer.put_varint(wire::make_tag(2, wire::VARINT));
+        buffer.put_varint(1);
+    }
+
+    godot::PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(buffer.size()));
+    memcpy(bytes.ptrw(), buffer.data(), buffer.size());
+    return bytes;
+}
+
+} // namespace godot_grpc
@@ -0,0 +1,62 @@
+#ifndef GODOT_GRPC_DELTA_H
+#define GODOT_GRPC_DELTA_H
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <grpcpp/support/byte_buffer.h>
+#include <cstdint>
+#include <vector>
+
+namespace godot_grpc {
+
+/**
+ * DeltaDecoder: Reconstructs full payloads from a delta-encoded stream.
+ *
+ * Each stream message is a frame
+ *   message DeltaFrame {
+ *     uint64 sequence = 1;   // Sequence number of this payload
+ *     uint64 baseline = 2;   // Sequence it is a delta against, 0 = keyframe
+ *     bytes payload = 3;     // Full payload, or an XOR/RLE delta (util/delta_codec.h)
+ *     uint64 size = 4;       // Size of the reconstructed payload
+ *   }
+ * and the client acknowledges payloads it has reconstructed with
+ *   message DeltaAck {
+ *     uint64 sequence = 1;
+ *     bool need_keyframe = 2;  // The referenced baseline is unknown
+ *   }
+ * The decoder keeps the last `max_baselines` reconstructed payloads, so the
+ * server may encode against any acknowledged sequence still in that window.
+ *
+ * Used from the stream's reader thread only.
+ */
+class DeltaDecoder {
+public:
+    enum Result {
+        APPLIED,        // `out` holds the reconstructed payload
+        NEED_KEYFRAME,  // The frame references a baseline we no longer have
+        MALFORMED
+    };
+
+    explicit DeltaDecoder(size_t max_baselines);
+
+    Result decode(const grpc::ByteBuffer& buffer, godot::PackedByteArray& out, uint64_t* out_sequence);
+    Result decode(const uint8_t* data, size_t size, godot::PackedByteArray& out, uint64_t* out_sequence);
+
+    // Serialize a DeltaAck
+    static godot::PackedByteArray make_ack(uint64_t sequence, bool need_keyframe);
+
+private:
+    struct Baseline {
+        uint64_t sequence = 0;
+        godot::PackedByteArray payload; // Shared with the emitted message, not copied
+    };
+
+    const Baseline* find_baseline(uint64_t sequence) const;
+
+    std::vector<Baseline> baselines_;
+    size_t next_slot_ = 0;
+    std::vector<uint8_t> scratch_;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_DELTA_H
@@ -0,0 +1,132 @@
+#include "grpc_mock_server.h"
+#include "util/status_map.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+
+namespace godot_grpc {
+
+namespace {
+
+std::string to_std_string(const godot::PackedByteArray& bytes) {
+    return std::string(reinterpret_cast<const char*>(bytes.ptr()), static_cast<size_t>(bytes.size()));
+}
+
+mock::MethodScript parse_script(const godot::Dictionary& script) {
+    mock::MethodScript parsed;
+
+    if (script.has("response")) {
+        parsed.responses.push_back(to_std_string(script["response"]));
+    }
+    if (script.has("responses")) {
+        godot::Array responses = script["responses"];
+        for (int i = 0; i < responses.size(); ++i) {
+            parsed.responses.push_back(to_std_string(responses[i]));
+        }
+    }
+    if (script.has("repeat")) {
+        parsed.repeat = script["repeat"];
+    }
+    if (script.has("echo")) {
+        parsed.echo = script["echo"];
+    }
+    if (script.has("reply_per_message")) {
+        parsed.reply_per_message = script["reply_per_message"];
+    }
+    if (script.has("delay_ms")) {
+        parsed.delay_ms = script["delay_ms"];
+    }
+    if (script.has("jitter_ms")) {
+        parsed.jitter_ms = script["jitter_ms"];
+    }
+    if (script.has("read_delay_ms")) {
+        parsed.read_delay_ms = script["read_delay_ms"];
+    }
+    if (script.has("status_code")) {
+        parsed.status_code = script["status_code"];
+    }
+    if (script.has("status_message")) {
+        godot::String message = script["status_message"];
+        parsed.status_message = message.utf8().get_data();
+    }
+    if (script.has("error_rate")) {
+        parsed.error_rate = script["error_rate"];
+    }
+    if (script.has("disconnect_after")) {
+        parsed.disconnect_after = script["disconnect_after"];
+    }
+
+    return parsed;
+}
+
+} // namespace
+
+GrpcMockServer::~GrpcMockServer() {
+    stop();
+}
+
+void GrpcMockServer::_bind_methods() {
+    godot::ClassDB::bind_method(godot::D_METHOD("start", "address"), &GrpcMockServer::start, DEFVAL("127.0.0.1:0"));
+    godot::ClassDB::bind_method(godot::D_METHOD("stop"), &GrpcMockServer::stop);
+    godot::ClassDB::bind_method(godot::D_METHOD("is_running"), &GrpcMockServer::is_running);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_port"), &GrpcMockServer::get_port);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_endpoint"), &GrpcMockServer::get_endpoint);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_handler", "full_method", "script"), &GrpcMockServer::set_handler);
+    godot::ClassDB::bind_method(godot::D_METHOD("remove_handler", "full_method"), &GrpcMockServer::remove_handler);
+    godot::ClassDB::bind_method(godot::D_METHOD("clear_handlers"), &GrpcMockServer::clear_handlers);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_seed", "seed"), &GrpcMockServer::set_seed);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_call_count", "full_method"), &GrpcMockServer::get_call_count, DEFVAL(godot::String()));
+    godot::ClassDB::bind_method(godot::D_METHOD("reset_call_counts"), &GrpcMockServer::reset_call_counts);
+}
+
+bool GrpcMockServer::start(const godot::String& address) {
+    std::string error;
+    if (!server_.start(address.utf8().get_data(), &error)) {
+        Logger::error("GrpcMockServer: " + error);
+        return false;
+    }
+    Logger::info("GrpcMockServer: listening on " + server_.endpoint());
+    return true;
+}
+
+void GrpcMockServer::stop() {
+    server_.stop();
+}
+
+bool GrpcMockServer::is_running() const {
+    return server_.is_running();
+}
+
+int GrpcMockServer::get_port() const {
+    return server_.port();
+}
+
+godot::String GrpcMockServer::get_endpoint() const {
+    return godot::String::utf8(server_.endpoint().c_str());
+}
+
+void GrpcMockServer::set_handler(const godot::String& full_method, const godot::Dictionary& script) {
+    server_.set_script(full_method.utf8().get_data(), parse_script(script));
+}
+
+void GrpcMockServer::remove_handler(const godot::String& full_method) {
+    server_.remove_script(full_method.utf8().get_data());
+}
+
+void GrpcMockServer::clear_handlers() {
+    server_.clear_scripts();
+}
+
+void GrpcMockServer::set_seed(int64_t seed) {
+    server_.set_seed(static_cast<uint32_t>(seed));
+}
+
+int64_t GrpcMockServer::get_call_count(const godot::String& full_method) const {
+    return static_cast<int64_t>(server_.call_count(full_method.utf8().get_data()));
+}
+
+void GrpcMockServer::reset_call_counts() {
+    server_.reset_call_counts();
+}
+
+} // namespace godot_grpc
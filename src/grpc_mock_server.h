@@ -0,0 +1,82 @@
+#ifndef GODOT_GRPC_MOCK_SERVER_H
+#define GODOT_GRPC_MOCK_SERVER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "util/mock_server.h"
+
+namespace godot_grpc {
+
+/**
+ * GrpcMockServer: An in-process gRPC server for tests.
+ *
+ * Each method is scripted with a Dictionary of canned responses, delays,
+ * jitter, error codes and mid-stream disconnects (see set_handler()), so
+ * deadlines, retries and backpressure can be exercised against controlled
+ * slowness without an external service. Calls are served on gRPC's own
+ * threads; nothing runs on the main thread.
+ */
+class GrpcMockServer : public godot::RefCounted {
+    GDCLASS(GrpcMockServer, godot::RefCounted)
+
+public:
+    GrpcMockServer() = default;
+    ~GrpcMockServer();
+
+    /**
+     * Start listening.
+     *
+     * @param address "host:port" (port 0 picks a free one) or "unix:/path"
+     * @return true on success; connect a client to get_endpoint()
+     */
+    bool start(const godot::String& address = "127.0.0.1:0");
+
+    /**
+     * Skip remaining delays, cancel calls still in flight and stop.
+     */
+    void stop();
+
+    bool is_running() const;
+    int get_port() const;
+    godot::String get_endpoint() const;
+
+    /**
+     * Script a method. Keys (all optional):
+     *   response: PackedByteArray, or responses: Array of PackedByteArray
+     *   repeat: int - times the responses are sent per reply (default 1)
+     *   echo: bool - reply with the request instead
+     *   reply_per_message: bool - reply to each request as it arrives
+     *   delay_ms, jitter_ms: int - before each response message
+     *   read_delay_ms: int - before reading each further request
+     *   status_code: int, status_message: String - final status
+     *   error_rate: float - share of calls ending with status_code (default 1.0)
+     *   disconnect_after: int - responses before the call ends with UNAVAILABLE
+     *
+     * @param full_method e.g. "/game.Lobby/Join"
+     */
+    void set_handler(const godot::String& full_method, const godot::Dictionary& script);
+    void remove_handler(const godot::String& full_method);
+    void clear_handlers();
+
+    /**
+     * Seed the generator behind jitter and error_rate for repeatable runs.
+     */
+    void set_seed(int64_t seed);
+
+    /**
+     * Calls received for a method, or for all methods when empty.
+     */
+    int64_t get_call_count(const godot::String& full_method = godot::String()) const;
+    void reset_call_counts();
+
+protected:
+    static void _bind_methods();
+
+private:
+    mock::Server server_;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_MOCK_SERVER_H
@@ -0,0 +1,340 @@
+#include "grpc_mux.h"
+#include "util/status_map.h"
+#include "util/wire_format.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <grpcpp/support/slice.h>
+
+namespace godot_grpc {
+
+GrpcMux::~GrpcMux() {
+    close();
+}
+
+void GrpcMux::_bind_methods() {
+    godot::ClassDB::bind_method(godot::D_METHOD("open", "client", "full_method", "call_opts"), &GrpcMux::open, DEFVAL(godot::Variant()));
+    godot::ClassDB::bind_method(godot::D_METHOD("close"), &GrpcMux::close);
+    godot::ClassDB::bind_method(godot::D_METHOD("is_open"), &GrpcMux::is_open);
+
+    godot::ClassDB::bind_method(godot::D_METHOD("subscribe", "topic", "callback", "request"), &GrpcMux::subscribe, DEFVAL(godot::Callable()), DEFVAL(godot::PackedByteArray()));
+    godot::ClassDB::bind_method(godot::D_METHOD("unsubscribe", "topic_id"), &GrpcMux::unsubscribe);
+    godot::ClassDB::bind_method(godot::D_METHOD("send", "topic_id", "payload"), &GrpcMux::send);
+    godot::ClassDB::bind_method(godot::D_METHOD("poll", "topic_id"), &GrpcMux::poll);
+
+    godot::ClassDB::bind_method(godot::D_METHOD("get_topic_count"), &GrpcMux::get_topic_count);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_stream_id"), &GrpcMux::get_stream_id);
+
+    // Deferred from the reader thread / connected to GrpcClient signals
+    godot::ClassDB::bind_method(godot::D_METHOD("_dispatch", "topic_id"), &GrpcMux::_dispatch);
+    godot::ClassDB::bind_method(godot::D_METHOD("_topic_closed", "topic_id"), &GrpcMux::_topic_closed);
+    godot::ClassDB::bind_method(godot::D_METHOD("_on_stream_end", "stream_id", "status_code", "message"), &GrpcMux::_on_stream_end);
+
+    ADD_SIGNAL(godot::MethodInfo("topic_closed", godot::PropertyInfo(godot::Variant::INT, "topic_id")));
+    ADD_SIGNAL(godot::MethodInfo("closed", godot::PropertyInfo(godot::Variant::INT, "status_code"), godot::PropertyInfo(godot::Variant::STRING, "message")));
+}
+
+bool GrpcMux::open(const godot::Ref<GrpcClient>& client, const godot::String& full_method, const godot::Variant& call_opts) {
+    if (is_open()) {
+        Logger::warn("GrpcMux: already open");
+        return false;
+    }
+    if (client.is_null()) {
+        Logger::error("GrpcMux: open() requires a GrpcClient");
+        return false;
+    }
+
+    int64_t stream_id = client->bidi_stream_start_with_handler(full_method, call_opts,
+        [this](GrpcStream& stream, const grpc::ByteBuffer& buffer) {
+            return on_frame(stream, buffer);
+        });
+    if (stream_id < 0) {
+        return false;
+    }
+
+    client_ = client;
+    stream_id_ = stream_id;
+
+    // GrpcClient::connect() hides Object::connect(), so go through the base
+    godot::Object* signals = client_.ptr();
+    signals->connect("finished", godot::Callable(this, "_on_stream_end"));
+    signals->connect("error", godot::Callable(this, "_on_stream_end"));
+
+    Logger::info("GrpcMux opened on stream " + std::to_string(stream_id));
+    return true;
+}
+
+void GrpcMux::close() {
+    if (client_.is_null()) {
+        return;
+    }
+
+    disconnect_client_signals();
+
+    // Cancelling joins the reader thread, so on_frame() no longer runs after this
+    client_->stream_cancel(stream_id_);
+    client_.unref();
+    stream_id_ = -1;
+
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    topics_.clear();
+}
+
+bool GrpcMux::is_open() const {
+    return client_.is_valid();
+}
+
+int GrpcMux::subscribe(const godot::String& topic, const godot::Callable& callback, const godot::PackedByteArray& request) {
+    if (!is_open()) {
+        Logger::error("GrpcMux: subscribe() on a closed mux");
+        return -1;
+    }
+
+    int topic_id;
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        topic_id = next_topic_id_++;
+        Topic& entry = topics_[topic_id];
+        entry.name = topic;
+        entry.callback = callback;
+    }
+
+    if (!client_->stream_send(stream_id_, make_frame(topic_id, CONTROL_SUBSCRIBE, topic, request))) {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        topics_.erase(topic_id);
+        return -1;
+    }
+
+    Logger::debug("GrpcMux subscribed to " + std::string(topic.utf8().get_data()) + " as topic " + std::to_string(topic_id));
+    return topic_id;
+}
+
+void GrpcMux::unsubscribe(int topic_id) {
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        if (topics_.erase(topic_id) == 0) {
+            Logger::warn("GrpcMux: topic " + std::to_string(topic_id) + " not found for unsubscribe");
+            return;
+        }
+    }
+
+    if (is_open()) {
+        client_->stream_send(stream_id_, make_frame(topic_id, CONTROL_UNSUBSCRIBE, godot::String(), godot::PackedByteArray()));
+    }
+}
+
+bool GrpcMux::send(int topic_id, const godot::PackedByteArray& payload) {
+    if (!is_open()) {
+        Logger::error("GrpcMux: send() on a closed mux");
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        if (topics_.find(topic_id) == topics_.end()) {
+            Logger::error("GrpcMux: topic " + std::to_string(topic_id) + " is not subscribed");
+            return false;
+        }
+    }
+    return client_->stream_send(stream_id_, make_frame(topic_id, CONTROL_DATA, godot::String(), payload));
+}
+
+godot::Array GrpcMux::poll(int topic_id) {
+    godot::Array result;
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    auto it = topics_.find(topic_id);
+    if (it == topics_.end()) {
+        return result;
+    }
+    for (auto& payload : it->second.queue) {
+        result.push_back(payload);
+    }
+    it->second.queue.clear();
+    return result;
+}
+
+int GrpcMux::get_topic_count() const {
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    return static_cast<int>(topics_.size());
+}
+
+int64_t GrpcMux::get_stream_id() const {
+    return stream_id_;
+}
+
+bool GrpcMux::on_frame(GrpcStream& stream, const grpc::ByteBuffer& buffer) {
+    grpc::Slice slice;
+    if (buffer.TrySingleSlice(&slice).ok()) {
+        route_frame(slice.begin(), slice.size());
+        return true;
+    }
+
+    std::vector<grpc::Slice> slices;
+    if (!buffer.Dump(&slices).ok()) {
+        Logger::error("GrpcMux: failed to read frame on stream " + std::to_string(stream.get_id()));
+        return true;
+    }
+    scratch_.clear();
+    scratch_.reserve(buffer.Length());
+    for (const auto& part : slices) {
+        scratch_.insert(scratch_.end(), part.begin(), part.end());
+    }
+    route_frame(scratch_.data(), scratch_.size());
+    return true;
+}
+
+void GrpcMux::route_frame(const uint8_t* data, size_t size) {
+    uint64_t topic_id = 0;
+    uint64_t control = CONTROL_DATA;
+    const uint8_t* payload = nullptr;
+    size_t payload_size = 0;
+
+    size_t pos = 0;
+    while (pos < size) {
+        uint64_t tag;
+        if (!wire::decode_varint(data, size, &pos, &tag)) {
+            Logger::error("GrpcMux: malformed frame");
+            return;
+        }
+        uint32_t field_number = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+        bool ok;
+        if (field_number == 1 && wire_type == wire::VARINT) {
+            ok = wire::decode_varint(data, size, &pos, &topic_id);
+        } else if (field_number == 3 && wire_type == wire::VARINT) {
+            ok = wire::decode_varint(data, size, &pos, &control);
+        } else if (field_number == 2 && wire_type == wire::LENGTH_DELIMITED) {
+            uint64_t length;
+            ok = wire::decode_varint(data, size, &pos, &length) && length <= size - pos;
+            if (ok) {
+                payload = data + pos;
+                payload_size = static_cast<size_t>(length);
+                pos += payload_size;
+            }
+        } else {
+            ok = wire::skip_field(data, size, &pos, wire_type, field_number);
+        }
+        if (!ok) {
+            Logger::error("GrpcMux: malformed frame");
+            return;
+        }
+    }
+
+    int id = static_cast<int>(topic_id);
+    if (control == CONTROL_CLOSED) {
+        call_deferred("_topic_closed", id);
+        return;
+    }
+    if (control != CONTROL_DATA) {
+        return;
+    }
+
+    godot::PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(payload_size));
+    if (payload_size > 0) {
+        memcpy(bytes.ptrw(), payload, payload_size);
+    }
+
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        auto it = topics_.find(id);
+        if (it == topics_.end()) {
+            // Frames in flight after unsubscribe()
+            return;
+        }
+        Topic& topic = it->second;
+        topic.queue.push_back(bytes);
+        if (topic.callback.is_valid() && !topic.dispatch_pending) {
+            topic.dispatch_pending = true;
+            schedule = true;
+        }
+    }
+
+    // One deferred call per topic and frame, however many payloads arrive
+    if (schedule) {
+        call_deferred("_dispatch", id);
+    }
+}
+
+void GrpcMux::_dispatch(int topic_id) {
+    godot::Callable callback;
+    std::deque<godot::PackedByteArray> payloads;
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        auto it = topics_.find(topic_id);
+        if (it == topics_.end()) {
+            return;
+        }
+        callback = it->second.callback;
+        payloads.swap(it->second.queue);
+        it->second.dispatch_pending = false;
+    }
+
+    for (const auto& payload : payloads) {
+        callback.call(payload);
+    }
+}
+
+void GrpcMux::_topic_closed(int topic_id) {
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        if (topics_.erase(topic_id) == 0) {
+            return;
+        }
+    }
+    emit_signal("topic_closed", topic_id);
+}
+
+void GrpcMux::_on_stream_end(int64_t stream_id, int status_code, const godot::String& message) {
+    if (stream_id != stream_id_) {
+        return;
+    }
+
+    Logger::info("GrpcMux stream " + std::to_string(stream_id) + " ended");
+    disconnect_client_signals();
+    client_.unref();
+    stream_id_ = -1;
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        topics_.clear();
+    }
+    emit_signal("closed", status_code, message);
+}
+
+void GrpcMux::disconnect_client_signals() {
+    godot::Object* signals = client_.ptr();
+    godot::Callable on_end(this, "_on_stream_end");
+    if (signals->is_connected("finished", on_end)) {
+        signals->disconnect("finished", on_end);
+    }
+    if (signals->is_connected("error", on_end)) {
+        signals->disconnect("error", on_end);
+    }
+}
+
+godot::PackedByteArray GrpcMux::make_frame(int topic_id, Control control, const godot::String& topic,
+                                           const godot::PackedByteArray& payload) {
+    wire::Buffer buffer;
+    buffer.put_tag(1, wire::VARINT);
+    buffer.put_varint(static_cast<uint64_t>(topic_id));
+    if (payload.size() > 0) {
+        buffer.put_tag(2, wire::LENGTH_DELIMITED);
+        buffer.put_varint(static_cast<uint64_t>(payload.size()));
+        buffer.put_bytes(payload.ptr(), static_cast<size_t>(payload.size()));
+    }
+    if (control != CONTROL_DATA) {
+        buffer.put_tag(3, wire::VARINT);
+        buffer.put_varint(static_cast<uint64_t>(control));
+    }
+    if (!topic.is_empty()) {
+        godot::CharString utf8 = topic.utf8();
+        buffer.put_tag(4, wire::LENGTH_DELIMITED);
+        buffer.put_varint(static_cast<uint64_t>(utf8.length()));
+        buffer.put_bytes(reinterpret_cast<const uint8_t*>(utf8.get_data()), static_cast<size_t>(utf8.length()));
+    }
+
+    godot::PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(buffer.size()));
+    memcpy(bytes.ptrw(), buffer.data(), buffer.size());
+    return bytes;
+}
+
+} // namespace godot_grpc
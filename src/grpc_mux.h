@@ -0,0 +1,135 @@
+#ifndef GODOT_GRPC_MUX_H
+#define GODOT_GRPC_MUX_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "grpc_client.h"
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace godot_grpc {
+
+/**
+ * GrpcMux: Many logical subscriptions over one bidirectional stream.
+ *
+ * Every message on the stream, in both directions, is a frame
+ *   message MuxFrame {
+ *     uint32 topic_id = 1;
+ *     bytes payload = 2;
+ *     Control control = 3;  // DATA = 0, SUBSCRIBE = 1, UNSUBSCRIBE = 2, CLOSED = 3
+ *     string topic = 4;     // Topic name, on SUBSCRIBE only
+ *   }
+ * Topic IDs are assigned by the client in subscribe(). The server answers
+ * with DATA frames for that ID until the client sends UNSUBSCRIBE or the
+ * server sends CLOSED.
+ *
+ * Inbound frames are routed on the stream's reader thread into per-topic
+ * queues. Topics subscribed with a Callable get it called on the main
+ * thread once per frame with every payload queued since; topics without
+ * one are drained with poll().
+ */
+class GrpcMux : public godot::RefCounted {
+    GDCLASS(GrpcMux, godot::RefCounted)
+
+public:
+    GrpcMux() = default;
+    ~GrpcMux();
+
+    /**
+     * Open the underlying bidirectional stream.
+     *
+     * @param client Connected GrpcClient
+     * @param full_method Mux endpoint, e.g. "/game.Realtime/Mux"
+     * @param call_opts Same keys as GrpcClient.bidi_stream_start()
+     * @return true if the stream started
+     */
+    bool open(const godot::Ref<GrpcClient>& client, const godot::String& full_method,
+              const godot::Variant& call_opts = godot::Variant());
+
+    /**
+     * Cancel the stream and drop all topics.
+     */
+    void close();
+
+    bool is_open() const;
+
+    /**
+     * Subscribe to a topic.
+     *
+     * @param topic Topic name sent to the server
+     * @param callback Called as callback(payload: PackedByteArray) on the
+     *   main thread; leave empty to poll() instead
+     * @param request Optional payload sent with the SUBSCRIBE frame
+     * @return Topic ID (positive integer), or -1 if the mux is not open
+     */
+    int subscribe(const godot::String& topic, const godot::Callable& callback = godot::Callable(),
+                  const godot::PackedByteArray& request = godot::PackedByteArray());
+
+    /**
+     * Unsubscribe from a topic. Payloads still queued for it are dropped.
+     */
+    void unsubscribe(int topic_id);
+
+    /**
+     * Send a DATA frame for a topic to the server.
+     */
+    bool send(int topic_id, const godot::PackedByteArray& payload);
+
+    /**
+     * Take every payload queued for a topic without a callback.
+     *
+     * @return Array of PackedByteArray, oldest first
+     */
+    godot::Array poll(int topic_id);
+
+    int get_topic_count() const;
+    int64_t get_stream_id() const;
+
+protected:
+    static void _bind_methods();
+
+private:
+    enum Control {
+        CONTROL_DATA = 0,
+        CONTROL_SUBSCRIBE = 1,
+        CONTROL_UNSUBSCRIBE = 2,
+        CONTROL_CLOSED = 3
+    };
+
+    struct Topic {
+        godot::String name;
+        godot::Callable callback;
+        std::deque<godot::PackedByteArray> queue;
+        bool dispatch_pending = false;
+    };
+
+    // Reader thread
+    bool on_frame(GrpcStream& stream, const grpc::ByteBuffer& buffer);
+    void route_frame(const uint8_t* data, size_t size);
+
+    // Main thread (deferred)
+    void _dispatch(int topic_id);
+    void _topic_closed(int topic_id);
+    void _on_stream_end(int64_t stream_id, int status_code, const godot::String& message);
+    void disconnect_client_signals();
+
+    static godot::PackedByteArray make_frame(int topic_id, Control control, const godot::String& topic,
+                                             const godot::PackedByteArray& payload);
+
+    godot::Ref<GrpcClient> client_;
+    int64_t stream_id_ = -1;
+    int next_topic_id_ = 1;
+
+    mutable std::mutex topics_mutex_;
+    std::map<int, Topic> topics_;
+    std::vector<uint8_t> scratch_; // Reader thread only
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_MUX_H
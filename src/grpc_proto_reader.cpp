@@ -0,0 +1,399 @@
+#include "grpc_proto_reader.h"
+#include "util/varint_decode.h"
+#include "util/status_map.h"
+#include <godot_cpp/core/class_db.hpp>
+
+namespace godot_grpc {
+
+void GrpcProtoReader::_bind_methods() {
+    // Input management
+    godot::ClassDB::bind_method(godot::D_METHOD("set_bytes", "bytes"), &GrpcProtoReader::set_bytes);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_position"), &GrpcProtoReader::get_position);
+    godot::ClassDB::bind_method(godot::D_METHOD("is_at_end"), &GrpcProtoReader::is_at_end);
+    godot::ClassDB::bind_method(godot::D_METHOD("has_error"), &GrpcProtoReader::has_error);
+
+    // Field iteration
+    godot::ClassDB::bind_method(godot::D_METHOD("next_field"), &GrpcProtoReader::next_field);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_field_number"), &GrpcProtoReader::get_field_number);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_wire_type"), &GrpcProtoReader::get_wire_type);
+    godot::ClassDB::bind_method(godot::D_METHOD("skip"), &GrpcProtoReader::skip);
+
+    // Scalar fields
+    godot::ClassDB::bind_method(godot::D_METHOD("read_varint"), &GrpcProtoReader::read_varint);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_sint"), &GrpcProtoReader::read_sint);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_bool"), &GrpcProtoReader::read_bool);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_fixed32"), &GrpcProtoReader::read_fixed32);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_sfixed32"), &GrpcProtoReader::read_sfixed32);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_fixed64"), &GrpcProtoReader::read_fixed64);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_float"), &GrpcProtoReader::read_float);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_double"), &GrpcProtoReader::read_double);
+
+    // Length-delimited fields
+    godot::ClassDB::bind_method(godot::D_METHOD("read_string"), &GrpcProtoReader::read_string);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_bytes"), &GrpcProtoReader::read_bytes);
+
+    // Packed repeated fields
+    godot::ClassDB::bind_method(godot::D_METHOD("read_packed_varint"), &GrpcProtoReader::read_packed_varint);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_packed_sint"), &GrpcProtoReader::read_packed_sint);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_packed_fixed32"), &GrpcProtoReader::read_packed_fixed32);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_packed_fixed64"), &GrpcProtoReader::read_packed_fixed64);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_packed_float32"), &GrpcProtoReader::read_packed_float32);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_packed_float64"), &GrpcProtoReader::read_packed_float64);
+    godot::ClassDB::bind_static_method(get_class_static(), godot::D_METHOD("decode_packed_varints", "bytes", "offset", "length", "zigzag"), &GrpcProtoReader::decode_packed_varints, DEFVAL(false));
+
+    // Wire type constants
+    godot::ClassDB::bind_integer_constant(get_class_static(), "WireType", "WIRE_VARINT", wire::VARINT);
+    godot::ClassDB::bind_integer_constant(get_class_static(), "WireType", "WIRE_FIXED64", wire::FIXED64);
+    godot::ClassDB::bind_integer_constant(get_class_static(), "WireType", "WIRE_LENGTH_DELIMITED", wire::LENGTH_DELIMITED);
+    godot::ClassDB::bind_integer_constant(get_class_static(), "WireType", "WIRE_START_GROUP", wire::START_GROUP);
+    godot::ClassDB::bind_integer_constant(get_class_static(), "WireType", "WIRE_END_GROUP", wire::END_GROUP);
+    godot::ClassDB::bind_integer_constant(get_class_static(), "WireType", "WIRE_FIXED32", wire::FIXED32);
+}
+
+void GrpcProtoReader::set_bytes(const godot::PackedByteArray& bytes) {
+    bytes_ = bytes;
+    pos_ = 0;
+    field_number_ = 0;
+    wire_type_ = 0;
+    error_ = false;
+}
+
+int GrpcProtoReader::get_position() const {
+    return static_cast<int>(pos_);
+}
+
+bool GrpcProtoReader::is_at_end() const {
+    return error_ || pos_ >= static_cast<size_t>(bytes_.size());
+}
+
+bool GrpcProtoReader::has_error() const {
+    return error_;
+}
+
+void GrpcProtoReader::fail(const char* what) {
+    if (!error_) {
+        Logger::error(std::string("GrpcProtoReader: ") + what + " at offset " + std::to_string(pos_));
+    }
+    error_ = true;
+    pos_ = static_cast<size_t>(bytes_.size());
+}
+
+bool GrpcProtoReader::next_field() {
+    if (is_at_end()) {
+        return false;
+    }
+
+    uint64_t tag;
+    if (!wire::decode_varint(bytes_.ptr(), bytes_.size(), &pos_, &tag)) {
+        fail("truncated tag");
+        return false;
+    }
+
+    field_number_ = static_cast<uint32_t>(tag >> 3);
+    wire_type_ = static_cast<uint32_t>(tag & 0x7);
+    if (field_number_ == 0) {
+        fail("invalid field number 0");
+        return false;
+    }
+    return true;
+}
+
+int GrpcProtoReader::get_field_number() const {
+    return static_cast<int>(field_number_);
+}
+
+int GrpcProtoReader::get_wire_type() const {
+    return static_cast<int>(wire_type_);
+}
+
+void GrpcProtoReader::skip() {
+    if (error_) {
+        return;
+    }
+    if (!wire::skip_field(bytes_.ptr(), bytes_.size(), &pos_, wire_type_, field_number_)) {
+        fail("malformed field while skipping");
+    }
+}
+
+bool GrpcProtoReader::expect_wire_type(wire::WireType expected) {
+    if (error_) {
+        return false;
+    }
+    if (wire_type_ != expected) {
+        fail("unexpected wire type");
+        return false;
+    }
+    return true;
+}
+
+int64_t GrpcProtoReader::read_varint() {
+    if (!expect_wire_type(wire::VARINT)) {
+        return 0;
+    }
+    uint64_t value;
+    if (!wire::decode_varint(bytes_.ptr(), bytes_.size(), &pos_, &value)) {
+        fail("truncated varint");
+        return 0;
+    }
+    return static_cast<int64_t>(value);
+}
+
+int64_t GrpcProtoReader::read_sint() {
+    return wire::zigzag_decode(static_cast<uint64_t>(read_varint()));
+}
+
+bool GrpcProtoReader::read_bool() {
+    return read_varint() != 0;
+}
+
+int64_t GrpcProtoReader::read_fixed32() {
+    if (!expect_wire_type(wire::FIXED32)) {
+        return 0;
+    }
+    if (static_cast<size_t>(bytes_.size()) - pos_ < 4) {
+        fail("truncated fixed32");
+        return 0;
+    }
+    uint32_t value = wire::load_fixed32(bytes_.ptr() + pos_);
+    pos_ += 4;
+    return static_cast<int64_t>(value);
+}
+
+int64_t GrpcProtoReader::read_sfixed32() {
+    return static_cast<int32_t>(static_cast<uint32_t>(read_fixed32()));
+}
+
+int64_t GrpcProtoReader::read_fixed64() {
+    if (!expect_wire_type(wire::FIXED64)) {
+        return 0;
+    }
+    if (static_cast<size_t>(bytes_.size()) - pos_ < 8) {
+        fail("truncated fixed64");
+        return 0;
+    }
+    uint64_t value = wire::load_fixed64(bytes_.ptr() + pos_);
+    pos_ += 8;
+    return static_cast<int64_t>(value);
+}
+
+double GrpcProtoReader::read_float() {
+    return wire::bits_to_float(static_cast<uint32_t>(read_fixed32()));
+}
+
+double GrpcProtoReader::read_double() {
+    return wire::bits_to_double(static_cast<uint64_t>(read_fixed64()));
+}
+
+bool GrpcProtoReader::read_length_delimited(const uint8_t** out_data, size_t* out_size) {
+    if (!expect_wire_type(wire::LENGTH_DELIMITED)) {
+        return false;
+    }
+    size_t size = static_cast<size_t>(bytes_.size());
+    uint64_t length;
+    if (!wire::decode_varint(bytes_.ptr(), size, &pos_, &length) || length > size - pos_) {
+        fail("truncated length-delimited field");
+        return false;
+    }
+    *out_data = bytes_.ptr() + pos_;
+    *out_size = static_cast<size_t>(length);
+    pos_ += static_cast<size_t>(length);
+    return true;
+}
+
+godot::String GrpcProtoReader::read_string() {
+    const uint8_t* data;
+    size_t size;
+    if (!read_length_delimited(&data, &size)) {
+        return godot::String();
+    }
+    return godot::String::utf8(reinterpret_cast<const char*>(data), static_cast<int64_t>(size));
+}
+
+godot::PackedByteArray GrpcProtoReader::read_bytes() {
+    godot::PackedByteArray result;
+    const uint8_t* data;
+    size_t size;
+    if (!read_length_delimited(&data, &size)) {
+        return result;
+    }
+    result.resize(size);
+    if (size > 0) {
+        memcpy(result.ptrw(), data, size);
+    }
+    return result;
+}
+
+bool GrpcProtoReader::read_packed_span(wire::WireType element_type, const uint8_t** out_data, size_t* out_size) {
+    if (error_) {
+        return false;
+    }
+
+    // Packed encoding: one length-delimited blob of elements
+    if (wire_type_ == wire::LENGTH_DELIMITED) {
+        return read_length_delimited(out_data, out_size);
+    }
+
+    // Unpacked encoding: a single element carried by this tag
+    if (wire_type_ != element_type) {
+        fail("unexpected wire type for repeated field");
+        return false;
+    }
+    size_t start = pos_;
+    skip();
+    if (error_) {
+        return false;
+    }
+    *out_data = bytes_.ptr() + start;
+    *out_size = pos_ - start;
+    return true;
+}
+
+godot::PackedInt64Array GrpcProtoReader::read_packed_varint() {
+    godot::PackedInt64Array result;
+    const uint8_t* data;
+    size_t size;
+    if (!read_packed_span(wire::VARINT, &data, &size)) {
+        return result;
+    }
+    if (!decode_varint_run(data, size, false, result)) {
+        fail("malformed packed varint");
+        return godot::PackedInt64Array();
+    }
+    return result;
+}
+
+godot::PackedInt64Array GrpcProtoReader::read_packed_sint() {
+    godot::PackedInt64Array result;
+    const uint8_t* data;
+    size_t size;
+    if (!read_packed_span(wire::VARINT, &data, &size)) {
+        return result;
+    }
+    if (!decode_varint_run(data, size, true, result)) {
+        fail("malformed packed varint");
+        return godot::PackedInt64Array();
+    }
+    return result;
+}
+
+godot::PackedInt64Array GrpcProtoReader::decode_packed_varints(const godot::PackedByteArray& bytes, int64_t offset, int64_t length, bool zigzag) {
+    godot::PackedInt64Array result;
+    if (offset < 0 || length < 0 || offset > bytes.size() || length > bytes.size() - offset) {
+        Logger::error("decode_packed_varints: range [" + std::to_string(offset) + ", +" + std::to_string(length) +
+                      ") is outside the " + std::to_string(bytes.size()) + "-byte input");
+        return result;
+    }
+    if (!decode_varint_run(bytes.ptr() + offset, static_cast<size_t>(length), zigzag, result)) {
+        Logger::error("decode_packed_varints: malformed packed varint");
+        return godot::PackedInt64Array();
+    }
+    return result;
+}
+
+bool GrpcProtoReader::decode_varint_run(const uint8_t* data, size_t size, bool zigzag, godot::PackedInt64Array& out) {
+    size_t count;
+    if (!wire::count_varints(data, size, &count)) {
+        return false;
+    }
+    out.resize(static_cast<int64_t>(count));
+    if (count == 0) {
+        return true;
+    }
+
+    int64_t* values = out.ptrw();
+    if (!wire::decode_varints(data, size, reinterpret_cast<uint64_t*>(values), count)) {
+        return false;
+    }
+    if (zigzag) {
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = wire::zigzag_decode(static_cast<uint64_t>(values[i]));
+        }
+    }
+    return true;
+}
+
+godot::PackedInt64Array GrpcProtoReader::read_packed_fixed32() {
+    godot::PackedInt64Array result;
+    const uint8_t* data;
+    size_t size;
+    if (!read_packed_span(wire::FIXED32, &data, &size)) {
+        return result;
+    }
+    if (size % 4 != 0) {
+        fail("packed fixed32 length is not a multiple of 4");
+        return result;
+    }
+
+    size_t count = size / 4;
+    result.resize(count);
+    int64_t* out = result.ptrw();
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<int64_t>(wire::load_fixed32(data + i * 4));
+    }
+    return result;
+}
+
+godot::PackedInt64Array GrpcProtoReader::read_packed_fixed64() {
+    godot::PackedInt64Array result;
+    const uint8_t* data;
+    size_t size;
+    if (!read_packed_span(wire::FIXED64, &data, &size)) {
+        return result;
+    }
+    if (size % 8 != 0) {
+        fail("packed fixed64 length is not a multiple of 8");
+        return result;
+    }
+
+    size_t count = size / 8;
+    result.resize(count);
+    int64_t* out = result.ptrw();
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<int64_t>(wire::load_fixed64(data + i * 8));
+    }
+    return result;
+}
+
+godot::PackedFloat32Array GrpcProtoReader::read_packed_float32() {
+    godot::PackedFloat32Array result;
+    const uint8_t* data;
+    size_t size;
+    if (!read_packed_span(wire::FIXED32, &data, &size)) {
+        return result;
+    }
+    if (size % 4 != 0) {
+        fail("packed float length is not a multiple of 4");
+        return result;
+    }
+
+    size_t count = size / 4;
+    result.resize(count);
+    float* out = result.ptrw();
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = wire::bits_to_float(wire::load_fixed32(data + i * 4));
+    }
+    return result;
+}
+
+godot::PackedFloat64Array GrpcProtoReader::read_packed_float64() {
+    godot::PackedFloat64Array result;
+    const uint8_t* data;
+    size_t size;
+    if (!read_packed_span(wire::FIXED64, &data, &size)) {
+        return result;
+    }
+    if (size % 8 != 0) {
+        fail("packed double length is not a multiple of 8");
+        return result;
+    }
+
+    size_t count = size / 8;
+    result.resize(count);
+    double* out = result.ptrw();
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = wire::bits_to_double(wire::load_fixed64(data + i * 8));
+    }
+    return result;
+}
+
+} // namespace godot_grpc
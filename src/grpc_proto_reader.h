@@ -0,0 +1,99 @@
+#ifndef GODOT_GRPC_PROTO_READER_H
+#define GODOT_GRPC_PROTO_READER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "util/wire_format.h"
+
+namespace godot_grpc {
+
+/**
+ * GrpcProtoReader: Decodes protobuf wire-format messages from GDScript.
+ *
+ * Usage pattern:
+ *   var r := GrpcProtoReader.new()
+ *   r.set_bytes(data)
+ *   while r.next_field():
+ *       match r.get_field_number():
+ *           1: name = r.read_string()
+ *           2: value = r.read_double()
+ *           _: r.skip()
+ *
+ * Every field returned by next_field() must be consumed with exactly one
+ * read_* call or skip(). On malformed input the reader stops, has_error()
+ * returns true and subsequent reads return default values.
+ */
+class GrpcProtoReader : public godot::RefCounted {
+    GDCLASS(GrpcProtoReader, godot::RefCounted)
+
+public:
+    GrpcProtoReader() = default;
+    ~GrpcProtoReader() = default;
+
+    // Input management
+    void set_bytes(const godot::PackedByteArray& bytes);
+    int get_position() const;
+    bool is_at_end() const;
+    bool has_error() const;
+
+    // Field iteration
+    bool next_field();
+    int get_field_number() const;
+    int get_wire_type() const;
+    void skip();
+
+    // Scalar fields
+    int64_t read_varint();   // int32, int64, uint32, uint64, enum
+    int64_t read_sint();     // sint32, sint64 (zigzag)
+    bool read_bool();
+    int64_t read_fixed32();  // fixed32 (unsigned)
+    int64_t read_sfixed32(); // sfixed32 (signed)
+    int64_t read_fixed64();  // fixed64, sfixed64
+    double read_float();
+    double read_double();
+
+    // Length-delimited fields
+    godot::String read_string();
+    godot::PackedByteArray read_bytes(); // bytes or nested message
+
+    // Packed repeated fields (also accept a single unpacked element)
+    godot::PackedInt64Array read_packed_varint();
+    godot::PackedInt64Array read_packed_sint();
+    godot::PackedInt64Array read_packed_fixed32();
+    godot::PackedInt64Array read_packed_fixed64();
+    godot::PackedFloat32Array read_packed_float32();
+    godot::PackedFloat64Array read_packed_float64();
+
+    /**
+     * Decode a packed varint run of `length` bytes starting at `offset`,
+     * without a reader instance. Uses the SSE4.1/AVX2 kernel when available.
+     *
+     * @param zigzag Decode as sint32/sint64
+     * @return Decoded values, or empty array on error
+     */
+    static godot::PackedInt64Array decode_packed_varints(const godot::PackedByteArray& bytes, int64_t offset, int64_t length, bool zigzag = false);
+
+protected:
+    static void _bind_methods();
+
+private:
+    void fail(const char* what);
+    bool expect_wire_type(wire::WireType expected);
+    bool read_length_delimited(const uint8_t** out_data, size_t* out_size);
+    bool read_packed_span(wire::WireType element_type, const uint8_t** out_data, size_t* out_size);
+    static bool decode_varint_run(const uint8_t* data, size_t size, bool zigzag, godot::PackedInt64Array& out);
+
+    godot::PackedByteArray bytes_;
+    size_t pos_ = 0;
+    uint32_t field_number_ = 0;
+    uint32_t wire_type_ = 0;
+    bool error_ = false;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_PROTO_READER_H
@@ -0,0 +1,236 @@
+#include "grpc_proto_writer.h"
+#include "util/status_map.h"
+#include <godot_cpp/core/class_db.hpp>
+
+namespace godot_grpc {
+
+// Largest field number allowed by the protobuf spec (2^29 - 1).
+static constexpr int MAX_FIELD_NUMBER = 536870911;
+
+void GrpcProtoWriter::_bind_methods() {
+    // Buffer management
+    godot::ClassDB::bind_method(godot::D_METHOD("clear"), &GrpcProtoWriter::clear);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_size"), &GrpcProtoWriter::get_size);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_bytes"), &GrpcProtoWriter::get_bytes);
+
+    // Scalar fields
+    godot::ClassDB::bind_method(godot::D_METHOD("write_varint", "field_number", "value"), &GrpcProtoWriter::write_varint);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_sint", "field_number", "value"), &GrpcProtoWriter::write_sint);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_bool", "field_number", "value"), &GrpcProtoWriter::write_bool);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_fixed32", "field_number", "value"), &GrpcProtoWriter::write_fixed32);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_fixed64", "field_number", "value"), &GrpcProtoWriter::write_fixed64);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_float", "field_number", "value"), &GrpcProtoWriter::write_float);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_double", "field_number", "value"), &GrpcProtoWriter::write_double);
+
+    // Length-delimited fields
+    godot::ClassDB::bind_method(godot::D_METHOD("write_string", "field_number", "value"), &GrpcProtoWriter::write_string);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_bytes", "field_number", "value"), &GrpcProtoWriter::write_bytes);
+
+    // Packed repeated fields
+    godot::ClassDB::bind_method(godot::D_METHOD("write_packed_varint", "field_number", "values"), &GrpcProtoWriter::write_packed_varint);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_packed_sint", "field_number", "values"), &GrpcProtoWriter::write_packed_sint);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_packed_fixed32", "field_number", "values"), &GrpcProtoWriter::write_packed_fixed32);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_packed_fixed64", "field_number", "values"), &GrpcProtoWriter::write_packed_fixed64);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_packed_float32", "field_number", "values"), &GrpcProtoWriter::write_packed_float32);
+    godot::ClassDB::bind_method(godot::D_METHOD("write_packed_float64", "field_number", "values"), &GrpcProtoWriter::write_packed_float64);
+}
+
+void GrpcProtoWriter::clear() {
+    buffer_.clear();
+}
+
+int GrpcProtoWriter::get_size() const {
+    return static_cast<int>(buffer_.size());
+}
+
+godot::PackedByteArray GrpcProtoWriter::get_bytes() const {
+    godot::PackedByteArray bytes;
+    bytes.resize(buffer_.size());
+    if (buffer_.size() > 0) {
+        memcpy(bytes.ptrw(), buffer_.data(), buffer_.size());
+    }
+    return bytes;
+}
+
+bool GrpcProtoWriter::check_field_number(int field_number) const {
+    if (field_number < 1 || field_number > MAX_FIELD_NUMBER) {
+        Logger::error("GrpcProtoWriter: invalid field number " + std::to_string(field_number));
+        return false;
+    }
+    return true;
+}
+
+void GrpcProtoWriter::write_varint(int field_number, int64_t value) {
+    if (!check_field_number(field_number)) {
+        return;
+    }
+    buffer_.put_tag(field_number, wire::VARINT);
+    buffer_.put_varint(static_cast<uint64_t>(value));
+}
+
+void GrpcProtoWriter::write_sint(int field_number, int64_t value) {
+    if (!check_field_number(field_number)) {
+        return;
+    }
+    buffer_.put_tag(field_number, wire::VARINT);
+    buffer_.put_varint(wire::zigzag_encode(value));
+}
+
+void GrpcProtoWriter::write_bool(int field_number, bool value) {
+    write_varint(field_number, value ? 1 : 0);
+}
+
+void GrpcProtoWriter::write_fixed32(int field_number, int64_t value) {
+    if (!check_field_number(field_number)) {
+        return;
+    }
+    buffer_.put_tag(field_number, wire::FIXED32);
+    buffer_.put_fixed32(static_cast<uint32_t>(value));
+}
+
+void GrpcProtoWriter::write_fixed64(int field_number, int64_t value) {
+    if (!check_field_number(field_number)) {
+        return;
+    }
+    buffer_.put_tag(field_number, wire::FIXED64);
+    buffer_.put_fixed64(static_cast<uint64_t>(value));
+}
+
+void GrpcProtoWriter::write_float(int field_number, double value) {
+    if (!check_field_number(field_number)) {
+        return;
+    }
+    buffer_.put_tag(field_number, wire::FIXED32);
+    buffer_.put_fixed32(wire::float_bits(static_cast<float>(value)));
+}
+
+void GrpcProtoWriter::write_double(int field_number, double value) {
+    if (!check_field_number(field_number)) {
+        return;
+    }
+    buffer_.put_tag(field_number, wire::FIXED64);
+    buffer_.put_fixed64(wire::double_bits(value));
+}
+
+void GrpcProtoWriter::write_string(int field_number, const godot::String& value) {
+    if (!check_field_number(field_number)) {
+        return;
+    }
+    godot::CharString utf8 = value.utf8();
+    size_t length = static_cast<size_t>(utf8.length());
+    buffer_.put_tag(field_number, wire::LENGTH_DELIMITED);
+    buffer_.put_varint(length);
+    buffer_.put_bytes(reinterpret_cast<const uint8_t*>(utf8.get_data()), length);
+}
+
+void GrpcProtoWriter::write_bytes(int field_number, const godot::PackedByteArray& value) {
+    if (!check_field_number(field_number)) {
+        return;
+    }
+    size_t length = static_cast<size_t>(value.size());
+    buffer_.put_tag(field_number, wire::LENGTH_DELIMITED);
+    buffer_.put_varint(length);
+    buffer_.put_bytes(value.ptr(), length);
+}
+
+void GrpcProtoWriter::write_packed_varint(int field_number, const godot::PackedInt64Array& values) {
+    if (!check_field_number(field_number) || values.size() == 0) {
+        return;
+    }
+    const int64_t* ptr = values.ptr();
+    int64_t count = values.size();
+
+    size_t payload = 0;
+    for (int64_t i = 0; i < count; ++i) {
+        payload += wire::varint_size(static_cast<uint64_t>(ptr[i]));
+    }
+
+    buffer_.put_tag(field_number, wire::LENGTH_DELIMITED);
+    buffer_.put_varint(payload);
+    buffer_.reserve(buffer_.size() + payload);
+    for (int64_t i = 0; i < count; ++i) {
+        buffer_.put_varint(static_cast<uint64_t>(ptr[i]));
+    }
+}
+
+void GrpcProtoWriter::write_packed_sint(int field_number, const godot::PackedInt64Array& values) {
+    if (!check_field_number(field_number) || values.size() == 0) {
+        return;
+    }
+    const int64_t* ptr = values.ptr();
+    int64_t count = values.size();
+
+    size_t payload = 0;
+    for (int64_t i = 0; i < count; ++i) {
+        payload += wire::varint_size(wire::zigzag_encode(ptr[i]));
+    }
+
+    buffer_.put_tag(field_number, wire::LENGTH_DELIMITED);
+    buffer_.put_varint(payload);
+    buffer_.reserve(buffer_.size() + payload);
+    for (int64_t i = 0; i < count; ++i) {
+        buffer_.put_varint(wire::zigzag_encode(ptr[i]));
+    }
+}
+
+void GrpcProtoWriter::write_packed_fixed32(int field_number, const godot::PackedInt64Array& values) {
+    if (!check_field_number(field_number) || values.size() == 0) {
+        return;
+    }
+    const int64_t* ptr = values.ptr();
+    int64_t count = values.size();
+
+    buffer_.put_tag(field_number, wire::LENGTH_DELIMITED);
+    buffer_.put_varint(static_cast<uint64_t>(count) * 4);
+    buffer_.reserve(buffer_.size() + static_cast<size_t>(count) * 4);
+    for (int64_t i = 0; i < count; ++i) {
+        buffer_.put_fixed32(static_cast<uint32_t>(ptr[i]));
+    }
+}
+
+void GrpcProtoWriter::write_packed_fixed64(int field_number, const godot::PackedInt64Array& values) {
+    if (!check_field_number(field_number) || values.size() == 0) {
+        return;
+    }
+    const int64_t* ptr = values.ptr();
+    int64_t count = values.size();
+
+    buffer_.put_tag(field_number, wire::LENGTH_DELIMITED);
+    buffer_.put_varint(static_cast<uint64_t>(count) * 8);
+    buffer_.reserve(buffer_.size() + static_cast<size_t>(count) * 8);
+    for (int64_t i = 0; i < count; ++i) {
+        buffer_.put_fixed64(static_cast<uint64_t>(ptr[i]));
+    }
+}
+
+void GrpcProtoWriter::write_packed_float32(int field_number, const godot::PackedFloat32Array& values) {
+    if (!check_field_number(field_number) || values.size() == 0) {
+        return;
+    }
+    const float* ptr = values.ptr();
+    int64_t count = values.size();
+
+    buffer_.put_tag(field_number, wire::LENGTH_DELIMITED);
+    buffer_.put_varint(static_cast<uint64_t>(count) * 4);
+    buffer_.reserve(buffer_.size() + static_cast<size_t>(count) * 4);
+    for (int64_t i = 0; i < count; ++i) {
+        buffer_.put_fixed32(wire::float_bits(ptr[i]));
+    }
+}
+
+void GrpcProtoWriter::write_packed_float64(int field_number, const godot::PackedFloat64Array& values) {
+    if (!check_field_number(field_number) || values.size() == 0) {
+        return;
+    }
+    const double* ptr = values.ptr();
+    int64_t count = values.size();
+
+    buffer_.put_tag(field_number, wire::LENGTH_DELIMITED);
+    buffer_.put_varint(static_cast<uint64_t>(count) * 8);
+    buffer_.reserve(buffer_.size() + static_cast<size_t>(count) * 8);
+    for (int64_t i = 0; i < count; ++i) {
+        buffer_.put_fixed64(wire::double_bits(ptr[i]));
+    }
+}
+
+} // namespace godot_grpc
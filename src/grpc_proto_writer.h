@@ -0,0 +1,71 @@
+#ifndef GODOT_GRPC_PROTO_WRITER_H
+#define GODOT_GRPC_PROTO_WRITER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "util/wire_format.h"
+
+namespace godot_grpc {
+
+/**
+ * GrpcProtoWriter: Encodes protobuf wire-format messages from GDScript.
+ *
+ * Each write_* method appends one complete field (tag + value) to an
+ * internal growable buffer. Call get_bytes() to obtain the message and
+ * clear() to reuse the writer (the buffer allocation is kept).
+ *
+ * Example (MetricsRequest { int32 interval_ms = 1; int32 count = 2; }):
+ *   var w := GrpcProtoWriter.new()
+ *   w.write_varint(1, 500)
+ *   w.write_varint(2, 5)
+ *   var bytes := w.get_bytes()
+ */
+class GrpcProtoWriter : public godot::RefCounted {
+    GDCLASS(GrpcProtoWriter, godot::RefCounted)
+
+public:
+    GrpcProtoWriter() = default;
+    ~GrpcProtoWriter() = default;
+
+    // Buffer management
+    void clear();
+    int get_size() const;
+    godot::PackedByteArray get_bytes() const;
+
+    // Scalar fields
+    void write_varint(int field_number, int64_t value);   // int32, int64, uint32, uint64, enum
+    void write_sint(int field_number, int64_t value);     // sint32, sint64 (zigzag)
+    void write_bool(int field_number, bool value);
+    void write_fixed32(int field_number, int64_t value);  // fixed32, sfixed32
+    void write_fixed64(int field_number, int64_t value);  // fixed64, sfixed64
+    void write_float(int field_number, double value);
+    void write_double(int field_number, double value);
+
+    // Length-delimited fields
+    void write_string(int field_number, const godot::String& value);
+    void write_bytes(int field_number, const godot::PackedByteArray& value); // bytes or nested message
+
+    // Packed repeated fields
+    void write_packed_varint(int field_number, const godot::PackedInt64Array& values);
+    void write_packed_sint(int field_number, const godot::PackedInt64Array& values);
+    void write_packed_fixed32(int field_number, const godot::PackedInt64Array& values);
+    void write_packed_fixed64(int field_number, const godot::PackedInt64Array& values);
+    void write_packed_float32(int field_number, const godot::PackedFloat32Array& values);
+    void write_packed_float64(int field_number, const godot::PackedFloat64Array& values);
+
+protected:
+    static void _bind_methods();
+
+private:
+    bool check_field_number(int field_number) const;
+
+    wire::Buffer buffer_;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_PROTO_WRITER_H
@@ -0,0 +1,134 @@
+#include "grpc_recorder.h"
+#include "util/status_map.h"
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <cstring>
+
+namespace godot_grpc {
+
+namespace {
+
+std::string global_path(const godot::String& path) {
+    return godot::ProjectSettings::get_singleton()->globalize_path(path).utf8().get_data();
+}
+
+const char* kind_name(traffic::RecordKind kind) {
+    switch (kind) {
+        case traffic::CALL_START: return "call_start";
+        case traffic::SEND: return "send";
+        case traffic::RECEIVE: return "receive";
+        case traffic::FINISH: return "finish";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+GrpcRecorder::GrpcRecorder() = default;
+
+GrpcRecorder::~GrpcRecorder() {
+    stop();
+}
+
+void GrpcRecorder::_bind_methods() {
+    godot::ClassDB::bind_method(godot::D_METHOD("start", "path"), &GrpcRecorder::start);
+    godot::ClassDB::bind_method(godot::D_METHOD("stop"), &GrpcRecorder::stop);
+    godot::ClassDB::bind_method(godot::D_METHOD("is_recording"), &GrpcRecorder::is_recording);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_record_count"), &GrpcRecorder::get_record_count);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_bytes_written"), &GrpcRecorder::get_bytes_written);
+    godot::ClassDB::bind_method(godot::D_METHOD("read_log", "path"), &GrpcRecorder::read_log);
+}
+
+bool GrpcRecorder::start(const godot::String& path) {
+    stop();
+
+    // A fresh writer per recording: streams still holding the previous one
+    // write into a closed log, which drops their records
+    auto writer = std::make_shared<traffic::Writer>();
+    std::string error;
+    if (!writer->open(global_path(path), &error)) {
+        Logger::error("GrpcRecorder: " + error);
+        return false;
+    }
+    writer_ = writer;
+    Logger::info("GrpcRecorder: recording to " + global_path(path));
+    return true;
+}
+
+void GrpcRecorder::stop() {
+    if (writer_) {
+        writer_->close();
+        Logger::info("GrpcRecorder: stopped after " + std::to_string(writer_->get_record_count()) + " records");
+        writer_.reset();
+    }
+}
+
+bool GrpcRecorder::is_recording() const {
+    return writer_ != nullptr;
+}
+
+int64_t GrpcRecorder::get_record_count() const {
+    return writer_ ? static_cast<int64_t>(writer_->get_record_count()) : 0;
+}
+
+int64_t GrpcRecorder::get_bytes_written() const {
+    return writer_ ? static_cast<int64_t>(writer_->get_bytes_written()) : 0;
+}
+
+std::shared_ptr<traffic::Writer> GrpcRecorder::get_writer() const {
+    return writer_;
+}
+
+godot::Array GrpcRecorder::read_log(const godot::String& path) const {
+    godot::Array records;
+    traffic::Reader reader;
+    std::string error;
+    if (!reader.open(global_path(path), &error)) {
+        Logger::error("GrpcRecorder: " + error);
+        return records;
+    }
+
+    traffic::Record record;
+    while (reader.next(&record)) {
+        godot::Dictionary entry;
+        entry["kind"] = kind_name(record.kind);
+        entry["time_us"] = static_cast<int64_t>(record.time_us);
+        entry["call_id"] = static_cast<int64_t>(record.call_id);
+        switch (record.kind) {
+            case traffic::CALL_START: {
+                godot::Dictionary metadata;
+                for (const auto& pair : record.metadata) {
+                    metadata[godot::String::utf8(pair.first.c_str())] = godot::String::utf8(pair.second.c_str());
+                }
+                entry["method"] = godot::String::utf8(record.method.c_str());
+                entry["call_type"] = static_cast<int>(record.call_type);
+                entry["stream_id"] = record.stream_id;
+                entry["metadata"] = metadata;
+                break;
+            }
+            case traffic::SEND:
+            case traffic::RECEIVE: {
+                godot::PackedByteArray payload;
+                payload.resize(static_cast<int64_t>(record.payload.size()));
+                if (!record.payload.empty()) {
+                    memcpy(payload.ptrw(), record.payload.data(), record.payload.size());
+                }
+                entry["payload"] = payload;
+                break;
+            }
+            case traffic::FINISH:
+                entry["status_code"] = record.status_code;
+                entry["message"] = godot::String::utf8(record.message.c_str());
+                break;
+        }
+        records.append(entry);
+    }
+    if (!reader.error().empty()) {
+        Logger::error("GrpcRecorder: " + reader.error());
+    }
+    return records;
+}
+
+} // namespace godot_grpc
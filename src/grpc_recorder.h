@@ -0,0 +1,67 @@
+#ifndef GODOT_GRPC_RECORDER_H
+#define GODOT_GRPC_RECORDER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "util/traffic_log.h"
+#include <memory>
+
+namespace godot_grpc {
+
+/**
+ * GrpcRecorder: Captures a client's wire traffic into a binary log.
+ *
+ * Assign it to GrpcClient.recorder and call start(). Every unary request and
+ * response, every stream start, sent and received stream message, and every
+ * final status is written with its method, metadata, timestamp and payload
+ * (format in util/traffic_log.h). Received messages are recorded on the
+ * reader thread before any call-option handler sees them, so a log holds
+ * exactly what came off the wire.
+ *
+ * Feed a log back with GrpcClient.replay_start() to profile message handling
+ * offline, or inspect it with read_log().
+ */
+class GrpcRecorder : public godot::RefCounted {
+    GDCLASS(GrpcRecorder, godot::RefCounted)
+
+public:
+    GrpcRecorder();
+    ~GrpcRecorder();
+
+    /**
+     * Start recording into `path` (res://, user:// or absolute), replacing
+     * the file. Calls already in flight are not recorded.
+     */
+    bool start(const godot::String& path);
+
+    /**
+     * Flush and close the log.
+     */
+    void stop();
+
+    bool is_recording() const;
+    int64_t get_record_count() const;
+    int64_t get_bytes_written() const;
+
+    /**
+     * Decode a log into an Array of Dictionaries with kind ("call_start",
+     * "send", "receive" or "finish"), time_us and call_id, plus method,
+     * call_type, stream_id and metadata for call_start, payload for send and
+     * receive, and status_code and message for finish.
+     */
+    godot::Array read_log(const godot::String& path) const;
+
+    // Native API: the writer GrpcClient records into, or null when stopped
+    std::shared_ptr<traffic::Writer> get_writer() const;
+
+protected:
+    static void _bind_methods();
+
+private:
+    std::shared_ptr<traffic::Writer> writer_;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_RECORDER_H
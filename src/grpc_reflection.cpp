@@ -0,0 +1,244 @@
+#include "grpc_reflection.h"
+#include "util/status_map.h"
+#include "util/wire_format.h"
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <chrono>
+#include <deque>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace godot_grpc {
+
+namespace {
+
+const char* const REFLECTION_V1ALPHA = "/grpc.reflection.v1alpha.ServerReflection/ServerReflectionInfo";
+const char* const REFLECTION_V1 = "/grpc.reflection.v1.ServerReflection/ServerReflectionInfo";
+
+// ServerReflectionRequest fields
+constexpr uint32_t REQUEST_FILE_BY_FILENAME = 3;
+constexpr uint32_t REQUEST_FILE_CONTAINING_SYMBOL = 4;
+
+// ServerReflectionResponse fields
+constexpr uint32_t RESPONSE_FILE_DESCRIPTOR = 4;
+constexpr uint32_t RESPONSE_ERROR = 7;
+
+struct Span {
+    const uint8_t* data;
+    size_t size;
+};
+
+// Iterate the length-delimited occurrences of `field_number` in a message.
+template <typename Fn>
+bool for_each_bytes_field(const uint8_t* data, size_t size, uint32_t field_number, Fn&& fn) {
+    size_t pos = 0;
+    while (pos < size) {
+        uint64_t tag;
+        if (!wire::decode_varint(data, size, &pos, &tag)) {
+            return false;
+        }
+        uint32_t field = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+        if (field == field_number && wire_type == wire::LENGTH_DELIMITED) {
+            uint64_t length;
+            if (!wire::decode_varint(data, size, &pos, &length) || length > size - pos) {
+                return false;
+            }
+            fn(Span{data + pos, static_cast<size_t>(length)});
+            pos += static_cast<size_t>(length);
+        } else if (!wire::skip_field(data, size, &pos, wire_type, field)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+grpc::ByteBuffer make_request(uint32_t field_number, const std::string& value) {
+    wire::Buffer buffer;
+    buffer.put_tag(field_number, wire::LENGTH_DELIMITED);
+    buffer.put_varint(value.size());
+    buffer.put_bytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+
+    grpc::Slice slice(buffer.data(), buffer.size());
+    return grpc::ByteBuffer(&slice, 1);
+}
+
+std::string flatten(grpc::ByteBuffer& buffer) {
+    std::vector<grpc::Slice> slices;
+    (void)buffer.Dump(&slices);
+
+    std::string result;
+    result.reserve(buffer.Length());
+    for (const auto& slice : slices) {
+        result.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+    }
+    return result;
+}
+
+std::string parse_error_response(Span span) {
+    int64_t code = 0;
+    std::string message;
+    size_t pos = 0;
+    while (pos < span.size) {
+        uint64_t tag;
+        if (!wire::decode_varint(span.data, span.size, &pos, &tag)) {
+            break;
+        }
+        uint32_t field = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+        if (field == 1 && wire_type == wire::VARINT) {
+            uint64_t value;
+            if (!wire::decode_varint(span.data, span.size, &pos, &value)) {
+                break;
+            }
+            code = static_cast<int64_t>(value);
+        } else if (field == 2 && wire_type == wire::LENGTH_DELIMITED) {
+            uint64_t length;
+            if (!wire::decode_varint(span.data, span.size, &pos, &length) || length > span.size - pos) {
+                break;
+            }
+            message.assign(reinterpret_cast<const char*>(span.data + pos), static_cast<size_t>(length));
+            pos += static_cast<size_t>(length);
+        } else if (!wire::skip_field(span.data, span.size, &pos, wire_type, field)) {
+            break;
+        }
+    }
+    return "reflection error " + std::to_string(code) + ": " + message;
+}
+
+} // namespace
+
+bool GrpcReflection::fetch_descriptor_set(
+    const std::shared_ptr<grpc::GenericStub>& stub,
+    const std::string& symbol,
+    int timeout_ms,
+    std::string* out_descriptor_set,
+    std::string* out_error
+) {
+    grpc::Status status = run_exchange(stub, REFLECTION_V1ALPHA, symbol, timeout_ms, out_descriptor_set, out_error);
+    if (status.error_code() == grpc::StatusCode::UNIMPLEMENTED) {
+        Logger::debug("v1alpha reflection unavailable, trying grpc.reflection.v1");
+        out_error->clear();
+        status = run_exchange(stub, REFLECTION_V1, symbol, timeout_ms, out_descriptor_set, out_error);
+    }
+
+    if (!status.ok()) {
+        if (out_error->empty()) {
+            *out_error = StatusMap::format_error(status);
+        }
+        return false;
+    }
+    return out_error->empty();
+}
+
+grpc::Status GrpcReflection::run_exchange(
+    const std::shared_ptr<grpc::GenericStub>& stub,
+    const std::string& method,
+    const std::string& symbol,
+    int timeout_ms,
+    std::string* out_descriptor_set,
+    std::string* out_error
+) {
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(timeout_ms));
+
+    grpc::CompletionQueue cq;
+    std::unique_ptr<grpc::GenericClientAsyncReaderWriter> call(stub->PrepareCall(&context, method, &cq));
+
+    void* got_tag;
+    bool ok = false;
+    call->StartCall((void*)1);
+    cq.Next(&got_tag, &ok);
+
+    // Files in arrival order, keyed by name to resolve imports
+    std::vector<google::protobuf::FileDescriptorProto> files;
+    std::set<std::string> received;
+    std::set<std::string> requested;
+    std::deque<std::pair<uint32_t, std::string>> pending;
+    pending.emplace_back(REQUEST_FILE_CONTAINING_SYMBOL, symbol);
+
+    while (ok && !pending.empty() && out_error->empty()) {
+        auto request = pending.front();
+        pending.pop_front();
+
+        // Servers usually send transitive imports along with the first file
+        if (request.first == REQUEST_FILE_BY_FILENAME && received.count(request.second)) {
+            continue;
+        }
+
+        call->Write(make_request(request.first, request.second), (void*)2);
+        cq.Next(&got_tag, &ok);
+        if (!ok) {
+            break;
+        }
+
+        grpc::ByteBuffer response_buffer;
+        call->Read(&response_buffer, (void*)3);
+        cq.Next(&got_tag, &ok);
+        if (!ok) {
+            break;
+        }
+
+        std::string response = flatten(response_buffer);
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(response.data());
+
+        bool parsed = for_each_bytes_field(data, response.size(), RESPONSE_ERROR, [&](Span span) {
+            *out_error = parse_error_response(span);
+        });
+        parsed = parsed && for_each_bytes_field(data, response.size(), RESPONSE_FILE_DESCRIPTOR, [&](Span file_response) {
+            for_each_bytes_field(file_response.data, file_response.size, 1, [&](Span file_bytes) {
+                google::protobuf::FileDescriptorProto file;
+                if (!file.ParseFromArray(file_bytes.data, static_cast<int>(file_bytes.size))) {
+                    *out_error = "malformed FileDescriptorProto in reflection response";
+                    return;
+                }
+                if (!received.insert(file.name()).second) {
+                    return;
+                }
+                for (const auto& dependency : file.dependency()) {
+                    if (!received.count(dependency) && requested.insert(dependency).second) {
+                        pending.emplace_back(REQUEST_FILE_BY_FILENAME, dependency);
+                    }
+                }
+                files.push_back(std::move(file));
+            });
+        });
+        if (!parsed && out_error->empty()) {
+            *out_error = "malformed reflection response";
+        }
+    }
+
+    if (ok) {
+        call->WritesDone((void*)4);
+        cq.Next(&got_tag, &ok);
+    }
+
+    grpc::Status status;
+    call->Finish(&status, (void*)5);
+    cq.Next(&got_tag, &ok);
+
+    cq.Shutdown();
+    while (cq.Next(&got_tag, &ok)) {
+    }
+
+    if (!status.ok() || !out_error->empty()) {
+        return status;
+    }
+    if (files.empty()) {
+        *out_error = "server returned no descriptors for " + symbol;
+        return status;
+    }
+
+    google::protobuf::FileDescriptorSet file_set;
+    for (auto& file : files) {
+        *file_set.add_file() = std::move(file);
+    }
+    file_set.SerializeToString(out_descriptor_set);
+
+    Logger::debug("Reflection returned " + std::to_string(file_set.file_size()) + " files for " + symbol);
+    return status;
+}
+
+} // namespace godot_grpc
@@ -0,0 +1,53 @@
+#ifndef GODOT_GRPC_REFLECTION_H
+#define GODOT_GRPC_REFLECTION_H
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <memory>
+#include <string>
+
+namespace godot_grpc {
+
+/**
+ * Client for the gRPC server reflection protocol.
+ *
+ * Speaks grpc.reflection.v1alpha.ServerReflection (falling back to
+ * grpc.reflection.v1) over a generic bidi call, so no generated reflection
+ * stubs are needed. Reflection messages are encoded by hand with the
+ * wire-format helpers.
+ */
+class GrpcReflection {
+public:
+    /**
+     * Fetch the file that defines `symbol` (e.g. "helloworld.Greeter") and
+     * all of its transitive imports.
+     *
+     * @param stub Generic stub of an open channel
+     * @param symbol Fully-qualified service or message name
+     * @param timeout_ms Deadline for the whole exchange
+     * @param out_descriptor_set Receives a serialized FileDescriptorSet
+     * @param out_error Receives a description of the failure
+     * @return true on success
+     */
+    static bool fetch_descriptor_set(
+        const std::shared_ptr<grpc::GenericStub>& stub,
+        const std::string& symbol,
+        int timeout_ms,
+        std::string* out_descriptor_set,
+        std::string* out_error
+    );
+
+private:
+    static grpc::Status run_exchange(
+        const std::shared_ptr<grpc::GenericStub>& stub,
+        const std::string& method,
+        const std::string& symbol,
+        int timeout_ms,
+        std::string* out_descriptor_set,
+        std::string* out_error
+    );
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_REFLECTION_H
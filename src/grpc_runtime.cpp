@@ -0,0 +1,82 @@
+#include "grpc_runtime.h"
+#include "util/runtime_init.h"
+#include "util/status_map.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <cstdio>
+
+namespace godot_grpc {
+
+namespace {
+
+godot::Dictionary to_dictionary(const runtime::Timings& timings) {
+    godot::Dictionary result;
+    if (!timings.initialized) {
+        return result;
+    }
+    result["mode"] = godot::String(timings.mode.c_str());
+    result["core_ms"] = timings.core_ms;
+    result["resolver_ms"] = timings.resolver_ms;
+    result["tls_ms"] = timings.tls_ms;
+    result["total_ms"] = timings.total_ms;
+    return result;
+}
+
+void log_timings(const runtime::Timings& timings) {
+    char line[160];
+    std::snprintf(line, sizeof(line), "gRPC runtime initialized (%s) in %.1f ms: core %.1f, resolver %.1f, TLS %.1f",
+        timings.mode.c_str(), timings.total_ms, timings.core_ms, timings.resolver_ms, timings.tls_ms);
+    Logger::info(line);
+}
+
+} // namespace
+
+GrpcRuntime* GrpcRuntime::singleton_ = nullptr;
+
+GrpcRuntime* GrpcRuntime::get_singleton() {
+    return singleton_;
+}
+
+GrpcRuntime::GrpcRuntime() {
+    singleton_ = this;
+}
+
+GrpcRuntime::~GrpcRuntime() {
+    if (singleton_ == this) {
+        singleton_ = nullptr;
+    }
+}
+
+void GrpcRuntime::_bind_methods() {
+    godot::ClassDB::bind_method(godot::D_METHOD("initialize"), &GrpcRuntime::initialize);
+    godot::ClassDB::bind_method(godot::D_METHOD("initialize_async"), &GrpcRuntime::initialize_async);
+    godot::ClassDB::bind_method(godot::D_METHOD("is_initialized"), &GrpcRuntime::is_initialized);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_startup_timings"), &GrpcRuntime::get_startup_timings);
+
+    ADD_SIGNAL(godot::MethodInfo("initialized", godot::PropertyInfo(godot::Variant::DICTIONARY, "timings")));
+}
+
+godot::Dictionary GrpcRuntime::initialize() {
+    bool was_initialized = runtime::is_initialized();
+    runtime::Timings timings = runtime::initialize();
+    if (!was_initialized && timings.mode == "blocking") {
+        log_timings(timings);
+    }
+    return to_dictionary(timings);
+}
+
+bool GrpcRuntime::initialize_async() {
+    return runtime::initialize_async([this](const runtime::Timings& timings) {
+        log_timings(timings);
+        call_deferred("emit_signal", "initialized", to_dictionary(timings));
+    });
+}
+
+bool GrpcRuntime::is_initialized() const {
+    return runtime::is_initialized();
+}
+
+godot::Dictionary GrpcRuntime::get_startup_timings() const {
+    return to_dictionary(runtime::timings());
+}
+
+} // namespace godot_grpc
@@ -0,0 +1,57 @@
+#ifndef GODOT_GRPC_RUNTIME_H
+#define GODOT_GRPC_RUNTIME_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+namespace godot_grpc {
+
+/**
+ * GrpcRuntime: Engine singleton controlling when gRPC starts up.
+ *
+ * gRPC otherwise initializes piecemeal on the first connect() and the first
+ * connection, stalling whichever frame that lands on. initialize_async()
+ * brings the core, DNS resolver and TLS root store up on a background thread
+ * (e.g. during a splash screen) and emits `initialized` with the timings;
+ * set network/grpc/initialize_on_startup to start it as the extension loads.
+ * connect() waits for an initialization in progress rather than repeating it.
+ */
+class GrpcRuntime : public godot::Object {
+    GDCLASS(GrpcRuntime, godot::Object)
+
+public:
+    static GrpcRuntime* get_singleton();
+
+    GrpcRuntime();
+    ~GrpcRuntime();
+
+    /**
+     * Initialize on the calling thread; returns the timings (see
+     * get_startup_timings()). Waits for an initialization in progress.
+     */
+    godot::Dictionary initialize();
+
+    /**
+     * Initialize on a background thread and emit `initialized` on the main
+     * thread when done. Returns false if already started or done.
+     */
+    bool initialize_async();
+
+    bool is_initialized() const;
+
+    /**
+     * { mode: "blocking" | "async" | "on_demand", core_ms, resolver_ms,
+     * tls_ms, total_ms }, or empty before initialization has finished.
+     */
+    godot::Dictionary get_startup_timings() const;
+
+protected:
+    static void _bind_methods();
+
+private:
+    static GrpcRuntime* singleton_;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_RUNTIME_H
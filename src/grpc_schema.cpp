@@ -0,0 +1,860 @@
+#include "grpc_schema.h"
+#include "grpc_columnar.h"
+#include "util/status_map.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <google/protobuf/util/json_util.h>
+
+namespace godot_grpc {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+namespace {
+
+void collect_message_types(const google::protobuf::DescriptorProto& message, const std::string& prefix, std::vector<std::string>& out) {
+    std::string name = prefix.empty() ? message.name() : prefix + "." + message.name();
+    if (message.options().map_entry()) {
+        return;
+    }
+    out.push_back(name);
+    for (const auto& nested : message.nested_type()) {
+        collect_message_types(nested, name, out);
+    }
+}
+
+godot::String to_godot_string(const std::string& value) {
+    return godot::String::utf8(value.data(), static_cast<int64_t>(value.size()));
+}
+
+std::string to_std_string(const godot::String& value) {
+    godot::CharString utf8 = value.utf8();
+    return std::string(utf8.get_data(), static_cast<size_t>(utf8.length()));
+}
+
+std::string to_std_bytes(const godot::Variant& value) {
+    if (value.get_type() == godot::Variant::PACKED_BYTE_ARRAY) {
+        godot::PackedByteArray bytes = value;
+        return std::string(reinterpret_cast<const char*>(bytes.ptr()), static_cast<size_t>(bytes.size()));
+    }
+    return to_std_string(value);
+}
+
+// Read one (non-repeated) value of `field` from `message`.
+godot::Variant singular_to_variant(const LoadedSchema& schema, const MessageCodec::Field& field, const Message& message, const Reflection* reflection) {
+    const FieldDescriptor* fd = field.descriptor;
+    switch (fd->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_INT32:
+            return static_cast<int64_t>(reflection->GetInt32(message, fd));
+        case FieldDescriptor::CPPTYPE_INT64:
+            return reflection->GetInt64(message, fd);
+        case FieldDescriptor::CPPTYPE_UINT32:
+            return static_cast<int64_t>(reflection->GetUInt32(message, fd));
+        case FieldDescriptor::CPPTYPE_UINT64:
+            return static_cast<int64_t>(reflection->GetUInt64(message, fd));
+        case FieldDescriptor::CPPTYPE_DOUBLE:
+            return reflection->GetDouble(message, fd);
+        case FieldDescriptor::CPPTYPE_FLOAT:
+            return static_cast<double>(reflection->GetFloat(message, fd));
+        case FieldDescriptor::CPPTYPE_BOOL:
+            return reflection->GetBool(message, fd);
+        case FieldDescriptor::CPPTYPE_ENUM:
+            return static_cast<int64_t>(reflection->GetEnumValue(message, fd));
+        case FieldDescriptor::CPPTYPE_STRING: {
+            std::string scratch;
+            const std::string& value = reflection->GetStringReference(message, fd, &scratch);
+            if (fd->type() == FieldDescriptor::TYPE_BYTES) {
+                godot::PackedByteArray bytes;
+                bytes.resize(value.size());
+                if (!value.empty()) {
+                    memcpy(bytes.ptrw(), value.data(), value.size());
+                }
+                return bytes;
+            }
+            return to_godot_string(value);
+        }
+        case FieldDescriptor::CPPTYPE_MESSAGE: {
+            godot::Dictionary nested;
+            schema.message_to_dictionary(*field.message, reflection->GetMessage(message, fd), nested);
+            return nested;
+        }
+    }
+    return godot::Variant();
+}
+
+// Read element `index` of repeated `field` from `message`.
+godot::Variant repeated_to_variant(const LoadedSchema& schema, const MessageCodec::Field& field, const Message& message, const Reflection* reflection, int index) {
+    const FieldDescriptor* fd = field.descriptor;
+    switch (fd->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_BOOL:
+            return reflection->GetRepeatedBool(message, fd, index);
+        case FieldDescriptor::CPPTYPE_STRING: {
+            std::string scratch;
+            const std::string& value = reflection->GetRepeatedStringReference(message, fd, index, &scratch);
+            if (fd->type() == FieldDescriptor::TYPE_BYTES) {
+                godot::PackedByteArray bytes;
+                bytes.resize(value.size());
+                if (!value.empty()) {
+                    memcpy(bytes.ptrw(), value.data(), value.size());
+                }
+                return bytes;
+            }
+            return to_godot_string(value);
+        }
+        case FieldDescriptor::CPPTYPE_MESSAGE: {
+            godot::Dictionary nested;
+            schema.message_to_dictionary(*field.message, reflection->GetRepeatedMessage(message, fd, index), nested);
+            return nested;
+        }
+        default:
+            // Numeric repeated fields are handled in bulk by the caller
+            return godot::Variant();
+    }
+}
+
+// Closed (proto2) enums reject unknown numbers; open (proto3) ones keep them.
+// FileDescriptor::syntax() is gone in newer protobuf, which has is_closed().
+bool is_closed_enum(const google::protobuf::EnumDescriptor* enum_type) {
+#if GOOGLE_PROTOBUF_VERSION >= 4022000
+    return enum_type->is_closed();
+#else
+    return enum_type->file()->syntax() != google::protobuf::FileDescriptor::SYNTAX_PROTO3;
+#endif
+}
+
+bool set_enum(Message* message, const Reflection* reflection, const FieldDescriptor* fd, const godot::Variant& value, bool repeated) {
+    const google::protobuf::EnumValueDescriptor* enum_value = nullptr;
+    int number = 0;
+    if (value.get_type() == godot::Variant::STRING || value.get_type() == godot::Variant::STRING_NAME) {
+        enum_value = fd->enum_type()->FindValueByName(to_std_string(value));
+        if (!enum_value) {
+            Logger::error("Unknown enum value '" + to_std_string(value) + "' for field " + fd->full_name());
+            return false;
+        }
+    } else {
+        number = static_cast<int>(static_cast<int64_t>(value));
+        enum_value = fd->enum_type()->FindValueByNumber(number);
+        if (!enum_value && is_closed_enum(fd->enum_type())) {
+            Logger::error("Unknown enum number " + std::to_string(number) + " for closed enum field " + fd->full_name());
+            return false;
+        }
+    }
+
+    if (enum_value) {
+        number = enum_value->number();
+    }
+    if (repeated) {
+        reflection->AddEnumValue(message, fd, number);
+    } else {
+        reflection->SetEnumValue(message, fd, number);
+    }
+    return true;
+}
+
+bool set_singular(const LoadedSchema& schema, const MessageCodec::Field& field, Message* message, const Reflection* reflection, const godot::Variant& value) {
+    const FieldDescriptor* fd = field.descriptor;
+    switch (fd->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_INT32:
+            reflection->SetInt32(message, fd, static_cast<int32_t>(static_cast<int64_t>(value)));
+            return true;
+        case FieldDescriptor::CPPTYPE_INT64:
+            reflection->SetInt64(message, fd, static_cast<int64_t>(value));
+            return true;
+        case FieldDescriptor::CPPTYPE_UINT32:
+            reflection->SetUInt32(message, fd, static_cast<uint32_t>(static_cast<int64_t>(value)));
+            return true;
+        case FieldDescriptor::CPPTYPE_UINT64:
+            reflection->SetUInt64(message, fd, static_cast<uint64_t>(static_cast<int64_t>(value)));
+            return true;
+        case FieldDescriptor::CPPTYPE_DOUBLE:
+            reflection->SetDouble(message, fd, static_cast<double>(value));
+            return true;
+        case FieldDescriptor::CPPTYPE_FLOAT:
+            reflection->SetFloat(message, fd, static_cast<float>(static_cast<double>(value)));
+            return true;
+        case FieldDescriptor::CPPTYPE_BOOL:
+            reflection->SetBool(message, fd, static_cast<bool>(value));
+            return true;
+        case FieldDescriptor::CPPTYPE_ENUM:
+            return set_enum(message, reflection, fd, value, false);
+        case FieldDescriptor::CPPTYPE_STRING:
+            if (fd->type() == FieldDescriptor::TYPE_BYTES) {
+                reflection->SetString(message, fd, to_std_bytes(value));
+            } else {
+                reflection->SetString(message, fd, to_std_string(value));
+            }
+            return true;
+        case FieldDescriptor::CPPTYPE_MESSAGE:
+            if (value.get_type() != godot::Variant::DICTIONARY) {
+                Logger::error("Field " + fd->full_name() + " expects a Dictionary");
+                return false;
+            }
+            return schema.dictionary_to_message(*field.message, value, reflection->MutableMessage(message, fd, schema.get_factory()));
+    }
+    return false;
+}
+
+bool add_repeated(const LoadedSchema& schema, const MessageCodec::Field& field, Message* message, const Reflection* reflection, const godot::Variant& value) {
+    const FieldDescriptor* fd = field.descriptor;
+    switch (fd->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_INT32:
+            reflection->AddInt32(message, fd, static_cast<int32_t>(static_cast<int64_t>(value)));
+            return true;
+        case FieldDescriptor::CPPTYPE_INT64:
+            reflection->AddInt64(message, fd, static_cast<int64_t>(value));
+            return true;
+        case FieldDescriptor::CPPTYPE_UINT32:
+            reflection->AddUInt32(message, fd, static_cast<uint32_t>(static_cast<int64_t>(value)));
+            return true;
+        case FieldDescriptor::CPPTYPE_UINT64:
+            reflection->AddUInt64(message, fd, static_cast<uint64_t>(static_cast<int64_t>(value)));
+            return true;
+        case FieldDescriptor::CPPTYPE_DOUBLE:
+            reflection->AddDouble(message, fd, static_cast<double>(value));
+            return true;
+        case FieldDescriptor::CPPTYPE_FLOAT:
+            reflection->AddFloat(message, fd, static_cast<float>(static_cast<double>(value)));
+            return true;
+        case FieldDescriptor::CPPTYPE_BOOL:
+            reflection->AddBool(message, fd, static_cast<bool>(value));
+            return true;
+        case FieldDescriptor::CPPTYPE_ENUM:
+            return set_enum(message, reflection, fd, value, true);
+        case FieldDescriptor::CPPTYPE_STRING:
+            if (fd->type() == FieldDescriptor::TYPE_BYTES) {
+                reflection->AddString(message, fd, to_std_bytes(value));
+            } else {
+                reflection->AddString(message, fd, to_std_string(value));
+            }
+            return true;
+        case FieldDescriptor::CPPTYPE_MESSAGE:
+            if (value.get_type() != godot::Variant::DICTIONARY) {
+                Logger::error("Elements of field " + fd->full_name() + " must be Dictionaries");
+                return false;
+            }
+            return schema.dictionary_to_message(*field.message, value, reflection->AddMessage(message, fd, schema.get_factory()));
+    }
+    return false;
+}
+
+} // namespace
+
+std::shared_ptr<const LoadedSchema> LoadedSchema::load(const google::protobuf::FileDescriptorSet& file_set) {
+    std::shared_ptr<LoadedSchema> schema(new LoadedSchema());
+    schema->database_ = std::make_unique<google::protobuf::SimpleDescriptorDatabase>();
+    for (const auto& file : file_set.file()) {
+        if (!schema->database_->Add(file)) {
+            Logger::error("GrpcSchema: duplicate or invalid file " + file.name());
+            return nullptr;
+        }
+    }
+
+    schema->pool_ = std::make_unique<google::protobuf::DescriptorPool>(schema->database_.get());
+    schema->factory_ = std::make_unique<google::protobuf::DynamicMessageFactory>(schema->pool_.get());
+
+    // Build every file up front so missing imports are reported at load time
+    for (const auto& file : file_set.file()) {
+        if (!schema->pool_->FindFileByName(file.name())) {
+            Logger::error("GrpcSchema: failed to build " + file.name() +
+                          " (was the set generated with --include_imports?)");
+            return nullptr;
+        }
+        for (const auto& message : file.message_type()) {
+            collect_message_types(message, file.package(), schema->message_types_);
+        }
+        for (const auto& service : file.service()) {
+            schema->services_.push_back(file.package().empty() ? service.name() : file.package() + "." + service.name());
+        }
+    }
+    return schema;
+}
+
+LoadedSchema::~LoadedSchema() {
+    // Prototypes are owned by the factory, which references the pool,
+    // which references the database: tear down in that order.
+    codecs_.clear();
+    plans_.clear();
+    factory_.reset();
+    pool_.reset();
+    database_.reset();
+}
+
+const Descriptor* LoadedSchema::find_message_type(const std::string& message_type) const {
+    return pool_->FindMessageTypeByName(message_type);
+}
+
+const google::protobuf::MethodDescriptor* LoadedSchema::find_method(const std::string& full_method) const {
+    // "/package.Service/Method" -> "package.Service.Method"
+    std::string name = full_method;
+    if (!name.empty() && name[0] == '/') {
+        name.erase(0, 1);
+    }
+    size_t slash = name.find('/');
+    if (slash == std::string::npos) {
+        return nullptr;
+    }
+    name[slash] = '.';
+    return pool_->FindMethodByName(name);
+}
+
+const MessageCodec* LoadedSchema::find_codec(const std::string& message_type) const {
+    std::lock_guard<std::mutex> lock(codecs_mutex_);
+
+    auto it = codecs_.find(message_type);
+    if (it != codecs_.end()) {
+        return it->second.get();
+    }
+
+    const Descriptor* descriptor = pool_->FindMessageTypeByName(message_type);
+    if (!descriptor) {
+        return nullptr;
+    }
+    return build_codec_locked(descriptor);
+}
+
+const DecodePlan* LoadedSchema::find_plan(const std::string& message_type) const {
+    std::lock_guard<std::mutex> lock(codecs_mutex_);
+
+    auto it = plans_.find(message_type);
+    if (it != plans_.end()) {
+        return it->second.get();
+    }
+
+    const Descriptor* descriptor = pool_->FindMessageTypeByName(message_type);
+    if (!descriptor) {
+        return nullptr;
+    }
+    return build_plan_locked(descriptor);
+}
+
+const MessageCodec* LoadedSchema::build_codec_locked(const Descriptor* descriptor) const {
+    auto it = codecs_.find(descriptor->full_name());
+    if (it != codecs_.end()) {
+        return it->second.get();
+    }
+
+    auto codec = std::make_unique<MessageCodec>();
+    MessageCodec* result = codec.get();
+    result->descriptor = descriptor;
+    result->prototype = factory_->GetPrototype(descriptor);
+
+    // Register before resolving fields so recursive message types terminate
+    codecs_[descriptor->full_name()] = std::move(codec);
+
+    result->fields.reserve(descriptor->field_count());
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+        const FieldDescriptor* fd = descriptor->field(i);
+        MessageCodec::Field field;
+        field.descriptor = fd;
+        field.key = to_godot_string(fd->name());
+        field.message = nullptr;
+        if (fd->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+            field.message = build_codec_locked(fd->message_type());
+        }
+        result->fields.push_back(field);
+    }
+    return result;
+}
+
+const DecodePlan* LoadedSchema::build_plan_locked(const Descriptor* descriptor) const {
+    auto it = plans_.find(descriptor->full_name());
+    if (it != plans_.end()) {
+        return it->second.get();
+    }
+
+    auto plan = std::make_unique<DecodePlan>();
+    DecodePlan* result = plan.get();
+
+    // Register before building so recursive message types terminate
+    plans_[descriptor->full_name()] = std::move(plan);
+    result->build(descriptor, [this](const Descriptor* nested) {
+        return build_plan_locked(nested);
+    });
+    return result;
+}
+
+bool LoadedSchema::message_to_dictionary(const MessageCodec& codec, const Message& message, godot::Dictionary& out) const {
+    const Reflection* reflection = message.GetReflection();
+
+    for (const auto& field : codec.fields) {
+        const FieldDescriptor* fd = field.descriptor;
+
+        if (fd->is_map()) {
+            // Map entries are messages with key (field 0) and value (field 1)
+            const MessageCodec& entry_codec = *field.message;
+            const MessageCodec::Field& key_field = entry_codec.fields[0];
+            const MessageCodec::Field& value_field = entry_codec.fields[1];
+            godot::Dictionary map;
+            int count = reflection->FieldSize(message, fd);
+            for (int i = 0; i < count; ++i) {
+                const Message& entry = reflection->GetRepeatedMessage(message, fd, i);
+                const Reflection* entry_reflection = entry.GetReflection();
+                map[singular_to_variant(*this, key_field, entry, entry_reflection)] =
+                    singular_to_variant(*this, value_field, entry, entry_reflection);
+            }
+            out[field.key] = map;
+            continue;
+        }
+
+        if (fd->is_repeated()) {
+            int count = reflection->FieldSize(message, fd);
+            switch (fd->cpp_type()) {
+                case FieldDescriptor::CPPTYPE_INT32:
+                case FieldDescriptor::CPPTYPE_INT64:
+                case FieldDescriptor::CPPTYPE_UINT32:
+                case FieldDescriptor::CPPTYPE_UINT64:
+                case FieldDescriptor::CPPTYPE_ENUM: {
+                    godot::PackedInt64Array values;
+                    values.resize(count);
+                    int64_t* ptr = values.ptrw();
+                    for (int i = 0; i < count; ++i) {
+                        switch (fd->cpp_type()) {
+                            case FieldDescriptor::CPPTYPE_INT32: ptr[i] = reflection->GetRepeatedInt32(message, fd, i); break;
+                            case FieldDescriptor::CPPTYPE_INT64: ptr[i] = reflection->GetRepeatedInt64(message, fd, i); break;
+                            case FieldDescriptor::CPPTYPE_UINT32: ptr[i] = reflection->GetRepeatedUInt32(message, fd, i); break;
+                            case FieldDescriptor::CPPTYPE_UINT64: ptr[i] = static_cast<int64_t>(reflection->GetRepeatedUInt64(message, fd, i)); break;
+                            default: ptr[i] = reflection->GetRepeatedEnumValue(message, fd, i); break;
+                        }
+                    }
+                    out[field.key] = values;
+                    break;
+                }
+                case FieldDescriptor::CPPTYPE_FLOAT: {
+                    godot::PackedFloat32Array values;
+                    values.resize(count);
+                    float* ptr = values.ptrw();
+                    for (int i = 0; i < count; ++i) {
+                        ptr[i] = reflection->GetRepeatedFloat(message, fd, i);
+                    }
+                    out[field.key] = values;
+                    break;
+                }
+                case FieldDescriptor::CPPTYPE_DOUBLE: {
+                    godot::PackedFloat64Array values;
+                    values.resize(count);
+                    double* ptr = values.ptrw();
+                    for (int i = 0; i < count; ++i) {
+                        ptr[i] = reflection->GetRepeatedDouble(message, fd, i);
+                    }
+                    out[field.key] = values;
+                    break;
+                }
+                default: {
+                    if (fd->type() == FieldDescriptor::TYPE_STRING) {
+                        godot::PackedStringArray values;
+                        for (int i = 0; i < count; ++i) {
+                            values.push_back(repeated_to_variant(*this, field, message, reflection, i));
+                        }
+                        out[field.key] = values;
+                    } else {
+                        godot::Array values;
+                        values.resize(count);
+                        for (int i = 0; i < count; ++i) {
+                            values[i] = repeated_to_variant(*this, field, message, reflection, i);
+                        }
+                        out[field.key] = values;
+                    }
+                    break;
+                }
+            }
+            continue;
+        }
+
+        // Fields with explicit presence are only reported when set
+        if (fd->has_presence() && !reflection->HasField(message, fd)) {
+            continue;
+        }
+        out[field.key] = singular_to_variant(*this, field, message, reflection);
+    }
+    return true;
+}
+
+bool LoadedSchema::dictionary_to_message(const MessageCodec& codec, const godot::Dictionary& dict, Message* message) const {
+    const Reflection* reflection = message->GetReflection();
+
+    // Walk the schema rather than the Dictionary: lookups use the cached
+    // field keys and no Dictionary key is converted to UTF-8.
+    for (const auto& field : codec.fields) {
+        if (!dict.has(field.key)) {
+            continue;
+        }
+        godot::Variant value = dict[field.key];
+        if (value.get_type() == godot::Variant::NIL) {
+            continue;
+        }
+        const FieldDescriptor* fd = field.descriptor;
+
+        if (fd->is_map()) {
+            if (value.get_type() != godot::Variant::DICTIONARY) {
+                Logger::error("Map field " + fd->full_name() + " expects a Dictionary");
+                return false;
+            }
+            const MessageCodec& entry_codec = *field.message;
+            godot::Dictionary map = value;
+            godot::Array keys = map.keys();
+            for (int64_t i = 0; i < keys.size(); ++i) {
+                Message* entry = reflection->AddMessage(message, fd, factory_.get());
+                const Reflection* entry_reflection = entry->GetReflection();
+                if (!set_singular(*this, entry_codec.fields[0], entry, entry_reflection, keys[i]) ||
+                    !set_singular(*this, entry_codec.fields[1], entry, entry_reflection, map[keys[i]])) {
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        if (fd->is_repeated()) {
+            switch (value.get_type()) {
+                case godot::Variant::PACKED_INT64_ARRAY: {
+                    godot::PackedInt64Array values = value;
+                    for (int64_t i = 0; i < values.size(); ++i) {
+                        if (!add_repeated(*this, field, message, reflection, values[i])) {
+                            return false;
+                        }
+                    }
+                    break;
+                }
+                case godot::Variant::PACKED_FLOAT32_ARRAY: {
+                    godot::PackedFloat32Array values = value;
+                    for (int64_t i = 0; i < values.size(); ++i) {
+                        if (!add_repeated(*this, field, message, reflection, values[i])) {
+                            return false;
+                        }
+                    }
+                    break;
+                }
+                case godot::Variant::PACKED_FLOAT64_ARRAY: {
+                    godot::PackedFloat64Array values = value;
+                    for (int64_t i = 0; i < values.size(); ++i) {
+                        if (!add_repeated(*this, field, message, reflection, values[i])) {
+                            return false;
+                        }
+                    }
+                    break;
+                }
+                case godot::Variant::ARRAY:
+                case godot::Variant::PACKED_INT32_ARRAY:
+                case godot::Variant::PACKED_STRING_ARRAY: {
+                    godot::Array values = value;
+                    for (int64_t i = 0; i < values.size(); ++i) {
+                        if (!add_repeated(*this, field, message, reflection, values[i])) {
+                            return false;
+                        }
+                    }
+                    break;
+                }
+                default:
+                    Logger::error("Repeated field " + fd->full_name() + " expects an Array");
+                    return false;
+            }
+            continue;
+        }
+
+        if (!set_singular(*this, field, message, reflection, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LoadedSchema::json_to_binary(const Descriptor* descriptor, const std::string& json, std::string* out, std::string* error) const {
+    const MessageCodec* codec = find_codec(descriptor->full_name());
+    if (!codec) {
+        *error = "unknown message type " + descriptor->full_name();
+        return false;
+    }
+
+    google::protobuf::Arena arena;
+    Message* message = codec->prototype->New(&arena);
+    auto status = google::protobuf::util::JsonStringToMessage(json, message);
+    if (!status.ok()) {
+        *error = "invalid JSON for " + descriptor->full_name() + ": " + std::string(status.message());
+        return false;
+    }
+    if (!message->SerializeToString(out)) {
+        *error = "failed to serialize " + descriptor->full_name();
+        return false;
+    }
+    return true;
+}
+
+bool LoadedSchema::binary_to_json(const Descriptor* descriptor, const std::string& bytes, std::string* out, std::string* error) const {
+    const MessageCodec* codec = find_codec(descriptor->full_name());
+    if (!codec) {
+        *error = "unknown message type " + descriptor->full_name();
+        return false;
+    }
+
+    google::protobuf::Arena arena;
+    Message* message = codec->prototype->New(&arena);
+    if (!message->ParseFromString(bytes)) {
+        *error = "failed to parse " + descriptor->full_name();
+        return false;
+    }
+
+    // Field names match the Dictionary keys used by encode()/decode()
+    google::protobuf::util::JsonPrintOptions options;
+    options.preserve_proto_field_names = true;
+#if GOOGLE_PROTOBUF_VERSION >= 5026000
+    options.always_print_fields_with_no_presence = true;
+#else
+    options.always_print_primitive_fields = true;
+#endif
+    auto status = google::protobuf::util::MessageToJsonString(*message, out, options);
+    if (!status.ok()) {
+        *error = "failed to print " + descriptor->full_name() + " as JSON: " + std::string(status.message());
+        return false;
+    }
+    return true;
+}
+
+GrpcSchema::GrpcSchema() {
+}
+
+GrpcSchema::~GrpcSchema() {
+}
+
+void GrpcSchema::_bind_methods() {
+    godot::ClassDB::bind_method(godot::D_METHOD("load_descriptor_set", "descriptor_set"), &GrpcSchema::load_descriptor_set);
+    godot::ClassDB::bind_method(godot::D_METHOD("load_descriptor_set_file", "path"), &GrpcSchema::load_descriptor_set_file);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_descriptor_set", "descriptor_set"), &GrpcSchema::load_descriptor_set);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_descriptor_set"), &GrpcSchema::get_descriptor_set);
+    godot::ClassDB::bind_method(godot::D_METHOD("has_message_type", "message_type"), &GrpcSchema::has_message_type);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_message_types"), &GrpcSchema::get_message_types);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_services"), &GrpcSchema::get_services);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_method_info", "full_method"), &GrpcSchema::get_method_info);
+    godot::ClassDB::bind_method(godot::D_METHOD("encode", "message_type", "message"), &GrpcSchema::encode);
+    godot::ClassDB::bind_method(godot::D_METHOD("decode", "message_type", "bytes"), &GrpcSchema::decode);
+    godot::ClassDB::bind_method(godot::D_METHOD("decode_to_array", "message_type", "bytes", "out"), &GrpcSchema::decode_to_array);
+    godot::ClassDB::bind_method(godot::D_METHOD("decode_columns", "message_type", "field", "bytes"), &GrpcSchema::decode_columns);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_field_names", "message_type"), &GrpcSchema::get_field_names);
+    godot::ClassDB::bind_method(godot::D_METHOD("to_json", "message_type", "bytes"), &GrpcSchema::to_json);
+    godot::ClassDB::bind_method(godot::D_METHOD("from_json", "message_type", "json"), &GrpcSchema::from_json);
+
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::PACKED_BYTE_ARRAY, "descriptor_set", godot::PROPERTY_HINT_NONE, "", godot::PROPERTY_USAGE_STORAGE), "set_descriptor_set", "get_descriptor_set");
+}
+
+bool GrpcSchema::load_descriptor_set(const godot::PackedByteArray& descriptor_set) {
+    google::protobuf::FileDescriptorSet file_set;
+    if (!file_set.ParseFromArray(descriptor_set.ptr(), static_cast<int>(descriptor_set.size()))) {
+        Logger::error("GrpcSchema: failed to parse FileDescriptorSet");
+        return false;
+    }
+
+    std::shared_ptr<const LoadedSchema> loaded = LoadedSchema::load(file_set);
+    if (!loaded) {
+        return false;
+    }
+
+    // Holders of the previous snapshot keep it alive until they are done
+    size_t message_type_count = loaded->get_message_types().size();
+    {
+        std::lock_guard<std::mutex> lock(loaded_mutex_);
+        loaded_ = std::move(loaded);
+    }
+
+    descriptor_set_ = descriptor_set;
+    Logger::info("GrpcSchema: loaded " + std::to_string(file_set.file_size()) + " files, " +
+                 std::to_string(message_type_count) + " message types");
+    emit_changed();
+    return true;
+}
+
+bool GrpcSchema::load_descriptor_set_file(const godot::String& path) {
+    if (!godot::FileAccess::file_exists(path)) {
+        Logger::error("GrpcSchema: descriptor set file not found: " + to_std_string(path));
+        return false;
+    }
+    return load_descriptor_set(godot::FileAccess::get_file_as_bytes(path));
+}
+
+godot::PackedByteArray GrpcSchema::get_descriptor_set() const {
+    return descriptor_set_;
+}
+
+std::shared_ptr<const LoadedSchema> GrpcSchema::snapshot() const {
+    std::lock_guard<std::mutex> lock(loaded_mutex_);
+    return loaded_;
+}
+
+bool GrpcSchema::has_message_type(const godot::String& message_type) {
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    return loaded && loaded->find_codec(to_std_string(message_type)) != nullptr;
+}
+
+godot::PackedStringArray GrpcSchema::get_message_types() const {
+    godot::PackedStringArray result;
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    if (!loaded) {
+        return result;
+    }
+    for (const auto& name : loaded->get_message_types()) {
+        result.push_back(to_godot_string(name));
+    }
+    return result;
+}
+
+godot::PackedStringArray GrpcSchema::get_services() const {
+    godot::PackedStringArray result;
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    if (!loaded) {
+        return result;
+    }
+    for (const auto& name : loaded->get_services()) {
+        result.push_back(to_godot_string(name));
+    }
+    return result;
+}
+
+godot::Dictionary GrpcSchema::get_method_info(const godot::String& full_method) const {
+    godot::Dictionary info;
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    const google::protobuf::MethodDescriptor* method = loaded ? loaded->find_method(to_std_string(full_method)) : nullptr;
+    if (!method) {
+        return info;
+    }
+    info["input_type"] = to_godot_string(method->input_type()->full_name());
+    info["output_type"] = to_godot_string(method->output_type()->full_name());
+    info["client_streaming"] = method->client_streaming();
+    info["server_streaming"] = method->server_streaming();
+    return info;
+}
+
+godot::PackedByteArray GrpcSchema::encode(const godot::String& message_type, const godot::Dictionary& message) {
+    std::string type_name = to_std_string(message_type);
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    const MessageCodec* codec = loaded ? loaded->find_codec(type_name) : nullptr;
+    if (!codec) {
+        Logger::error("GrpcSchema: unknown message type " + type_name);
+        return godot::PackedByteArray();
+    }
+
+    google::protobuf::Arena arena;
+    Message* proto = codec->prototype->New(&arena);
+    if (!loaded->dictionary_to_message(*codec, message, proto)) {
+        Logger::error("GrpcSchema: failed to encode " + type_name);
+        return godot::PackedByteArray();
+    }
+
+    godot::PackedByteArray bytes;
+    size_t size = proto->ByteSizeLong();
+    bytes.resize(size);
+    if (size > 0 && !proto->SerializeToArray(bytes.ptrw(), static_cast<int>(size))) {
+        Logger::error("GrpcSchema: failed to serialize " + type_name);
+        return godot::PackedByteArray();
+    }
+    return bytes;
+}
+
+godot::Dictionary GrpcSchema::decode(const godot::String& message_type, const godot::PackedByteArray& bytes) {
+    std::string type_name = to_std_string(message_type);
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    const DecodePlan* plan = loaded ? loaded->find_plan(type_name) : nullptr;
+    if (!plan) {
+        Logger::error("GrpcSchema: unknown message type " + type_name);
+        return godot::Dictionary();
+    }
+
+    godot::Dictionary result;
+    if (!plan->decode_dictionary(bytes.ptr(), static_cast<size_t>(bytes.size()), result)) {
+        Logger::error("GrpcSchema: failed to parse " + type_name);
+        return godot::Dictionary();
+    }
+    return result;
+}
+
+bool GrpcSchema::decode_to_array(const godot::String& message_type, const godot::PackedByteArray& bytes, godot::Array out) {
+    std::string type_name = to_std_string(message_type);
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    const DecodePlan* plan = loaded ? loaded->find_plan(type_name) : nullptr;
+    if (!plan) {
+        Logger::error("GrpcSchema: unknown message type " + type_name);
+        return false;
+    }
+
+    if (!plan->decode_array(bytes.ptr(), static_cast<size_t>(bytes.size()), out)) {
+        Logger::error("GrpcSchema: failed to parse " + type_name);
+        return false;
+    }
+    return true;
+}
+
+godot::Dictionary GrpcSchema::decode_columns(const godot::String& message_type, const godot::String& field, const godot::PackedByteArray& bytes) {
+    std::string type_name = to_std_string(message_type);
+    ColumnarDecoder decoder;
+    if (!decoder.init(snapshot(), type_name, to_std_string(field))) {
+        return godot::Dictionary();
+    }
+
+    godot::Dictionary columns;
+    if (!decoder.decode(bytes.ptr(), static_cast<size_t>(bytes.size()), columns)) {
+        Logger::error("GrpcSchema: failed to parse " + type_name);
+        return godot::Dictionary();
+    }
+    return columns;
+}
+
+godot::String GrpcSchema::to_json(const godot::String& message_type, const godot::PackedByteArray& bytes) {
+    std::string type_name = to_std_string(message_type);
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    const Descriptor* descriptor = loaded ? loaded->find_message_type(type_name) : nullptr;
+    if (!descriptor) {
+        Logger::error("GrpcSchema: unknown message type " + type_name);
+        return godot::String();
+    }
+
+    std::string json;
+    std::string error;
+    if (!loaded->binary_to_json(descriptor, std::string(reinterpret_cast<const char*>(bytes.ptr()), static_cast<size_t>(bytes.size())), &json, &error)) {
+        Logger::error("GrpcSchema: " + error);
+        return godot::String();
+    }
+    return to_godot_string(json);
+}
+
+godot::PackedByteArray GrpcSchema::from_json(const godot::String& message_type, const godot::String& json) {
+    std::string type_name = to_std_string(message_type);
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    const Descriptor* descriptor = loaded ? loaded->find_message_type(type_name) : nullptr;
+    if (!descriptor) {
+        Logger::error("GrpcSchema: unknown message type " + type_name);
+        return godot::PackedByteArray();
+    }
+
+    std::string binary;
+    std::string error;
+    if (!loaded->json_to_binary(descriptor, to_std_string(json), &binary, &error)) {
+        Logger::error("GrpcSchema: " + error);
+        return godot::PackedByteArray();
+    }
+
+    godot::PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(binary.size()));
+    if (!binary.empty()) {
+        memcpy(bytes.ptrw(), binary.data(), binary.size());
+    }
+    return bytes;
+}
+
+godot::PackedStringArray GrpcSchema::get_field_names(const godot::String& message_type) {
+    godot::PackedStringArray names;
+    std::shared_ptr<const LoadedSchema> loaded = snapshot();
+    const DecodePlan* plan = loaded ? loaded->find_plan(to_std_string(message_type)) : nullptr;
+    if (!plan) {
+        return names;
+    }
+    for (const auto& entry : plan->entries) {
+        names.push_back(entry.key);
+    }
+    return names;
+}
+
+} // namespace godot_grpc
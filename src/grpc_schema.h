@@ -0,0 +1,241 @@
+#ifndef GODOT_GRPC_SCHEMA_H
+#define GODOT_GRPC_SCHEMA_H
+
+#include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "grpc_decode_plan.h"
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <google/protobuf/descriptor_database.h>
+#include <google/protobuf/dynamic_message.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace godot_grpc {
+
+/**
+ * Cached reflection data for one message type. Built once per type and
+ * immutable afterwards, so it can be shared between threads.
+ */
+struct MessageCodec {
+    struct Field {
+        const google::protobuf::FieldDescriptor* descriptor;
+        godot::String key;               // Dictionary key (field name)
+        const MessageCodec* message;     // Codec for message/map-entry fields, else nullptr
+    };
+
+    const google::protobuf::Descriptor* descriptor = nullptr;
+    const google::protobuf::Message* prototype = nullptr;
+    std::vector<Field> fields;
+};
+
+/**
+ * LoadedSchema: One loaded descriptor set, with the codecs and decode plans
+ * built from it.
+ *
+ * Shared as std::shared_ptr<const LoadedSchema> and never changed once
+ * loaded, except that codecs and plans are added on first use under its own
+ * lock and never removed. Every descriptor, codec and plan it returns stays
+ * valid for as long as the caller holds the pointer, even after the
+ * GrpcSchema it came from loads another set. Usable from any thread.
+ */
+class LoadedSchema {
+public:
+    /**
+     * Build the pool for a parsed FileDescriptorSet, resolving every file so
+     * missing imports are reported here.
+     *
+     * @return The loaded schema, or nullptr on error (logged)
+     */
+    static std::shared_ptr<const LoadedSchema> load(const google::protobuf::FileDescriptorSet& file_set);
+
+    ~LoadedSchema();
+
+    const std::vector<std::string>& get_message_types() const { return message_types_; }
+    const std::vector<std::string>& get_services() const { return services_; }
+
+    const google::protobuf::Descriptor* find_message_type(const std::string& message_type) const;
+    const google::protobuf::MethodDescriptor* find_method(const std::string& full_method) const;
+    const MessageCodec* find_codec(const std::string& message_type) const;
+    const DecodePlan* find_plan(const std::string& message_type) const;
+    google::protobuf::DynamicMessageFactory* get_factory() const { return factory_.get(); }
+
+    // JSON transcoding
+    bool json_to_binary(const google::protobuf::Descriptor* descriptor, const std::string& json, std::string* out, std::string* error) const;
+    bool binary_to_json(const google::protobuf::Descriptor* descriptor, const std::string& bytes, std::string* out, std::string* error) const;
+
+    bool message_to_dictionary(const MessageCodec& codec, const google::protobuf::Message& message, godot::Dictionary& out) const;
+    bool dictionary_to_message(const MessageCodec& codec, const godot::Dictionary& dict, google::protobuf::Message* message) const;
+
+private:
+    LoadedSchema() = default;
+
+    const MessageCodec* build_codec_locked(const google::protobuf::Descriptor* descriptor) const;
+    const DecodePlan* build_plan_locked(const google::protobuf::Descriptor* descriptor) const;
+
+    std::vector<std::string> message_types_;
+    std::vector<std::string> services_;
+
+    std::unique_ptr<google::protobuf::SimpleDescriptorDatabase> database_;
+    std::unique_ptr<google::protobuf::DescriptorPool> pool_;
+    std::unique_ptr<google::protobuf::DynamicMessageFactory> factory_;
+
+    // Built lazily, so mutable behind the const interface
+    mutable std::mutex codecs_mutex_;
+    mutable std::unordered_map<std::string, std::unique_ptr<MessageCodec>> codecs_;
+    mutable std::unordered_map<std::string, std::unique_ptr<DecodePlan>> plans_;
+};
+
+/**
+ * GrpcSchema: Protobuf schema loaded from a serialized FileDescriptorSet.
+ *
+ * Converts between Dictionaries and wire-format bytes for any message type
+ * in the set, using protobuf DynamicMessage and no generated code.
+ * Produce the descriptor set with:
+ *   protoc --include_imports --descriptor_set_out=schema.pb your.proto
+ *
+ * Field mapping (Dictionary keys are the proto field names):
+ *   - integer/enum types  <-> int (enums also accept their String name)
+ *   - float/double        <-> float
+ *   - bool                <-> bool
+ *   - string              <-> String
+ *   - bytes               <-> PackedByteArray
+ *   - message             <-> Dictionary
+ *   - map<K, V>           <-> Dictionary
+ *   - repeated int/enum   <-> PackedInt64Array
+ *   - repeated float      <-> PackedFloat32Array
+ *   - repeated double     <-> PackedFloat64Array
+ *   - repeated string     <-> PackedStringArray
+ *   - other repeated      <-> Array
+ *
+ * Decoded Dictionaries always contain every scalar and repeated field (with
+ * its default value when absent); message fields and oneof members are only
+ * present when set.
+ *
+ * decode() runs on a DecodePlan compiled once per message type, which reads
+ * the wire format directly instead of going through DynamicMessage.
+ *
+ * Each load publishes a new LoadedSchema. Native code that keeps
+ * descriptors, codecs or plans (for example across a call or a stream)
+ * holds snapshot() rather than the GrpcSchema, so a reload never frees
+ * them while they are in use.
+ */
+class GrpcSchema : public godot::Resource {
+    GDCLASS(GrpcSchema, godot::Resource)
+
+public:
+    GrpcSchema();
+    ~GrpcSchema();
+
+    /**
+     * Load a serialized FileDescriptorSet. Replaces any previously loaded schema.
+     *
+     * @param descriptor_set Bytes of a google.protobuf.FileDescriptorSet
+     * @return true if the set was parsed successfully
+     */
+    bool load_descriptor_set(const godot::PackedByteArray& descriptor_set);
+
+    /**
+     * Load a FileDescriptorSet from a file (res://, user:// or absolute path).
+     */
+    bool load_descriptor_set_file(const godot::String& path);
+
+    /**
+     * Get the raw descriptor set bytes (saved with the resource).
+     */
+    godot::PackedByteArray get_descriptor_set() const;
+
+    /**
+     * Check whether a fully-qualified message type (e.g. "helloworld.HelloRequest") exists.
+     */
+    bool has_message_type(const godot::String& message_type);
+
+    /**
+     * List all message types defined in the loaded files.
+     */
+    godot::PackedStringArray get_message_types() const;
+
+    /**
+     * List all services defined in the loaded files.
+     */
+    godot::PackedStringArray get_services() const;
+
+    /**
+     * Describe a method given as "/package.Service/Method".
+     *
+     * @return Dictionary with input_type, output_type, client_streaming and
+     *         server_streaming, or empty Dictionary if the method is unknown
+     */
+    godot::Dictionary get_method_info(const godot::String& full_method) const;
+
+    /**
+     * Encode a Dictionary as the given message type.
+     *
+     * @return Serialized message bytes, or empty array on error
+     */
+    godot::PackedByteArray encode(const godot::String& message_type, const godot::Dictionary& message);
+
+    /**
+     * Decode wire-format bytes as the given message type.
+     *
+     * @return Dictionary of field values, or empty Dictionary on error
+     */
+    godot::Dictionary decode(const godot::String& message_type, const godot::PackedByteArray& bytes);
+
+    /**
+     * Decode wire-format bytes into a preallocated Array, one element per
+     * field in get_field_names() order. Reusing the same Array across calls
+     * avoids building a Dictionary per message.
+     *
+     * @return true on success
+     */
+    bool decode_to_array(const godot::String& message_type, const godot::PackedByteArray& bytes, godot::Array out);
+
+    /**
+     * Decode repeated message field `field` of `message_type` as columns:
+     * a Dictionary mapping each scalar field of the element type to a
+     * PackedInt64Array / PackedFloat32Array / PackedFloat64Array /
+     * PackedStringArray with one entry per element.
+     *
+     * @return Dictionary of columns, or empty Dictionary on error
+     */
+    godot::Dictionary decode_columns(const godot::String& message_type, const godot::String& field, const godot::PackedByteArray& bytes);
+
+    /**
+     * Convert between wire-format bytes and protobuf JSON (proto field names).
+     *
+     * @return JSON string / serialized bytes, or empty on error
+     */
+    godot::String to_json(const godot::String& message_type, const godot::PackedByteArray& bytes);
+    godot::PackedByteArray from_json(const godot::String& message_type, const godot::String& json);
+
+    /**
+     * Field names of a message type in decode_to_array() slot order.
+     */
+    godot::PackedStringArray get_field_names(const godot::String& message_type);
+
+    // Native API (usable from any thread): the current LoadedSchema, or
+    // nullptr before a successful load
+    std::shared_ptr<const LoadedSchema> snapshot() const;
+
+protected:
+    static void _bind_methods();
+
+private:
+    godot::PackedByteArray descriptor_set_;
+
+    // Swapped whole on load; readers copy the pointer under the lock
+    mutable std::mutex loaded_mutex_;
+    std::shared_ptr<const LoadedSchema> loaded_;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_SCHEMA_H
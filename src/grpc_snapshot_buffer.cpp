@@ -0,0 +1,295 @@
+#include "grpc_snapshot_buffer.h"
+#include "util/status_map.h"
+#include "util/wire_format.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <grpcpp/support/slice.h>
+#include <algorithm>
+
+namespace godot_grpc {
+
+namespace {
+
+constexpr int DEFAULT_CAPACITY = 32;
+
+} // namespace
+
+GrpcSnapshotBuffer::GrpcSnapshotBuffer()
+    : ring_(DEFAULT_CAPACITY)
+{
+}
+
+void GrpcSnapshotBuffer::_bind_methods() {
+    godot::ClassDB::bind_method(godot::D_METHOD("set_capacity", "capacity"), &GrpcSnapshotBuffer::set_capacity);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_capacity"), &GrpcSnapshotBuffer::get_capacity);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_tick_field", "field_number"), &GrpcSnapshotBuffer::set_tick_field);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_tick_field"), &GrpcSnapshotBuffer::get_tick_field);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_schema", "schema", "message_type"), &GrpcSnapshotBuffer::set_schema);
+
+    godot::ClassDB::bind_method(godot::D_METHOD("push", "bytes"), &GrpcSnapshotBuffer::push);
+    godot::ClassDB::bind_method(godot::D_METHOD("sample", "render_time"), &GrpcSnapshotBuffer::sample);
+
+    godot::ClassDB::bind_method(godot::D_METHOD("get_count"), &GrpcSnapshotBuffer::get_count);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_oldest_tick"), &GrpcSnapshotBuffer::get_oldest_tick);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_latest_tick"), &GrpcSnapshotBuffer::get_latest_tick);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_dropped_count"), &GrpcSnapshotBuffer::get_dropped_count);
+    godot::ClassDB::bind_method(godot::D_METHOD("clear"), &GrpcSnapshotBuffer::clear);
+
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "capacity"), "set_capacity", "get_capacity");
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "tick_field"), "set_tick_field", "get_tick_field");
+}
+
+void GrpcSnapshotBuffer::set_capacity(int capacity) {
+    if (capacity < 2) {
+        Logger::warn("GrpcSnapshotBuffer: capacity must be at least 2");
+        capacity = 2;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_.assign(static_cast<size_t>(capacity), Snapshot());
+    head_ = 0;
+    count_ = 0;
+}
+
+int GrpcSnapshotBuffer::get_capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(ring_.size());
+}
+
+void GrpcSnapshotBuffer::set_tick_field(int field_number) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tick_field_ = static_cast<uint32_t>(field_number);
+}
+
+int GrpcSnapshotBuffer::get_tick_field() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(tick_field_);
+}
+
+void GrpcSnapshotBuffer::set_schema(const godot::Ref<GrpcSchema>& schema, const godot::String& message_type) {
+    std::shared_ptr<const LoadedSchema> loaded;
+    const DecodePlan* plan = nullptr;
+    if (schema.is_valid()) {
+        std::string type_name = message_type.utf8().get_data();
+        loaded = schema->snapshot();
+        plan = loaded ? loaded->find_plan(type_name) : nullptr;
+        if (!plan) {
+            Logger::error("GrpcSnapshotBuffer: unknown message type " + type_name);
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    schema_ = std::move(loaded);
+    plan_ = plan;
+}
+
+bool GrpcSnapshotBuffer::push(const godot::PackedByteArray& bytes) {
+    return push_bytes(bytes.ptr(), static_cast<size_t>(bytes.size()), &bytes);
+}
+
+bool GrpcSnapshotBuffer::push_buffer(const grpc::ByteBuffer& buffer) {
+    grpc::Slice slice;
+    if (buffer.TrySingleSlice(&slice).ok()) {
+        return push_bytes(slice.begin(), slice.size(), nullptr);
+    }
+
+    // Fragmented messages are gathered into the PackedByteArray we keep anyway
+    std::vector<grpc::Slice> slices;
+    if (!buffer.Dump(&slices).ok()) {
+        return false;
+    }
+    godot::PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(buffer.Length()));
+    size_t offset = 0;
+    for (const auto& part : slices) {
+        memcpy(bytes.ptrw() + offset, part.begin(), part.size());
+        offset += part.size();
+    }
+    return push_bytes(bytes.ptr(), offset, &bytes);
+}
+
+bool GrpcSnapshotBuffer::read_tick(const uint8_t* data, size_t size, uint32_t tick_field, int64_t* out_tick) {
+    size_t pos = 0;
+    bool found = false;
+    while (pos < size) {
+        uint64_t tag;
+        if (!wire::decode_varint(data, size, &pos, &tag)) {
+            return false;
+        }
+        uint32_t field_number = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+        if (field_number == tick_field && wire_type == wire::VARINT) {
+            uint64_t value;
+            if (!wire::decode_varint(data, size, &pos, &value)) {
+                return false;
+            }
+            *out_tick = static_cast<int64_t>(value);
+            found = true; // Keep scanning: the last occurrence wins
+        } else if (field_number == tick_field && wire_type == wire::FIXED64) {
+            if (size - pos < 8) {
+                return false;
+            }
+            *out_tick = static_cast<int64_t>(wire::load_fixed64(data + pos));
+            pos += 8;
+            found = true;
+        } else if (!wire::skip_field(data, size, &pos, wire_type, field_number)) {
+            return false;
+        }
+    }
+    return found;
+}
+
+bool GrpcSnapshotBuffer::push_bytes(const uint8_t* data, size_t size, const godot::PackedByteArray* bytes) {
+    uint32_t tick_field;
+    const DecodePlan* plan;
+    std::shared_ptr<const LoadedSchema> schema; // Keeps plan alive while decoding outside the lock
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tick_field = tick_field_;
+        plan = plan_;
+        schema = schema_;
+    }
+
+    int64_t tick;
+    if (!read_tick(data, size, tick_field, &tick)) {
+        Logger::warn("GrpcSnapshotBuffer: snapshot without a valid tick field");
+        return false;
+    }
+
+    // Decode or copy before taking the lock so sample() never waits on it
+    Snapshot snapshot;
+    snapshot.tick = tick;
+    if (plan) {
+        godot::Dictionary decoded;
+        if (!plan->decode_dictionary(data, size, decoded)) {
+            Logger::warn("GrpcSnapshotBuffer: failed to decode snapshot " + std::to_string(tick));
+            return false;
+        }
+        snapshot.value = decoded;
+    } else if (bytes) {
+        snapshot.value = *bytes;
+    } else {
+        godot::PackedByteArray copy;
+        copy.resize(static_cast<int64_t>(size));
+        if (size > 0) {
+            memcpy(copy.ptrw(), data, size);
+        }
+        snapshot.value = copy;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t capacity = ring_.size();
+
+    // Common case: newer than everything buffered
+    if (count_ == 0 || tick > at(count_ - 1).tick) {
+        if (count_ == capacity) {
+            head_ = (head_ + 1) % capacity;
+            --count_;
+        }
+        at(count_) = std::move(snapshot);
+        ++count_;
+        return true;
+    }
+
+    // Late arrival: find its slot, dropping duplicates and stale ticks
+    size_t low = 0;
+    size_t high = count_;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (at(mid).tick < tick) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if ((low < count_ && at(low).tick == tick) || (low == 0 && count_ == capacity)) {
+        ++dropped_;
+        return false;
+    }
+
+    if (count_ == capacity) {
+        // Evict the oldest; the new snapshot lands one slot earlier
+        head_ = (head_ + 1) % capacity;
+        --count_;
+        --low;
+    }
+    for (size_t i = count_; i > low; --i) {
+        at(i) = std::move(at(i - 1));
+    }
+    at(low) = std::move(snapshot);
+    ++count_;
+    return true;
+}
+
+godot::Dictionary GrpcSnapshotBuffer::sample(double render_time) const {
+    godot::Dictionary result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (count_ == 0) {
+        return result;
+    }
+
+    // Last snapshot at or before render_time
+    size_t low = 0;
+    size_t high = count_;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (static_cast<double>(at(mid).tick) <= render_time) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    const Snapshot* from;
+    const Snapshot* to;
+    double alpha;
+    if (low == 0) {
+        from = to = &at(0);
+        alpha = 0.0;
+    } else if (low == count_) {
+        from = to = &at(count_ - 1);
+        alpha = 1.0;
+    } else {
+        from = &at(low - 1);
+        to = &at(low);
+        alpha = (render_time - static_cast<double>(from->tick)) / static_cast<double>(to->tick - from->tick);
+    }
+
+    result["from"] = from->value;
+    result["to"] = to->value;
+    result["from_tick"] = from->tick;
+    result["to_tick"] = to->tick;
+    result["alpha"] = std::clamp(alpha, 0.0, 1.0);
+    return result;
+}
+
+int GrpcSnapshotBuffer::get_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(count_);
+}
+
+int64_t GrpcSnapshotBuffer::get_oldest_tick() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_ > 0 ? at(0).tick : 0;
+}
+
+int64_t GrpcSnapshotBuffer::get_latest_tick() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_ > 0 ? at(count_ - 1).tick : 0;
+}
+
+int64_t GrpcSnapshotBuffer::get_dropped_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+void GrpcSnapshotBuffer::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& snapshot : ring_) {
+        snapshot = Snapshot();
+    }
+    head_ = 0;
+    count_ = 0;
+    dropped_ = 0;
+}
+
+} // namespace godot_grpc
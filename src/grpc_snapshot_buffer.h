@@ -0,0 +1,110 @@
+#ifndef GODOT_GRPC_SNAPSHOT_BUFFER_H
+#define GODOT_GRPC_SNAPSHOT_BUFFER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include "grpc_schema.h"
+#include <grpcpp/support/byte_buffer.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace godot_grpc {
+
+/**
+ * GrpcSnapshotBuffer: Jitter buffer for streams of timestamped snapshots.
+ *
+ * Holds the most recent `capacity` snapshots in a ring ordered by the tick
+ * read from field `tick_field` of each message (a varint or fixed64 field,
+ * e.g. a server tick counter or a millisecond timestamp). Late snapshots are
+ * inserted in order; snapshots older than everything in a full ring, and
+ * duplicate ticks, are dropped.
+ *
+ * Attached to a stream with the "snapshot_buffer" call option, the buffer is
+ * filled on the stream's reader thread and no `message` signals are emitted.
+ * Each frame the game calls sample() once with its render time (in tick
+ * units, usually a little behind the latest tick) and interpolates between
+ * the two snapshots it returns.
+ *
+ * With a schema set, snapshots are decoded into Dictionaries when they
+ * arrive instead of being kept as bytes. The buffer keeps decoding with the
+ * descriptor set loaded when set_schema() was called, even if the schema
+ * loads another one later.
+ *
+ * All methods are thread-safe.
+ */
+class GrpcSnapshotBuffer : public godot::RefCounted {
+    GDCLASS(GrpcSnapshotBuffer, godot::RefCounted)
+
+public:
+    GrpcSnapshotBuffer();
+    ~GrpcSnapshotBuffer() = default;
+
+    // Configuration (changing capacity clears the buffer)
+    void set_capacity(int capacity);
+    int get_capacity() const;
+    void set_tick_field(int field_number);
+    int get_tick_field() const;
+
+    /**
+     * Decode snapshots of `message_type` with `schema` when they are pushed.
+     * Pass a null schema to keep raw bytes.
+     */
+    void set_schema(const godot::Ref<GrpcSchema>& schema, const godot::String& message_type);
+
+    /**
+     * Add a serialized snapshot.
+     *
+     * @return false if the message has no tick, fails to decode or was dropped
+     */
+    bool push(const godot::PackedByteArray& bytes);
+
+    /**
+     * Find the snapshots bracketing `render_time`.
+     *
+     * @return Dictionary with from, to (bytes or Dictionaries), from_tick,
+     *   to_tick and alpha in [0, 1], so that the interpolated state is
+     *   lerp(from, to, alpha). Outside the buffered range both sides are the
+     *   oldest or newest snapshot. Empty if the buffer is empty.
+     */
+    godot::Dictionary sample(double render_time) const;
+
+    int get_count() const;
+    int64_t get_oldest_tick() const;
+    int64_t get_latest_tick() const;
+    int64_t get_dropped_count() const;
+    void clear();
+
+    // Native API: push straight from a received ByteBuffer (reader thread)
+    bool push_buffer(const grpc::ByteBuffer& buffer);
+
+protected:
+    static void _bind_methods();
+
+private:
+    struct Snapshot {
+        int64_t tick = 0;
+        godot::Variant value;
+    };
+
+    bool push_bytes(const uint8_t* data, size_t size, const godot::PackedByteArray* bytes);
+    static bool read_tick(const uint8_t* data, size_t size, uint32_t tick_field, int64_t* out_tick);
+    const Snapshot& at(size_t index) const { return ring_[(head_ + index) % ring_.size()]; }
+    Snapshot& at(size_t index) { return ring_[(head_ + index) % ring_.size()]; }
+
+    mutable std::mutex mutex_;
+    std::vector<Snapshot> ring_;
+    size_t head_ = 0;  // Index of the oldest snapshot
+    size_t count_ = 0;
+    uint32_t tick_field_ = 1;
+    int64_t dropped_ = 0;
+
+    // plan_ belongs to schema_, which keeps it alive
+    std::shared_ptr<const LoadedSchema> schema_;
+    const DecodePlan* plan_ = nullptr;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_SNAPSHOT_BUFFER_H
@@ -2,15 +2,28 @@
 #include "util/status_map.h"
 #include <grpcpp/support/byte_buffer.h>
 #include <grpcpp/support/slice.h>
+#include <cstring>
 
 namespace godot_grpc {
 
+void record_byte_buffer(traffic::Writer& log, traffic::RecordKind direction, uint64_t call_id,
+                        const grpc::ByteBuffer& buffer) {
+    std::vector<grpc::Slice> slices;
+    (void)buffer.Dump(&slices);
+    std::vector<traffic::BytesPart> parts;
+    parts.reserve(slices.size());
+    for (const auto& slice : slices) {
+        parts.push_back({ slice.begin(), slice.size() });
+    }
+    log.message(direction, call_id, parts.data(), parts.size());
+}
+
 GrpcStream::GrpcStream(
-    int stream_id,
+    int64_t stream_id,
     StreamType stream_type,
     std::shared_ptr<grpc::GenericStub> stub,
     const std::string& method,
-    const godot::PackedByteArray& request_bytes,
+    const StreamBytes& request_bytes,
     std::unique_ptr<grpc::ClientContext> context,
     StreamMessageCallback on_message,
     StreamFinishedCallback on_finished,
@@ -33,14 +46,7 @@ GrpcStream::GrpcStream(
 }
 
 GrpcStream::~GrpcStream() {
-    cancel();
-
-    // Close write queue to unblock writer thread
-    {
-        std::lock_guard<std::mutex> lock(write_queue_mutex_);
-        write_queue_closed_ = true;
-    }
-    write_queue_cv_.notify_all();
+    shutdown();
 
     // Join threads
     if (writer_thread_ && writer_thread_->joinable()) {
@@ -75,10 +81,8 @@ void GrpcStream::start() {
 
     if (!stream_) {
         Logger::error("Failed to prepare stream for method " + method_);
-        if (on_error_) {
-            on_error_(stream_id_, static_cast<int>(grpc::StatusCode::INTERNAL), "Failed to prepare stream");
-        }
         active_.store(false);
+        report_error(static_cast<int>(grpc::StatusCode::INTERNAL), "Failed to prepare stream");
         return;
     }
 
@@ -91,15 +95,14 @@ void GrpcStream::start() {
 
     if (!ok) {
         Logger::error("Failed to start stream");
-        if (on_error_) {
-            on_error_(stream_id_, static_cast<int>(grpc::StatusCode::INTERNAL), "Failed to start stream");
-        }
         active_.store(false);
+        report_error(static_cast<int>(grpc::StatusCode::INTERNAL), "Failed to start stream");
         return;
     }
 
-    // For server-streaming, write the initial request immediately and close writes
-    if (stream_type_ == StreamType::SERVER_STREAMING && initial_request_bytes_.size() > 0) {
+    // For server-streaming, write the initial request immediately and close writes.
+    // An empty request is still a message (all fields default) and must be sent.
+    if (stream_type_ == StreamType::SERVER_STREAMING) {
         grpc::ByteBuffer request_buffer;
         const uint8_t* data = initial_request_bytes_.ptr();
         size_t size = initial_request_bytes_.size();
@@ -117,10 +120,8 @@ void GrpcStream::start() {
             stream_->Finish(&status, (void*)999);
             cq_->Next(&got_tag, &ok);
 
-            if (on_error_) {
-                on_error_(stream_id_, static_cast<int>(status.error_code()), status.error_message());
-            }
             active_.store(false);
+            report_error(static_cast<int>(status.error_code()), status.error_message());
             return;
         }
 
@@ -135,6 +136,15 @@ void GrpcStream::start() {
         write_queue_cv_.notify_one();
     }
 
+    if (method_stats_ && initial_request_bytes_.size() > 0) {
+        method_stats_->add(method_stats_->messages_sent, 1);
+        method_stats_->add(method_stats_->bytes_sent, initial_request_bytes_.size());
+    }
+
+    if (traffic_log_ && initial_request_bytes_.size() > 0) {
+        traffic_log_->message(traffic::SEND, traffic_call_id_, initial_request_bytes_.ptr(), initial_request_bytes_.size());
+    }
+
     // Spawn reader thread
     reader_thread_ = std::make_unique<std::thread>(&GrpcStream::reader_thread, this);
 
@@ -144,6 +154,12 @@ void GrpcStream::start() {
     }
 }
 
+bool GrpcStream::on_stream_thread() const {
+    std::thread::id self = std::this_thread::get_id();
+    return (reader_thread_ && reader_thread_->get_id() == self) ||
+           (writer_thread_ && writer_thread_->get_id() == self);
+}
+
 void GrpcStream::cancel() {
     if (active_.load() && context_) {
         Logger::debug("Cancelling stream " + std::to_string(stream_id_));
@@ -152,7 +168,7 @@ void GrpcStream::cancel() {
     }
 }
 
-bool GrpcStream::send(const godot::PackedByteArray& message_bytes) {
+bool GrpcStream::send(const StreamBytes& message_bytes) {
     if (!active_.load()) {
         Logger::warn("Cannot send on inactive stream " + std::to_string(stream_id_));
         return false;
@@ -168,6 +184,7 @@ bool GrpcStream::send(const godot::PackedByteArray& message_bytes) {
         return false;
     }
 
+    GODOT_GRPC_ALLOC_SCOPE(alloc::STREAM_SEND);
     std::lock_guard<std::mutex> lock(write_queue_mutex_);
     if (write_queue_closed_) {
         return false;
@@ -176,8 +193,19 @@ bool GrpcStream::send(const godot::PackedByteArray& message_bytes) {
     write_queue_.push(message_bytes);
     write_queue_cv_.notify_one();
 
-    Logger::trace("Queued message for stream " + std::to_string(stream_id_) +
-                  ", queue size: " + std::to_string(write_queue_.size()));
+    if (traffic_log_) {
+        traffic_log_->message(traffic::SEND, traffic_call_id_, message_bytes.ptr(), message_bytes.size());
+    }
+
+    if (method_stats_) {
+        method_stats_->add(method_stats_->messages_sent, 1);
+        method_stats_->add(method_stats_->bytes_sent, message_bytes.size());
+    }
+
+    if (Logger::enabled(LogLevel::TRACE)) {
+        Logger::trace("Queued message for stream " + std::to_string(stream_id_) +
+                      ", queue size: " + std::to_string(write_queue_.size()));
+    }
     return true;
 }
 
@@ -196,13 +224,78 @@ void GrpcStream::close_send() {
     write_queue_cv_.notify_all();
 }
 
+bool GrpcStream::wait_writer_finished(std::chrono::steady_clock::time_point deadline) {
+    if (!writer_thread_) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(write_queue_mutex_);
+    return write_queue_cv_.wait_until(lock, deadline, [this] { return writer_finished_; });
+}
+
+void GrpcStream::shutdown() {
+    cancel();
+
+    // Close write queue to unblock writer thread
+    {
+        std::lock_guard<std::mutex> lock(write_queue_mutex_);
+        write_queue_closed_ = true;
+    }
+    write_queue_cv_.notify_all();
+}
+
+void GrpcStream::report_error(int status_code, const std::string& message) {
+    if (method_stats_) {
+        method_stats_->add(method_stats_->errors, 1);
+    }
+    if (traffic_log_) {
+        traffic_log_->finish(traffic_call_id_, status_code, message);
+    }
+    if (on_error_) {
+        on_error_(stream_id_, status_code, message);
+    }
+}
+
+bool GrpcStream::wait_for(void* tag) {
+    // The reader and writer threads share cq_, so whichever thread is polling
+    // parks completions meant for the other one and wakes it up.
+    std::unique_lock<std::mutex> lock(cq_mutex_);
+    while (true) {
+        auto it = cq_completed_.find(tag);
+        if (it != cq_completed_.end()) {
+            bool ok = it->second;
+            cq_completed_.erase(it);
+            return ok;
+        }
+
+        if (cq_polling_) {
+            cq_cv_.wait(lock);
+            continue;
+        }
+
+        cq_polling_ = true;
+        lock.unlock();
+        void* got_tag = nullptr;
+        bool ok = false;
+        bool got_event = cq_->Next(&got_tag, &ok);
+        lock.lock();
+        cq_polling_ = false;
+        if (got_event) {
+            cq_completed_[got_tag] = ok;
+        }
+        cq_cv_.notify_all();
+        if (!got_event) {
+            return false;
+        }
+    }
+}
+
 void GrpcStream::writer_thread() {
     Logger::trace("Writer thread started for stream " + std::to_string(stream_id_));
 
-    int write_tag = 1000;
-
     while (active_.load()) {
-        godot::PackedByteArray message_bytes;
+        // The rest of the send; send() counted the operation
+        GODOT_GRPC_ALLOC_SCOPE(alloc::STREAM_SEND, false);
+        StreamBytes message_bytes;
 
         // Wait for messages in the queue
         {
@@ -219,7 +312,7 @@ void GrpcStream::writer_thread() {
                 continue;
             }
 
-            message_bytes = write_queue_.front();
+            message_bytes = std::move(write_queue_.front());
             write_queue_.pop();
         }
 
@@ -229,37 +322,38 @@ void GrpcStream::writer_thread() {
             const uint8_t* data = message_bytes.ptr();
             size_t size = message_bytes.size();
             grpc::Slice slice(data, size);
+            GODOT_GRPC_ALLOC_NOTE_SLICE(size);
             write_buffer.Clear();
             grpc::ByteBuffer temp(&slice, 1);
             write_buffer.Swap(&temp);
         }
 
         // Write to stream
-        stream_->Write(write_buffer, (void*)(intptr_t)write_tag);
+        stream_->Write(write_buffer, WRITE_TAG);
 
-        void* got_tag;
-        bool ok = false;
-        cq_->Next(&got_tag, &ok);
-
-        if (!ok) {
+        if (!wait_for(WRITE_TAG)) {
             Logger::error("Failed to write message to stream " + std::to_string(stream_id_));
             // Don't call error callback here, reader thread will handle final status
             break;
         }
 
-        Logger::trace("Wrote message to stream " + std::to_string(stream_id_));
-        write_tag++;
+        if (Logger::enabled(LogLevel::TRACE)) {
+            Logger::trace("Wrote message to stream " + std::to_string(stream_id_));
+        }
     }
 
     // Signal writes are done
     if (active_.load() && !writes_done_.exchange(true)) {
         Logger::debug("Calling WritesDone on stream " + std::to_string(stream_id_));
-        stream_->WritesDone((void*)9999);
+        stream_->WritesDone(WRITES_DONE_TAG);
+        wait_for(WRITES_DONE_TAG);
+    }
 
-        void* got_tag;
-        bool ok = false;
-        cq_->Next(&got_tag, &ok);
+    {
+        std::lock_guard<std::mutex> lock(write_queue_mutex_);
+        writer_finished_ = true;
     }
+    write_queue_cv_.notify_all();
 
     Logger::trace("Writer thread finished for stream " + std::to_string(stream_id_));
 }
@@ -268,66 +362,78 @@ void GrpcStream::reader_thread() {
     Logger::trace("Reader thread started for stream " + std::to_string(stream_id_));
 
     // Read messages
-    int read_tag = 10000;
     while (active_.load()) {
         grpc::ByteBuffer response_buffer;
-        stream_->Read(&response_buffer, (void*)(intptr_t)read_tag);
+        stream_->Read(&response_buffer, READ_TAG);
 
-        void* got_tag;
-        bool ok = false;
-        cq_->Next(&got_tag, &ok);
-
-        if (!ok) {
+        if (!wait_for(READ_TAG)) {
             Logger::trace("Stream read completed, ending stream " + std::to_string(stream_id_));
             break;
         }
 
-        // Convert ByteBuffer to PackedByteArray
+        GODOT_GRPC_ALLOC_SCOPE(alloc::STREAM_RECEIVE);
+
+        if (traffic_log_) {
+            record_byte_buffer(*traffic_log_, traffic::RECEIVE, traffic_call_id_, response_buffer);
+        }
+
+        if (method_stats_) {
+            method_stats_->add(method_stats_->messages_received, 1);
+            method_stats_->add(method_stats_->bytes_received, response_buffer.Length());
+        }
+
+        if (on_raw_message_ && on_raw_message_(*this, response_buffer)) {
+            continue;
+        }
+
+        // Convert ByteBuffer to PackedByteArray, sized once up front
         std::vector<grpc::Slice> slices;
         (void)response_buffer.Dump(&slices);
 
-        godot::PackedByteArray response_bytes;
+        StreamBytes response_bytes;
+        response_bytes.resize(response_buffer.Length());
+        GODOT_GRPC_ALLOC_NOTE_STREAM_BYTES(response_bytes.size());
+        size_t offset = 0;
         for (const auto& slice : slices) {
-            size_t slice_size = slice.size();
-            int64_t old_size = response_bytes.size();
-            response_bytes.resize(old_size + slice_size);
-            memcpy(response_bytes.ptrw() + old_size, slice.begin(), slice_size);
+            memcpy(response_bytes.ptrw() + offset, slice.begin(), slice.size());
+            offset += slice.size();
         }
 
-        Logger::trace("Stream " + std::to_string(stream_id_) + " received " +
-                      std::to_string(response_bytes.size()) + " bytes");
+        if (Logger::enabled(LogLevel::TRACE)) {
+            Logger::trace("Stream " + std::to_string(stream_id_) + " received " +
+                          std::to_string(response_bytes.size()) + " bytes");
+        }
 
         if (on_message_) {
             on_message_(stream_id_, response_bytes);
         }
-
-        read_tag++;
     }
 
+    // No more sends from here on; owners may also rely on is_active() being
+    // false by the time the callbacks below run
+    active_.store(false);
+
     // Finish the call and get status
     grpc::Status status;
-    stream_->Finish(&status, (void*)99999);
-
-    void* got_tag;
-    bool ok = false;
-    cq_->Next(&got_tag, &ok);
+    stream_->Finish(&status, FINISH_TAG);
+    wait_for(FINISH_TAG);
 
     Logger::debug("Stream " + std::to_string(stream_id_) + " finished with status: " +
                   StatusMap::status_code_string(status.error_code()));
 
     if (status.ok()) {
+        if (traffic_log_) {
+            traffic_log_->finish(traffic_call_id_, static_cast<int>(status.error_code()), status.error_message());
+        }
         if (on_finished_) {
             on_finished_(stream_id_, static_cast<int>(status.error_code()), status.error_message());
         }
     } else {
         std::string error_msg = StatusMap::format_error(status);
         Logger::error("Stream " + std::to_string(stream_id_) + " error: " + error_msg);
-        if (on_error_) {
-            on_error_(stream_id_, static_cast<int>(status.error_code()), status.error_message());
-        }
+        report_error(static_cast<int>(status.error_code()), status.error_message());
     }
 
-    active_.store(false);
     Logger::trace("Reader thread finished for stream " + std::to_string(stream_id_));
 }
 
@@ -3,25 +3,71 @@
 
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/generic/generic_stub.h>
+#include "util/alloc_stats.h"
+#include "util/method_table.h"
+#include "util/traffic_log.h"
+#ifndef GODOT_GRPC_NO_GODOT
 #include <godot_cpp/variant/packed_byte_array.hpp>
+#endif
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <thread>
 #include <functional>
 #include <queue>
+#include <unordered_map>
 #include <condition_variable>
+#include <vector>
 
 namespace godot_grpc {
 
+/**
+ * Message bytes as streams see them. Standalone builds (GODOT_GRPC_NO_GODOT,
+ * used by the load generator) swap PackedByteArray for a vector with the
+ * same accessors so the stream code compiles without godot-cpp.
+ */
+#ifdef GODOT_GRPC_NO_GODOT
+struct StreamBytes : std::vector<uint8_t> {
+    using std::vector<uint8_t>::vector;
+    const uint8_t* ptr() const { return data(); }
+    uint8_t* ptrw() { return data(); }
+};
+#else
+using StreamBytes = godot::PackedByteArray;
+#endif
+
 /**
  * Callback types for stream events.
  * These callbacks are invoked from background threads and must be
  * thread-safe. The recipient should dispatch to the main thread.
  */
-using StreamMessageCallback = std::function<void(int stream_id, const godot::PackedByteArray& data)>;
-using StreamFinishedCallback = std::function<void(int stream_id, int status_code, const std::string& message)>;
-using StreamErrorCallback = std::function<void(int stream_id, int status_code, const std::string& message)>;
+using StreamMessageCallback = std::function<void(int64_t stream_id, const StreamBytes& data)>;
+using StreamFinishedCallback = std::function<void(int64_t stream_id, int status_code, const std::string& message)>;
+using StreamErrorCallback = std::function<void(int64_t stream_id, int status_code, const std::string& message)>;
+
+class GrpcStream;
+
+/**
+ * Optional hook that sees each received message before it is copied into a
+ * PackedByteArray. Runs on the reader thread; returning true consumes the
+ * message and skips the message callback. The handler may send() on the
+ * stream it is given.
+ */
+using StreamRawMessageHandler = std::function<bool(GrpcStream& stream, const grpc::ByteBuffer& buffer)>;
+
+/**
+ * Append a ByteBuffer to a traffic log without flattening it first.
+ */
+void record_byte_buffer(traffic::Writer& log, traffic::RecordKind direction, uint64_t call_id,
+                        const grpc::ByteBuffer& buffer);
+
+/**
+ * Count a slice copied from caller memory in the allocation stats: gRPC
+ * heap-allocates those unless they are small enough to be inlined.
+ */
+#define GODOT_GRPC_ALLOC_NOTE_SLICE(size) \
+    do { if ((size) > GRPC_SLICE_INLINED_SIZE) { GODOT_GRPC_ALLOC_NOTE(size); } } while (0)
 
 /**
  * Stream type enum for different gRPC streaming patterns.
@@ -40,11 +86,11 @@ enum class StreamType {
 class GrpcStream {
 public:
     GrpcStream(
-        int stream_id,
+        int64_t stream_id,
         StreamType stream_type,
         std::shared_ptr<grpc::GenericStub> stub,
         const std::string& method,
-        const godot::PackedByteArray& request_bytes,
+        const StreamBytes& request_bytes,
         std::unique_ptr<grpc::ClientContext> context,
         StreamMessageCallback on_message,
         StreamFinishedCallback on_finished,
@@ -53,6 +99,20 @@ public:
 
     ~GrpcStream();
 
+    // Install a raw message handler. Must be called before start().
+    void set_raw_message_handler(StreamRawMessageHandler handler) { on_raw_message_ = std::move(handler); }
+
+    // Record sent and received messages and the final status into `log`
+    // under `call_id` (see GrpcRecorder). Must be called before start().
+    void set_traffic_log(std::shared_ptr<traffic::Writer> log, uint64_t call_id) {
+        traffic_log_ = std::move(log);
+        traffic_call_id_ = call_id;
+    }
+
+    // Count messages, bytes and errors into `stats`, which must outlive the
+    // stream. Must be called before start().
+    void set_method_stats(methods::Stats* stats) { method_stats_ = stats; }
+
     // Start the stream (spawns the reader/writer threads).
     void start();
 
@@ -61,31 +121,65 @@ public:
 
     // Send a message on the stream (for client-streaming and bidirectional).
     // Returns true if queued successfully, false if stream is closed.
-    bool send(const godot::PackedByteArray& message_bytes);
+    bool send(const StreamBytes& message_bytes);
 
     // Close the send side of the stream (calls WritesDone).
     void close_send();
 
+    // Wait until the writer thread has written everything queued and exited
+    // (after close_send() or cancel()), or until `deadline`. Returns true if
+    // it has; streams without a writer thread return true at once.
+    bool wait_writer_finished(std::chrono::steady_clock::time_point deadline);
+
+    // Cancel and wake the writer thread without joining, so many streams can
+    // wind down in parallel before their destructors join them.
+    void shutdown();
+
     // Get the stream ID.
-    int get_id() const { return stream_id_; }
+    int64_t get_id() const { return stream_id_; }
 
-    // Check if the stream is still active.
+    // Check if the stream is still active. Turns false before the finished
+    // or error callback runs.
     bool is_active() const { return active_.load(); }
 
+    // True when called from this stream's reader or writer thread (i.e. from
+    // one of its callbacks), where destroying the stream would join the
+    // calling thread.
+    bool on_stream_thread() const;
+
 private:
     void reader_thread();
     void writer_thread();
 
-    int stream_id_;
+    // Block until the operation tagged `tag` completes; returns its ok flag.
+    // Safe to call from the reader and writer threads at the same time.
+    bool wait_for(void* tag);
+
+    // Invoke on_error_, recording the status first when a traffic log is set
+    void report_error(int status_code, const std::string& message);
+
+    // One tag per operation kind; each has at most one operation in flight
+    static inline void* const READ_TAG = reinterpret_cast<void*>(10);
+    static inline void* const WRITE_TAG = reinterpret_cast<void*>(11);
+    static inline void* const WRITES_DONE_TAG = reinterpret_cast<void*>(12);
+    static inline void* const FINISH_TAG = reinterpret_cast<void*>(13);
+
+    int64_t stream_id_;
     StreamType stream_type_;
     std::shared_ptr<grpc::GenericStub> stub_;
     std::string method_;
-    godot::PackedByteArray initial_request_bytes_;
+    StreamBytes initial_request_bytes_;
     std::unique_ptr<grpc::ClientContext> context_;
 
     StreamMessageCallback on_message_;
     StreamFinishedCallback on_finished_;
     StreamErrorCallback on_error_;
+    StreamRawMessageHandler on_raw_message_;
+
+    std::shared_ptr<traffic::Writer> traffic_log_;
+    uint64_t traffic_call_id_ = 0;
+
+    methods::Stats* method_stats_ = nullptr;
 
     std::atomic<bool> active_;
     std::atomic<bool> writes_done_;
@@ -95,12 +189,19 @@ private:
     // Write queue for client-streaming and bidirectional
     std::mutex write_queue_mutex_;
     std::condition_variable write_queue_cv_;
-    std::queue<godot::PackedByteArray> write_queue_;
+    std::queue<StreamBytes> write_queue_;
     bool write_queue_closed_;
+    bool writer_finished_ = false;
 
     // Shared stream object
     std::shared_ptr<grpc::GenericClientAsyncReaderWriter> stream_;
     std::shared_ptr<grpc::CompletionQueue> cq_;
+
+    // Completions picked up by one thread on behalf of the other (see wait_for)
+    std::mutex cq_mutex_;
+    std::condition_variable cq_cv_;
+    std::unordered_map<void*, bool> cq_completed_;
+    bool cq_polling_ = false;
 };
 
 } // namespace godot_grpc
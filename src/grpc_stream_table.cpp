@@ -0,0 +1,77 @@
+#include "grpc_stream_table.h"
+#include <atomic>
+
+namespace godot_grpc {
+
+int64_t StreamTable::allocate_id() {
+    static std::atomic<int64_t> next_id{1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StreamTable::add(std::unique_ptr<GrpcStream> stream) {
+    // The stream's end callback retires it under the same shard lock, so it
+    // either finds the stream here or ran before the is_active() check
+    Shard& shard = shard_for(stream->get_id());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (stream->is_active()) {
+        int64_t stream_id = stream->get_id();
+        shard.streams[stream_id] = std::move(stream);
+    } else {
+        std::lock_guard<std::mutex> finished_lock(finished_mutex_);
+        finished_.push_back(std::move(stream));
+    }
+}
+
+std::unique_ptr<GrpcStream> StreamTable::take(int64_t stream_id) {
+    Shard& shard = shard_for(stream_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.streams.find(stream_id);
+    if (it == shard.streams.end()) {
+        return nullptr;
+    }
+    std::unique_ptr<GrpcStream> stream = std::move(it->second);
+    shard.streams.erase(it);
+    return stream;
+}
+
+void StreamTable::retire(int64_t stream_id) {
+    Shard& shard = shard_for(stream_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.streams.find(stream_id);
+    if (it == shard.streams.end()) {
+        return;
+    }
+    std::lock_guard<std::mutex> finished_lock(finished_mutex_);
+    finished_.push_back(std::move(it->second));
+    shard.streams.erase(it);
+}
+
+void StreamTable::park(std::unique_ptr<GrpcStream> stream) {
+    std::lock_guard<std::mutex> lock(finished_mutex_);
+    finished_.push_back(std::move(stream));
+}
+
+std::vector<std::unique_ptr<GrpcStream>> StreamTable::take_finished() {
+    std::vector<std::unique_ptr<GrpcStream>> streams;
+    std::lock_guard<std::mutex> lock(finished_mutex_);
+    streams.swap(finished_);
+    return streams;
+}
+
+std::vector<std::unique_ptr<GrpcStream>> StreamTable::take_all() {
+    std::vector<std::unique_ptr<GrpcStream>> streams;
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto& pair : shard.streams) {
+            streams.push_back(std::move(pair.second));
+        }
+        shard.streams.clear();
+    }
+    std::vector<std::unique_ptr<GrpcStream>> finished = take_finished();
+    for (auto& stream : finished) {
+        streams.push_back(std::move(stream));
+    }
+    return streams;
+}
+
+} // namespace godot_grpc
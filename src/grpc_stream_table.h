@@ -0,0 +1,91 @@
+#ifndef GODOT_GRPC_STREAM_TABLE_H
+#define GODOT_GRPC_STREAM_TABLE_H
+
+#include "grpc_stream.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace godot_grpc {
+
+/**
+ * StreamTable: A client's streams by ID, for concurrent lookup.
+ *
+ * Active streams are spread over independently locked shards by ID, so a
+ * stream starting on the main thread, sends and cancels on other streams,
+ * and reader threads retiring their own streams rarely wait on each other.
+ *
+ * A stream's destructor joins its threads, which may be waiting on a shard
+ * lock in a callback, so streams are never destroyed under a lock, nor on
+ * their own threads: take() and take_all() hand them to the caller, and
+ * retired ones are parked until take_finished().
+ */
+class StreamTable {
+public:
+    // Process-wide stream IDs (from 1), never reused, so they can key data
+    // shared between clients. Lock-free.
+    static int64_t allocate_id();
+
+    /**
+     * Add a started stream. One that already ended (failed start, or a server
+     * that finished at once) ran its callback before it could be found, so it
+     * is parked instead.
+     */
+    void add(std::unique_ptr<GrpcStream> stream);
+
+    /**
+     * Call fn(GrpcStream&) on an active stream under its shard lock, which
+     * keeps the stream alive meanwhile. Returns false if there is none.
+     */
+    template <typename Fn>
+    bool with_stream(int64_t stream_id, Fn&& fn) {
+        Shard& shard = shard_for(stream_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.streams.find(stream_id);
+        if (it == shard.streams.end()) {
+            return false;
+        }
+        fn(*it->second);
+        return true;
+    }
+
+    // Remove an active stream; nullptr if there is none
+    std::unique_ptr<GrpcStream> take(int64_t stream_id);
+
+    // Move an active stream to the finished list (from its own callbacks)
+    void retire(int64_t stream_id);
+
+    // Keep a stream until the next take_finished()
+    void park(std::unique_ptr<GrpcStream> stream);
+
+    std::vector<std::unique_ptr<GrpcStream>> take_finished();
+
+    // Every stream, active and finished
+    std::vector<std::unique_ptr<GrpcStream>> take_all();
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    // Cache-line aligned so neighbouring shards' locks do not share a line
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<int64_t, std::unique_ptr<GrpcStream>> streams;
+    };
+
+    Shard& shard_for(int64_t stream_id) {
+        return shards_[static_cast<uint64_t>(stream_id) % SHARD_COUNT];
+    }
+
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    // Locked after a shard lock, never before
+    std::mutex finished_mutex_;
+    std::vector<std::unique_ptr<GrpcStream>> finished_;
+};
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_STREAM_TABLE_H
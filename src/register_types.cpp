@@ -1,13 +1,47 @@
 #include "register_types.h"
+#include "grpc_call_options.h"
 #include "grpc_client.h"
+#include "grpc_mock_server.h"
+#include "grpc_mux.h"
+#include "grpc_proto_reader.h"
+#include "grpc_proto_writer.h"
+#include "grpc_recorder.h"
+#include "grpc_runtime.h"
+#include "grpc_schema.h"
+#include "grpc_snapshot_buffer.h"
+#include "util/runtime_init.h"
 #include "util/status_map.h"
 
 #include <godot_cpp/core/defs.hpp>
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/godot.hpp>
 
 using namespace godot;
 
+namespace {
+
+const char* const INITIALIZE_ON_STARTUP_SETTING = "network/grpc/initialize_on_startup";
+
+godot_grpc::GrpcRuntime* runtime_singleton = nullptr;
+
+// Off by default: gRPC then starts on the first connect(), as it always has
+bool initialize_on_startup() {
+    ProjectSettings* settings = ProjectSettings::get_singleton();
+    if (!settings->has_setting(INITIALIZE_ON_STARTUP_SETTING)) {
+        settings->set_setting(INITIALIZE_ON_STARTUP_SETTING, false);
+    }
+    settings->set_initial_value(INITIALIZE_ON_STARTUP_SETTING, false);
+    Dictionary info;
+    info["name"] = INITIALIZE_ON_STARTUP_SETTING;
+    info["type"] = Variant::BOOL;
+    settings->add_property_info(info);
+    return settings->get_setting(INITIALIZE_ON_STARTUP_SETTING);
+}
+
+} // namespace
+
 void initialize_godot_grpc_module(ModuleInitializationLevel p_level) {
     if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
         return;
@@ -16,6 +50,21 @@ void initialize_godot_grpc_module(ModuleInitializationLevel p_level) {
     godot_grpc::Logger::info("Initializing godot_grpc extension");
 
     ClassDB::register_class<godot_grpc::GrpcClient>();
+    ClassDB::register_class<godot_grpc::GrpcCallOptions>();
+    ClassDB::register_class<godot_grpc::GrpcProtoWriter>();
+    ClassDB::register_class<godot_grpc::GrpcProtoReader>();
+    ClassDB::register_class<godot_grpc::GrpcSchema>();
+    ClassDB::register_class<godot_grpc::GrpcSnapshotBuffer>();
+    ClassDB::register_class<godot_grpc::GrpcMux>();
+    ClassDB::register_class<godot_grpc::GrpcRecorder>();
+    ClassDB::register_class<godot_grpc::GrpcMockServer>();
+    ClassDB::register_class<godot_grpc::GrpcRuntime>();
+
+    runtime_singleton = memnew(godot_grpc::GrpcRuntime);
+    Engine::get_singleton()->register_singleton("GrpcRuntime", runtime_singleton);
+    if (initialize_on_startup()) {
+        runtime_singleton->initialize_async();
+    }
 
     godot_grpc::Logger::info("godot_grpc extension initialized");
 }
@@ -26,6 +75,12 @@ void uninitialize_godot_grpc_module(ModuleInitializationLevel p_level) {
     }
 
     godot_grpc::Logger::info("Uninitializing godot_grpc extension");
+
+    // Joins a background initialization that is still running
+    godot_grpc::runtime::shutdown();
+    Engine::get_singleton()->unregister_singleton("GrpcRuntime");
+    memdelete(runtime_singleton);
+    runtime_singleton = nullptr;
 }
 
 extern "C" {
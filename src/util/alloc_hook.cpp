@@ -0,0 +1,71 @@
+// Global operator new hook feeding alloc::note(). Link it into standalone
+// executables built with GODOT_GRPC_ALLOC_STATS (the load generator); never
+// into the extension, where replacing operator new would reach into Godot.
+
+#include "alloc_stats.h"
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+void* counted_alloc(std::size_t size) {
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    godot_grpc::alloc::note(size);
+    return ptr;
+}
+
+void* counted_alloc_aligned(std::size_t size, std::align_val_t alignment) {
+    std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    void* ptr = _aligned_malloc(size ? size : 1, align);
+#else
+    // aligned_alloc wants a multiple of the alignment
+    void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    godot_grpc::alloc::note(size);
+    return ptr;
+}
+
+void free_aligned(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return counted_alloc_aligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return counted_alloc_aligned(size, alignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    void* ptr = std::malloc(size ? size : 1);
+    if (ptr) {
+        godot_grpc::alloc::note(size);
+    }
+    return ptr;
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { free_aligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { free_aligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { free_aligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { free_aligned(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
@@ -0,0 +1,70 @@
+#include "alloc_stats.h"
+#include <atomic>
+
+namespace godot_grpc {
+
+namespace alloc {
+
+namespace {
+
+// Plain integers: only the owning thread touches them, and the operator new
+// hook may run before any atomic or lock could be initialised
+thread_local uint64_t t_allocations = 0;
+thread_local uint64_t t_bytes = 0;
+
+struct Totals {
+    std::atomic<uint64_t> operations{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+Totals g_totals[OP_COUNT];
+
+} // namespace
+
+const char* op_name(Op op) {
+    switch (op) {
+        case UNARY_CALL: return "unary_call";
+        case STREAM_RECEIVE: return "stream_receive";
+        case STREAM_SEND: return "stream_send";
+        default: return "unknown";
+    }
+}
+
+void note(size_t bytes) {
+    t_allocations++;
+    t_bytes += bytes;
+}
+
+Counters snapshot(Op op) {
+    Counters counters;
+    counters.operations = g_totals[op].operations.load(std::memory_order_relaxed);
+    counters.allocations = g_totals[op].allocations.load(std::memory_order_relaxed);
+    counters.bytes = g_totals[op].bytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+void reset() {
+    for (Totals& totals : g_totals) {
+        totals.operations.store(0, std::memory_order_relaxed);
+        totals.allocations.store(0, std::memory_order_relaxed);
+        totals.bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+Scope::Scope(Op op, bool count_operation)
+    : op_(op), count_operation_(count_operation), allocations_(t_allocations), bytes_(t_bytes) {
+}
+
+Scope::~Scope() {
+    Totals& totals = g_totals[op_];
+    if (count_operation_) {
+        totals.operations.fetch_add(1, std::memory_order_relaxed);
+    }
+    totals.allocations.fetch_add(t_allocations - allocations_, std::memory_order_relaxed);
+    totals.bytes.fetch_add(t_bytes - bytes_, std::memory_order_relaxed);
+}
+
+} // namespace alloc
+
+} // namespace godot_grpc
@@ -0,0 +1,89 @@
+#ifndef GODOT_GRPC_ALLOC_STATS_H
+#define GODOT_GRPC_ALLOC_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace godot_grpc {
+
+/**
+ * Heap allocation counters for the per-message hot paths, compiled in only
+ * with -DGODOT_GRPC_ALLOC_STATS=ON (the macros below are empty otherwise).
+ *
+ * Allocations are counted per thread and attributed to whichever Scope is
+ * open on that thread. Two sources feed the count:
+ *  - note(): buffers the conversion code allocates outside operator new,
+ *    i.e. gRPC slice copies (gpr_malloc) and, in Godot builds,
+ *    PackedByteArray storage;
+ *  - a global operator new hook (alloc_hook.cpp), linked into the load
+ *    generator but never into the extension, since Godot owns the process
+ *    allocator. With it every C++ allocation on the thread is counted too.
+ *
+ * Free of Godot types so native benchmarks can report the same counters.
+ */
+namespace alloc {
+
+enum Op {
+    UNARY_CALL,      // GrpcClient::unary, request to response
+    STREAM_RECEIVE,  // One message on a stream reader thread
+    STREAM_SEND,     // One message from send() through the writer thread
+    OP_COUNT
+};
+
+struct Counters {
+    uint64_t operations = 0;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+const char* op_name(Op op);
+
+// Count an allocation on the calling thread
+void note(size_t bytes);
+
+Counters snapshot(Op op);
+void reset();
+
+/**
+ * Attributes the calling thread's allocations between construction and
+ * destruction to `op`. Work for one operation that spans threads opens a
+ * scope on each, with count_operation set on only one of them.
+ */
+class Scope {
+public:
+    explicit Scope(Op op, bool count_operation = true);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    Op op_;
+    bool count_operation_;
+    uint64_t allocations_;
+    uint64_t bytes_;
+};
+
+} // namespace alloc
+
+} // namespace godot_grpc
+
+#ifdef GODOT_GRPC_ALLOC_STATS
+#define GODOT_GRPC_ALLOC_SCOPE(...) ::godot_grpc::alloc::Scope godot_grpc_alloc_scope_(__VA_ARGS__)
+#define GODOT_GRPC_ALLOC_NOTE(bytes) ::godot_grpc::alloc::note(bytes)
+#else
+#define GODOT_GRPC_ALLOC_SCOPE(...) ((void)0)
+#define GODOT_GRPC_ALLOC_NOTE(bytes) ((void)0)
+#endif
+
+// StreamBytes is a PackedByteArray (Godot's allocator, noted by hand) in the
+// extension, but a std::vector the operator new hook already sees in
+// standalone builds
+#ifdef GODOT_GRPC_NO_GODOT
+#define GODOT_GRPC_ALLOC_NOTE_STREAM_BYTES(bytes) ((void)0)
+#else
+#define GODOT_GRPC_ALLOC_NOTE_STREAM_BYTES(bytes) \
+    do { if ((bytes) > 0) { GODOT_GRPC_ALLOC_NOTE(bytes); } } while (0)
+#endif
+
+#endif // GODOT_GRPC_ALLOC_STATS_H
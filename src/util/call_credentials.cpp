@@ -0,0 +1,271 @@
+#include "call_credentials.h"
+#include "status_map.h"
+#include "wire_format.h"
+#include <grpcpp/completion_queue.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+#include <algorithm>
+#include <vector>
+
+namespace godot_grpc {
+
+namespace auth {
+
+namespace {
+
+// Lifetimes beyond this are treated as this, keeping time points in range
+constexpr double MAX_LIFETIME_S = 1e8;
+
+TokenCache::Clock::duration seconds(double value) {
+    return std::chrono::duration_cast<TokenCache::Clock::duration>(std::chrono::duration<double>(value));
+}
+
+class TokenPlugin : public grpc::MetadataCredentialsPlugin {
+public:
+    explicit TokenPlugin(std::shared_ptr<TokenCache> cache) : cache_(std::move(cache)) {}
+
+    // Only reads the cache, so gRPC may run it inline on the calling thread
+    bool IsBlocking() const override { return false; }
+
+    const char* GetType() const override { return "godot_grpc.token"; }
+
+    grpc::Status GetMetadata(grpc::string_ref service_url, grpc::string_ref method_name,
+                             const grpc::AuthContext& channel_auth_context,
+                             std::multimap<std::string, std::string>* metadata) override {
+        std::string value;
+        std::string error;
+        if (!cache_->header_value(&value, &error)) {
+            return grpc::Status(grpc::StatusCode::UNAUTHENTICATED, error);
+        }
+        metadata->emplace(cache_->header(), std::move(value));
+        return grpc::Status::OK;
+    }
+
+    std::string DebugString() override { return "godot_grpc token credentials"; }
+
+private:
+    std::shared_ptr<TokenCache> cache_;
+};
+
+} // namespace
+
+TokenCache::TokenCache(TokenSettings settings, RefreshFunction refresh, FailureCallback on_failure)
+    : settings_(std::move(settings))
+    , refresh_(std::move(refresh))
+    , on_failure_(std::move(on_failure)) {
+    if (!settings_.token.empty()) {
+        apply_token(settings_.token, settings_.expires_in_s);
+    } else if (refresh_) {
+        refresh_at_ = Clock::now();
+    }
+    if (refresh_) {
+        thread_ = std::thread(&TokenCache::run, this);
+    }
+}
+
+TokenCache::~TokenCache() {
+    stop();
+}
+
+void TokenCache::set_token(const std::string& token, double expires_in_s) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        apply_token(token, expires_in_s);
+    }
+    cv_.notify_all();
+}
+
+void TokenCache::apply_token(const std::string& token, double expires_in_s) {
+    value_ = token.empty() ? std::string() : settings_.prefix + token;
+    failures_ = 0;
+    retry_at_ = Clock::time_point::min();
+    if (expires_in_s > 0.0) {
+        double lifetime_s = std::min(expires_in_s, MAX_LIFETIME_S);
+        double margin_s = std::min(settings_.refresh_margin_s, lifetime_s / 2.0);
+        Clock::time_point now = Clock::now();
+        expires_at_ = now + seconds(lifetime_s);
+        refresh_at_ = refresh_ ? now + seconds(lifetime_s - margin_s) : Clock::time_point::max();
+    } else {
+        expires_at_ = Clock::time_point::max();
+        refresh_at_ = Clock::time_point::max();
+    }
+}
+
+void TokenCache::refresh_failed(const std::string& error) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failures_++;
+        std::chrono::seconds delay(1LL << std::min(failures_ - 1, 6));
+        retry_at_ = Clock::now() + std::min<Clock::duration>(delay, MAX_RETRY_DELAY);
+    }
+    cv_.notify_all();
+    Logger::warn("Call credentials: " + error);
+    if (on_failure_) {
+        on_failure_(error);
+    }
+}
+
+bool TokenCache::header_value(std::string* value, std::string* error) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (value_.empty()) {
+        *error = "no access token";
+        return false;
+    }
+    if (expires_at_ != Clock::time_point::max() && Clock::now() >= expires_at_) {
+        *error = "access token expired";
+        return false;
+    }
+    *value = value_;
+    return true;
+}
+
+bool TokenCache::begin_refresh_call(grpc::ClientContext* context) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+        return false;
+    }
+    refresh_context_ = context;
+    return true;
+}
+
+bool TokenCache::end_refresh_call() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    refresh_context_ = nullptr;
+    return !stopped_;
+}
+
+void TokenCache::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        // A refresh call would otherwise hold up the join until its deadline
+        if (refresh_context_) {
+            refresh_context_->TryCancel();
+        }
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void TokenCache::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_) {
+        Clock::time_point due = std::max(refresh_at_, retry_at_);
+        if (due == Clock::time_point::max()) {
+            cv_.wait(lock);
+            continue;
+        }
+        if (Clock::now() < due) {
+            cv_.wait_until(lock, due);
+            continue;
+        }
+        // Start again if no outcome is reported in time
+        retry_at_ = Clock::now() + REFRESH_TIMEOUT;
+        lock.unlock();
+        refresh_(*this);
+        lock.lock();
+    }
+}
+
+std::shared_ptr<grpc::CallCredentials> make_call_credentials(std::shared_ptr<TokenCache> cache, bool allow_insecure) {
+    std::unique_ptr<grpc::MetadataCredentialsPlugin> plugin(new TokenPlugin(std::move(cache)));
+    if (allow_insecure) {
+        return grpc::experimental::MetadataCredentialsFromPlugin(std::move(plugin), GRPC_SECURITY_NONE);
+    }
+    return grpc::MetadataCredentialsFromPlugin(std::move(plugin));
+}
+
+TokenCache::RefreshFunction unary_refresher(
+    UnaryRefresh spec, std::function<std::shared_ptr<grpc::GenericStub>()> get_stub) {
+    return [spec = std::move(spec), get_stub = std::move(get_stub)](TokenCache& cache) {
+        std::shared_ptr<grpc::GenericStub> stub = get_stub();
+        if (!stub) {
+            cache.refresh_failed("token refresh: not connected");
+            return;
+        }
+
+        grpc::ClientContext context;
+        context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(spec.timeout_ms));
+        if (!cache.begin_refresh_call(&context)) {
+            return;
+        }
+        grpc::Slice slice(spec.request);
+        grpc::ByteBuffer request_buffer(&slice, 1);
+        grpc::ByteBuffer response_buffer;
+        grpc::Status status;
+        grpc::CompletionQueue cq;
+        std::unique_ptr<grpc::GenericClientAsyncResponseReader> rpc(
+            stub->PrepareUnaryCall(&context, spec.method, request_buffer, &cq));
+        rpc->StartCall();
+        rpc->Finish(&response_buffer, &status, (void*)1);
+        void* got_tag;
+        bool ok = false;
+        cq.Next(&got_tag, &ok);
+        if (!cache.end_refresh_call()) {
+            return; // Cancelled by stop()
+        }
+        if (!ok || !status.ok()) {
+            cache.refresh_failed("token refresh failed: " + StatusMap::format_error(status));
+            return;
+        }
+
+        std::vector<grpc::Slice> slices;
+        (void)response_buffer.Dump(&slices);
+        std::string response;
+        response.reserve(response_buffer.Length());
+        for (const auto& part : slices) {
+            response.append(reinterpret_cast<const char*>(part.begin()), part.size());
+        }
+
+        std::string token;
+        double expires_in_s = 0.0;
+        if (!parse_token_response(reinterpret_cast<const uint8_t*>(response.data()), response.size(),
+                                  spec.token_field, spec.expires_in_field, &token, &expires_in_s)) {
+            cache.refresh_failed("token refresh: no token in the response");
+            return;
+        }
+        cache.set_token(token, expires_in_s);
+    };
+}
+
+bool parse_token_response(const uint8_t* data, size_t size, uint32_t token_field, uint32_t expires_in_field,
+                          std::string* token, double* expires_in_s) {
+    token->clear();
+    *expires_in_s = 0.0;
+    size_t pos = 0;
+    while (pos < size) {
+        uint64_t tag;
+        if (!wire::decode_varint(data, size, &pos, &tag)) {
+            return false;
+        }
+        uint32_t field_number = static_cast<uint32_t>(tag >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(tag & 0x7);
+        if (field_number == token_field && wire_type == wire::LENGTH_DELIMITED) {
+            uint64_t length;
+            if (!wire::decode_varint(data, size, &pos, &length) || length > size - pos) {
+                return false;
+            }
+            token->assign(reinterpret_cast<const char*>(data + pos), static_cast<size_t>(length));
+            pos += static_cast<size_t>(length);
+            continue;
+        }
+        if (expires_in_field != 0 && field_number == expires_in_field && wire_type == wire::VARINT) {
+            uint64_t value;
+            if (!wire::decode_varint(data, size, &pos, &value)) {
+                return false;
+            }
+            *expires_in_s = static_cast<double>(static_cast<int64_t>(value));
+            continue;
+        }
+        if (!wire::skip_field(data, size, &pos, wire_type, field_number)) {
+            return false;
+        }
+    }
+    return !token->empty();
+}
+
+} // namespace auth
+
+} // namespace godot_grpc
@@ -0,0 +1,159 @@
+#ifndef GODOT_GRPC_CALL_CREDENTIALS_H
+#define GODOT_GRPC_CALL_CREDENTIALS_H
+
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/security/credentials.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace godot_grpc {
+
+/**
+ * Bearer tokens attached by gRPC itself instead of per-call metadata.
+ *
+ * A TokenCache holds the current token, preformatted as its header value,
+ * and refreshes it on its own thread ahead of expiry. The call credentials
+ * from make_call_credentials() copy the cached value into each call's
+ * metadata as the call starts, so attaching a token costs one string copy
+ * and never waits for a refresh. Without a valid token, calls fail before
+ * leaving the client (gRPC reports UNAVAILABLE, "Getting metadata from
+ * plugin failed").
+ *
+ * Free of Godot types so native tools can authenticate the same way.
+ */
+namespace auth {
+
+struct TokenSettings {
+    std::string header = "authorization";
+    std::string prefix = "Bearer ";
+    // Refresh this long before expiry, or at half the lifetime if shorter
+    double refresh_margin_s = 60.0;
+
+    // Initial token, if one is already known (see set_token())
+    std::string token;
+    double expires_in_s = 0.0;
+};
+
+class TokenCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Starts a refresh on the cache's thread. The outcome is reported with
+     * set_token() or refresh_failed(), from any thread and at any time; a
+     * refresh with no outcome after REFRESH_TIMEOUT is started again.
+     */
+    using RefreshFunction = std::function<void(TokenCache& cache)>;
+    using FailureCallback = std::function<void(const std::string& error)>;
+
+    static constexpr std::chrono::seconds REFRESH_TIMEOUT{30};
+    static constexpr std::chrono::seconds MAX_RETRY_DELAY{60};
+
+    /**
+     * Without `refresh`, tokens only change through set_token(). With it, the
+     * first refresh starts at once when there is no initial token.
+     */
+    TokenCache(TokenSettings settings, RefreshFunction refresh = nullptr, FailureCallback on_failure = nullptr);
+    ~TokenCache();
+
+    TokenCache(const TokenCache&) = delete;
+    TokenCache& operator=(const TokenCache&) = delete;
+
+    /**
+     * Replace the token. expires_in_s <= 0 means it never expires (and is
+     * never refreshed).
+     */
+    void set_token(const std::string& token, double expires_in_s);
+
+    // Retried with exponential backoff up to MAX_RETRY_DELAY
+    void refresh_failed(const std::string& error);
+
+    /**
+     * Header value for a call starting now. Returns false with `error` set
+     * when there is no token or it has expired.
+     */
+    bool header_value(std::string* value, std::string* error) const;
+
+    const std::string& header() const { return settings_.header; }
+
+    /**
+     * For refresh functions that make a gRPC call: register its context so
+     * stop() cancels the call instead of waiting for its deadline. Returns
+     * false, registering nothing, once the cache is stopping.
+     */
+    bool begin_refresh_call(grpc::ClientContext* context);
+
+    /**
+     * Unregister the context before it is destroyed. Returns false if the
+     * cache stopped meanwhile, in which case the outcome is not reported.
+     */
+    bool end_refresh_call();
+
+    // Cancel a registered refresh call and join the refresh thread; no
+    // refresh starts afterwards. Idempotent.
+    void stop();
+
+private:
+    void apply_token(const std::string& token, double expires_in_s);
+    void run();
+
+    TokenSettings settings_;
+    RefreshFunction refresh_;
+    FailureCallback on_failure_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::string value_;  // prefix + token
+    Clock::time_point expires_at_ = Clock::time_point::max();
+    Clock::time_point refresh_at_ = Clock::time_point::max();
+    Clock::time_point retry_at_ = Clock::time_point::min();
+    int failures_ = 0;
+    bool stopped_ = false;
+    grpc::ClientContext* refresh_context_ = nullptr;
+    std::thread thread_;
+};
+
+/**
+ * Call credentials backed by `cache`. gRPC only sends them over TLS unless
+ * allow_insecure is set (for local development servers).
+ */
+std::shared_ptr<grpc::CallCredentials> make_call_credentials(std::shared_ptr<TokenCache> cache, bool allow_insecure);
+
+/**
+ * Refresh through a unary call whose response carries the token as a string
+ * field and its lifetime in seconds as a varint field.
+ */
+struct UnaryRefresh {
+    std::string method;
+    std::string request;
+    uint32_t token_field = 1;
+    uint32_t expires_in_field = 2;  // 0 = the response has no lifetime
+    int timeout_ms = 10000;
+};
+
+/**
+ * RefreshFunction making `spec`'s call on the stub `get_stub` returns at
+ * the time (nullptr = not connected). The call carries no call credentials.
+ */
+TokenCache::RefreshFunction unary_refresher(
+    UnaryRefresh spec, std::function<std::shared_ptr<grpc::GenericStub>()> get_stub);
+
+/**
+ * Read the token and lifetime from a refresh response. Returns false if the
+ * message is malformed or has no token.
+ */
+bool parse_token_response(const uint8_t* data, size_t size, uint32_t token_field, uint32_t expires_in_field,
+                          std::string* token, double* expires_in_s);
+
+} // namespace auth
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_CALL_CREDENTIALS_H
@@ -0,0 +1,140 @@
+#include "delta_codec.h"
+#include "wire_format.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GODOT_GRPC_DELTA_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define GODOT_GRPC_DELTA_NEON 1
+#endif
+
+namespace godot_grpc {
+
+namespace wire {
+
+namespace {
+
+// A zero run shorter than this is cheaper to keep inside a literal than to
+// encode as a separate skip (two varints).
+constexpr size_t MIN_SKIP = 4;
+
+} // namespace
+
+void xor_into(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t i = 0;
+#if defined(GODOT_GRPC_DELTA_SSE2)
+    // SSE2 is part of the x86-64 baseline, so no runtime dispatch is needed
+    for (; i + 32 <= size; i += 32) {
+        __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i + 16));
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(a0, b0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 16), _mm_xor_si128(a1, b1));
+    }
+    for (; i + 16 <= size; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(a, b));
+    }
+#elif defined(GODOT_GRPC_DELTA_NEON)
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+    }
+#endif
+    for (; i + 8 <= size; i += 8) {
+        uint64_t a;
+        uint64_t b;
+        std::memcpy(&a, dst + i, sizeof(a));
+        std::memcpy(&b, src + i, sizeof(b));
+        a ^= b;
+        std::memcpy(dst + i, &a, sizeof(a));
+    }
+    for (; i < size; ++i) {
+        dst[i] ^= src[i];
+    }
+}
+
+bool apply_xor_delta(const uint8_t* baseline, size_t baseline_size,
+                     const uint8_t* delta, size_t delta_size,
+                     uint8_t* out, size_t target_size) {
+    size_t common = std::min(baseline_size, target_size);
+    if (common > 0) {
+        std::memcpy(out, baseline, common);
+    }
+    if (target_size > common) {
+        std::memset(out + common, 0, target_size - common);
+    }
+
+    size_t in = 0;
+    size_t pos = 0;
+    while (in < delta_size) {
+        uint64_t skip;
+        uint64_t length;
+        if (!decode_varint(delta, delta_size, &in, &skip) || !decode_varint(delta, delta_size, &in, &length)) {
+            return false;
+        }
+        if (skip > target_size - pos || length > target_size - pos - skip || length > delta_size - in) {
+            return false;
+        }
+        pos += static_cast<size_t>(skip);
+        xor_into(out + pos, delta + in, static_cast<size_t>(length));
+        pos += static_cast<size_t>(length);
+        in += static_cast<size_t>(length);
+    }
+    return true;
+}
+
+void encode_xor_delta(const uint8_t* baseline, size_t baseline_size,
+                      const uint8_t* target, size_t target_size,
+                      std::vector<uint8_t>* out) {
+    out->clear();
+
+    auto base_at = [&](size_t i) -> uint8_t {
+        return i < baseline_size ? baseline[i] : 0;
+    };
+
+    uint8_t varint[MAX_VARINT_SIZE];
+    size_t pos = 0;
+    size_t run_start = 0; // Start of the pending skip
+    while (pos < target_size) {
+        // Skip equal bytes, 8 at a time while both sides have them
+        while (pos + 8 <= target_size && pos + 8 <= baseline_size && std::memcmp(target + pos, baseline + pos, 8) == 0) {
+            pos += 8;
+        }
+        while (pos < target_size && target[pos] == base_at(pos)) {
+            ++pos;
+        }
+        if (pos == target_size) {
+            break;
+        }
+
+        // Extend the literal until MIN_SKIP equal bytes follow
+        size_t literal_start = pos;
+        size_t equal = 0;
+        while (pos < target_size && equal < MIN_SKIP) {
+            equal = target[pos] == base_at(pos) ? equal + 1 : 0;
+            ++pos;
+        }
+        size_t literal_end = pos - equal;
+
+        size_t n = encode_varint(literal_start - run_start, varint);
+        out->insert(out->end(), varint, varint + n);
+        n = encode_varint(literal_end - literal_start, varint);
+        out->insert(out->end(), varint, varint + n);
+        size_t offset = out->size();
+        out->resize(offset + (literal_end - literal_start));
+        for (size_t i = literal_start; i < literal_end; ++i) {
+            (*out)[offset + (i - literal_start)] = target[i] ^ base_at(i);
+        }
+        run_start = literal_end;
+        pos = literal_end;
+    }
+}
+
+} // namespace wire
+
+} // namespace godot_grpc
@@ -0,0 +1,50 @@
+#ifndef GODOT_GRPC_DELTA_CODEC_H
+#define GODOT_GRPC_DELTA_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace godot_grpc {
+
+namespace wire {
+
+/**
+ * XOR/run-length deltas between two versions of a payload.
+ *
+ * A delta is the XOR of the target with its baseline (the baseline is
+ * zero-padded if the target is longer), stored as a sequence of
+ *   varint skip, varint length, `length` literal XOR bytes
+ * runs. Skipped bytes and bytes after the last run equal the baseline, so
+ * unchanged regions cost nothing and small edits cost a few bytes.
+ *
+ * Free of Godot types so it can be shared with tools and benchmarks.
+ */
+
+/**
+ * dst[i] ^= src[i] for `size` bytes, 16 bytes at a time where SIMD is
+ * available (SSE2 on x86-64, NEON on ARM64).
+ */
+void xor_into(uint8_t* dst, const uint8_t* src, size_t size);
+
+/**
+ * Reconstruct a `target_size`-byte payload from `baseline` and an encoded
+ * delta into `out`. Returns false if a run reaches past target_size or the
+ * delta is truncated.
+ */
+bool apply_xor_delta(const uint8_t* baseline, size_t baseline_size,
+                     const uint8_t* delta, size_t delta_size,
+                     uint8_t* out, size_t target_size);
+
+/**
+ * Encode the delta turning `baseline` into `target`, replacing `out`.
+ */
+void encode_xor_delta(const uint8_t* baseline, size_t baseline_size,
+                      const uint8_t* target, size_t target_size,
+                      std::vector<uint8_t>* out);
+
+} // namespace wire
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_DELTA_CODEC_H
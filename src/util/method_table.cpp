@@ -0,0 +1,80 @@
+#include "method_table.h"
+
+namespace godot_grpc {
+
+namespace methods {
+
+void Stats::record_latency(uint64_t latency_us) {
+    add(latency_us_total, latency_us);
+    uint64_t max = latency_us_max.load(std::memory_order_relaxed);
+    while (latency_us > max && !latency_us_max.compare_exchange_weak(max, latency_us, std::memory_order_relaxed)) {
+    }
+}
+
+void Stats::reset() {
+    for (std::atomic<uint64_t>* counter : { &calls, &errors, &messages_sent, &messages_received,
+                                            &bytes_sent, &bytes_received, &latency_us_total, &latency_us_max }) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+}
+
+bool Table::valid_name(const std::string& name) {
+    // One leading slash, a non-empty service and method, no other slashes
+    if (name.size() < 4 || name[0] != '/') {
+        return false;
+    }
+    size_t slash = name.find('/', 1);
+    return slash != std::string::npos && slash > 1 && slash + 1 < name.size() &&
+           name.find('/', slash + 1) == std::string::npos;
+}
+
+int Table::intern(const std::string& name) {
+    auto it = handles_.find(name);
+    if (it != handles_.end()) {
+        return it->second;
+    }
+    if (methods_.size() >= MAX_METHODS || !valid_name(name)) {
+        return -1;
+    }
+    auto method = std::make_unique<Method>();
+    method->handle = static_cast<int>(methods_.size()) + 1;
+    method->name = name;
+    methods_.push_back(std::move(method));
+    handles_.emplace(name, methods_.back()->handle);
+    return methods_.back()->handle;
+}
+
+bool Table::resolve(std::string name, Resolved* out) {
+    int handle = intern(name);
+    if (handle > 0) {
+        Method* method = methods_[static_cast<size_t>(handle) - 1].get();
+        out->name = &method->name;
+        out->stats = &method->stats;
+        return true;
+    }
+    if (!valid_name(name)) {
+        return false;
+    }
+    out->untracked_name = std::move(name);
+    out->name = &out->untracked_name;
+    out->stats = &untracked_;
+    return true;
+}
+
+Method* Table::find(int handle) {
+    if (handle < 1 || static_cast<size_t>(handle) > methods_.size()) {
+        return nullptr;
+    }
+    return methods_[static_cast<size_t>(handle) - 1].get();
+}
+
+void Table::reset_stats() {
+    for (auto& method : methods_) {
+        method->stats.reset();
+    }
+    untracked_.reset();
+}
+
+} // namespace methods
+
+} // namespace godot_grpc
@@ -0,0 +1,100 @@
+#ifndef GODOT_GRPC_METHOD_TABLE_H
+#define GODOT_GRPC_METHOD_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace godot_grpc {
+
+/**
+ * Interned method names with per-method counters.
+ *
+ * Each method gets a small integer handle on first use; calls made with the
+ * handle find the UTF-8 name and counters by indexing, without converting or
+ * hashing the name. Entries are never removed, so pointers to them stay valid
+ * for the table's lifetime.
+ *
+ * Only well-formed names are interned, and at most MAX_METHODS of them, so
+ * scripts calling many generated names cannot grow the table without bound.
+ * Calls by name once it is full share the untracked counters.
+ *
+ * The table itself is used from one thread (the main thread); Stats may be
+ * updated from any thread.
+ */
+namespace methods {
+
+struct Stats {
+    std::atomic<uint64_t> calls{0};  // Unary calls and streams started
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> messages_sent{0};
+    std::atomic<uint64_t> messages_received{0};
+    std::atomic<uint64_t> bytes_sent{0};
+    std::atomic<uint64_t> bytes_received{0};
+    std::atomic<uint64_t> latency_us_total{0};  // Unary calls only
+    std::atomic<uint64_t> latency_us_max{0};
+
+    void add(std::atomic<uint64_t>& counter, uint64_t value) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+    void record_latency(uint64_t latency_us);
+    void reset();
+};
+
+struct Method {
+    int handle;
+    std::string name;
+    Stats stats;
+};
+
+/**
+ * The method of one call: an interned entry, or a name that did not fit in
+ * the table with the untracked counters. `name` may point at
+ * untracked_name, so keep the object in place while the call uses it.
+ */
+struct Resolved {
+    const std::string* name = nullptr;
+    Stats* stats = nullptr;
+    std::string untracked_name;
+};
+
+class Table {
+public:
+    static constexpr size_t MAX_METHODS = 1024;
+
+    // "/package.Service/Method"
+    static bool valid_name(const std::string& name);
+
+    // Handle of `name` (from 1), adding it on first use. -1 if the name is
+    // malformed or new and the table is full.
+    int intern(const std::string& name);
+
+    // Resolve `name` for a call, interning it if there is room. Returns
+    // false only if the name is malformed.
+    bool resolve(std::string name, Resolved* out);
+
+    // nullptr for handles this table never gave out
+    Method* find(int handle);
+
+    size_t size() const { return methods_.size(); }
+    const Method& at(size_t index) const { return *methods_[index]; }
+
+    // Counters of calls by name made while the table was full
+    const Stats& untracked_stats() const { return untracked_; }
+
+    void reset_stats();
+
+private:
+    std::vector<std::unique_ptr<Method>> methods_;
+    Stats untracked_;
+    std::unordered_map<std::string, int> handles_;
+};
+
+} // namespace methods
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_METHOD_TABLE_H
@@ -0,0 +1,407 @@
+#include "mock_server.h"
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
+namespace godot_grpc {
+
+namespace mock {
+
+/**
+ * Runs delayed steps of calls on one thread. Steps never block: they only
+ * start the next gRPC operation.
+ */
+class Scheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Scheduler() : thread_(&Scheduler::run, this) {}
+
+    ~Scheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    void schedule(int delay_ms, std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (delay_ms > 0 && !draining_) {
+                tasks_.emplace(Clock::now() + std::chrono::milliseconds(delay_ms), std::move(task));
+                cv_.notify_all();
+                return;
+            }
+        }
+        task();
+    }
+
+    // Run every pending step now and stop delaying new ones
+    void drain() {
+        std::multimap<Clock::time_point, std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            draining_ = true;
+            tasks.swap(tasks_);
+        }
+        for (auto& entry : tasks) {
+            entry.second();
+        }
+    }
+
+    void resume() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        draining_ = false;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopped_) {
+            if (tasks_.empty()) {
+                cv_.wait(lock);
+                continue;
+            }
+            auto first = tasks_.begin();
+            Clock::time_point due = first->first;  // drain() may free the node while we wait
+            if (due > Clock::now()) {
+                cv_.wait_until(lock, due);
+                continue;
+            }
+            std::function<void()> task = std::move(first->second);
+            tasks_.erase(first);
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::multimap<Clock::time_point, std::function<void()>> tasks_;
+    bool draining_ = false;
+    bool stopped_ = false;
+    std::thread thread_;
+};
+
+/**
+ * One scripted call. Owns itself through self_ until gRPC reports it done
+ * and no scheduled step still refers to it.
+ */
+class Server::Call : public grpc::ServerGenericBidiReactor, public std::enable_shared_from_this<Call> {
+public:
+    Call(Server* server, std::shared_ptr<const MethodScript> script)
+        : server_(server), script_(std::move(script)) {}
+
+    void begin(std::shared_ptr<Call> self) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        self_ = std::move(self);
+        if (!script_) {
+            finish(grpc::Status(grpc::StatusCode::UNIMPLEMENTED, "no mock script for this method"));
+            return;
+        }
+        if (script_->status_code != 0 && server_->random_unit() < script_->error_rate) {
+            final_status_ = grpc::Status(static_cast<grpc::StatusCode>(script_->status_code), script_->status_message);
+        }
+        StartRead(&read_buffer_);
+    }
+
+    void OnReadDone(bool ok) override {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (!ok) {
+            reads_done_ = true;
+            if (!script_->reply_per_message) {
+                if (script_->echo) {
+                    pending_.insert(pending_.end(), received_.begin(), received_.end());
+                } else {
+                    queue_responses();
+                }
+            }
+            advance();
+            return;
+        }
+
+        std::string request = to_string(read_buffer_);
+        if (script_->reply_per_message) {
+            if (script_->echo) {
+                pending_.push_back(std::move(request));
+            } else {
+                queue_responses();
+            }
+        } else if (script_->echo) {
+            received_.push_back(std::move(request));
+        }
+
+        std::shared_ptr<Call> self = shared_from_this();
+        server_->scheduler_->schedule(script_->read_delay_ms, [self]() {
+            std::lock_guard<std::recursive_mutex> lock(self->mutex_);
+            if (!self->finished_) {
+                self->StartRead(&self->read_buffer_);
+            }
+        });
+        advance();
+    }
+
+    void OnWriteDone(bool ok) override {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        writing_ = false;
+        if (!ok) {
+            finish(grpc::Status(grpc::StatusCode::CANCELLED, "client went away"));
+            return;
+        }
+        sent_++;
+        advance();
+    }
+
+    void OnCancel() override {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        cancelled_ = true;
+        advance();
+    }
+
+    void OnDone() override {
+        // Released outside the lock: this may be the last reference
+        std::shared_ptr<Call> self;
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        self.swap(self_);
+    }
+
+private:
+    static std::string to_string(const grpc::ByteBuffer& buffer) {
+        std::vector<grpc::Slice> slices;
+        (void)buffer.Dump(&slices);
+        std::string data;
+        data.reserve(buffer.Length());
+        for (const auto& slice : slices) {
+            data.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+        }
+        return data;
+    }
+
+    // Counted rather than copied: repeat may be huge for endless streams
+    void queue_responses() {
+        canned_pending_ += static_cast<uint64_t>(script_->responses.size()) * static_cast<uint64_t>(script_->repeat);
+    }
+
+    // Start the next write, or finish once there is nothing left to do.
+    // At most one write is scheduled or in flight at a time.
+    void advance() {
+        if (finished_ || writing_) {
+            return;
+        }
+        if (cancelled_) {
+            finish(grpc::Status(grpc::StatusCode::CANCELLED, "cancelled"));
+            return;
+        }
+        if (script_->disconnect_after >= 0 && sent_ >= script_->disconnect_after) {
+            finish(grpc::Status(grpc::StatusCode::UNAVAILABLE, "mock disconnect"));
+            return;
+        }
+        if (!pending_.empty() || canned_pending_ > 0) {
+            writing_ = true;
+            int delay_ms = script_->delay_ms + server_->random_int(script_->jitter_ms);
+            std::shared_ptr<Call> self = shared_from_this();
+            server_->scheduler_->schedule(delay_ms, [self]() { self->write_next(); });
+            return;
+        }
+        if (reads_done_) {
+            finish(final_status_);
+        }
+    }
+
+    void write_next() {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (finished_) {
+            return;
+        }
+        if (cancelled_) {
+            writing_ = false;
+            advance();
+            return;
+        }
+        if (!pending_.empty()) {
+            grpc::Slice slice(pending_.front());
+            write_buffer_ = grpc::ByteBuffer(&slice, 1);
+            pending_.pop_front();
+        } else {
+            grpc::Slice slice(script_->responses[canned_index_ % script_->responses.size()]);
+            write_buffer_ = grpc::ByteBuffer(&slice, 1);
+            canned_index_++;
+            canned_pending_--;
+        }
+        StartWrite(&write_buffer_);
+    }
+
+    void finish(const grpc::Status& status) {
+        finished_ = true;
+        Finish(status);
+    }
+
+    Server* server_;
+    std::shared_ptr<const MethodScript> script_;
+    std::shared_ptr<Call> self_;
+
+    // Recursive because gRPC may run a reaction inline from a Start*() call
+    std::recursive_mutex mutex_;
+    grpc::ByteBuffer read_buffer_;
+    grpc::ByteBuffer write_buffer_;
+    std::deque<std::string> pending_;  // Echoed requests
+    uint64_t canned_pending_ = 0;      // Canned responses still to send
+    uint64_t canned_index_ = 0;
+    std::vector<std::string> received_;
+    grpc::Status final_status_;
+    int sent_ = 0;
+    bool reads_done_ = false;
+    bool writing_ = false;
+    bool cancelled_ = false;
+    bool finished_ = false;
+};
+
+class Server::Service : public grpc::CallbackGenericService {
+public:
+    explicit Service(Server* server) : server_(server) {}
+
+    grpc::ServerGenericBidiReactor* CreateReactor(grpc::GenericCallbackServerContext* context) override {
+        auto call = std::make_shared<Call>(server_, server_->begin_call(context->method()));
+        call->begin(call);
+        return call.get();
+    }
+
+private:
+    Server* server_;
+};
+
+Server::Server()
+    : scheduler_(std::make_unique<Scheduler>())
+    , random_(std::random_device{}()) {
+}
+
+Server::~Server() {
+    stop();
+}
+
+bool Server::start(const std::string& address, std::string* error) {
+    if (server_) {
+        *error = "mock server already running on " + endpoint_;
+        return false;
+    }
+
+    int selected_port = 0;
+    grpc::ServerBuilder builder;
+    // A generic service can only be registered with one server
+    service_ = std::make_unique<Service>(this);
+    builder.AddListeningPort(address, grpc::InsecureServerCredentials(), &selected_port);
+    builder.RegisterCallbackGenericService(service_.get());
+    scheduler_->resume();
+    server_ = builder.BuildAndStart();
+    if (!server_) {
+        *error = "cannot listen on " + address;
+        return false;
+    }
+
+    if (address.compare(0, 5, "unix:") == 0) {
+        port_ = 0;
+        endpoint_ = address;
+    } else {
+        port_ = selected_port;
+        endpoint_ = address.substr(0, address.rfind(':') + 1) + std::to_string(selected_port);
+    }
+    return true;
+}
+
+void Server::stop() {
+    if (!server_) {
+        return;
+    }
+    // Let delayed steps run now so calls notice the cancellation
+    scheduler_->drain();
+    server_->Shutdown(std::chrono::system_clock::now());
+    server_->Wait();
+    server_.reset();
+    service_.reset();
+    port_ = 0;
+    endpoint_.clear();
+}
+
+bool Server::is_running() const {
+    return server_ != nullptr;
+}
+
+int Server::port() const {
+    return port_;
+}
+
+std::string Server::endpoint() const {
+    return endpoint_;
+}
+
+void Server::set_script(const std::string& method, const MethodScript& script) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    scripts_[method] = std::make_shared<const MethodScript>(script);
+}
+
+void Server::remove_script(const std::string& method) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    scripts_.erase(method);
+}
+
+void Server::clear_scripts() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    scripts_.clear();
+}
+
+void Server::set_seed(uint32_t seed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    random_.seed(seed);
+}
+
+uint64_t Server::call_count(const std::string& method) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!method.empty()) {
+        auto it = call_counts_.find(method);
+        return it != call_counts_.end() ? it->second : 0;
+    }
+    uint64_t total = 0;
+    for (const auto& pair : call_counts_) {
+        total += pair.second;
+    }
+    return total;
+}
+
+void Server::reset_call_counts() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    call_counts_.clear();
+}
+
+std::shared_ptr<const MethodScript> Server::begin_call(const std::string& method) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    call_counts_[method]++;
+    auto it = scripts_.find(method);
+    return it != scripts_.end() ? it->second : nullptr;
+}
+
+int Server::random_int(int max) {
+    if (max <= 0) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::uniform_int_distribution<int>(0, max)(random_);
+}
+
+double Server::random_unit() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::uniform_real_distribution<double>(0.0, 1.0)(random_);
+}
+
+} // namespace mock
+
+} // namespace godot_grpc
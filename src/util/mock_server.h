@@ -0,0 +1,110 @@
+#ifndef GODOT_GRPC_UTIL_MOCK_SERVER_H
+#define GODOT_GRPC_UTIL_MOCK_SERVER_H
+
+#include <grpcpp/server.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace godot_grpc {
+
+/**
+ * In-process gRPC server with scripted method handlers, for testing client
+ * behaviour (deadlines, retries, backpressure, stream errors) under
+ * controlled latency and faults.
+ *
+ * Handlers are generic: requests are never parsed. A call reads requests
+ * until the client half-closes, then sends its replies and final status;
+ * with reply_per_message it replies to each request as it arrives instead,
+ * which is what bidi tests want. That covers all four call types.
+ *
+ * Free of Godot types so native benchmarks can embed it too.
+ */
+namespace mock {
+
+struct MethodScript {
+    std::vector<std::string> responses;  // Canned replies, sent in order
+    int repeat = 1;                      // Times the responses are sent per reply
+    bool echo = false;                   // Reply with the request itself instead
+    bool reply_per_message = false;      // Reply to each request as it arrives
+
+    int delay_ms = 0;                    // Before each response message
+    int jitter_ms = 0;                   // Uniform extra delay in [0, jitter_ms]
+    int read_delay_ms = 0;               // Before reading each further request (slow consumer)
+
+    int status_code = 0;                 // Final status of calls that fail
+    std::string status_message;
+    double error_rate = 1.0;             // Share of calls ending with status_code, if it is not OK
+
+    int disconnect_after = -1;           // End the call with UNAVAILABLE after this many responses; -1 = never
+};
+
+class Scheduler;
+
+/**
+ * The server. Methods without a script end with UNIMPLEMENTED. Scripts may
+ * be replaced while it runs; calls keep the script they started with.
+ */
+class Server {
+public:
+    Server();
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /**
+     * Listen on `address`: "host:port" (port 0 picks a free one) or
+     * "unix:/path/to.sock".
+     */
+    bool start(const std::string& address, std::string* error);
+
+    /**
+     * Skip remaining delays, cancel calls still in flight and stop.
+     */
+    void stop();
+
+    bool is_running() const;
+    int port() const;              // Bound TCP port, 0 for UDS or when stopped
+    std::string endpoint() const;  // Target for GrpcClient.connect()
+
+    void set_script(const std::string& method, const MethodScript& script);
+    void remove_script(const std::string& method);
+    void clear_scripts();
+
+    void set_seed(uint32_t seed);
+
+    // Calls received for a method, or for all methods when it is empty
+    uint64_t call_count(const std::string& method = std::string()) const;
+    void reset_call_counts();
+
+private:
+    class Call;
+    class Service;
+
+    std::shared_ptr<const MethodScript> begin_call(const std::string& method);
+    // Uniform in [0, max]
+    int random_int(int max);
+    double random_unit();
+
+    std::unique_ptr<Service> service_;
+    std::unique_ptr<Scheduler> scheduler_;
+    std::unique_ptr<grpc::Server> server_;
+    std::string endpoint_;
+    int port_ = 0;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<const MethodScript>> scripts_;
+    std::map<std::string, uint64_t> call_counts_;
+    std::mt19937 random_;
+};
+
+} // namespace mock
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_UTIL_MOCK_SERVER_H
@@ -0,0 +1,156 @@
+#include "runtime_init.h"
+#include <grpc/grpc.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace godot_grpc {
+
+namespace runtime {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class State { IDLE, RUNNING, DONE };
+
+std::mutex g_mutex;
+std::condition_variable g_cv;
+State g_state = State::IDLE;
+Timings g_timings;
+std::thread g_thread;
+
+// Nothing listens on port 1 of a normal machine, so the attempt is refused
+// at once; it only exists to make gRPC build what a real connection needs
+const char* const WARMUP_TARGET = "dns:///localhost:1";
+constexpr auto WARMUP_TIMEOUT = std::chrono::seconds(2);
+
+double millis_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void attempt_connection(const std::shared_ptr<grpc::ChannelCredentials>& credentials) {
+    std::shared_ptr<grpc::Channel> channel = grpc::CreateChannel(WARMUP_TARGET, credentials);
+    auto deadline = std::chrono::system_clock::now() + WARMUP_TIMEOUT;
+    grpc_connectivity_state state = channel->GetState(true);
+    while (state == GRPC_CHANNEL_IDLE || state == GRPC_CHANNEL_CONNECTING) {
+        if (!channel->WaitForStateChange(state, deadline)) {
+            break;
+        }
+        state = channel->GetState(false);
+    }
+}
+
+Timings run(const char* mode, bool warm_up) {
+    Timings timings;
+    timings.mode = mode;
+    Clock::time_point start = Clock::now();
+
+    // Held until shutdown(), so the core stays up between clients
+    Clock::time_point phase = Clock::now();
+    grpc_init();
+    timings.core_ms = millis_since(phase);
+
+    if (warm_up) {
+        phase = Clock::now();
+        attempt_connection(grpc::InsecureChannelCredentials());
+        timings.resolver_ms = millis_since(phase);
+
+        phase = Clock::now();
+        attempt_connection(grpc::SslCredentials(grpc::SslCredentialsOptions()));
+        timings.tls_ms = millis_since(phase);
+    }
+
+    timings.total_ms = millis_since(start);
+    timings.initialized = true;
+    return timings;
+}
+
+// Run the initialization if nobody has, else wait for whoever is running it
+Timings initialize_with_mode(const char* mode, bool warm_up) {
+    std::unique_lock<std::mutex> lock(g_mutex);
+    if (g_state == State::IDLE) {
+        g_state = State::RUNNING;
+        lock.unlock();
+        Timings timings = run(mode, warm_up);
+        lock.lock();
+        g_timings = timings;
+        g_state = State::DONE;
+        g_cv.notify_all();
+    }
+    g_cv.wait(lock, [] { return g_state == State::DONE; });
+    return g_timings;
+}
+
+} // namespace
+
+Timings initialize() {
+    return initialize_with_mode("blocking", true);
+}
+
+bool initialize_async(DoneCallback on_done) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_state != State::IDLE) {
+        return false;
+    }
+    g_state = State::RUNNING;
+    g_thread = std::thread([on_done]() {
+        Timings timings = run("async", true);
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            g_timings = timings;
+            g_state = State::DONE;
+        }
+        g_cv.notify_all();
+        if (on_done) {
+            on_done(timings);
+        }
+    });
+    return true;
+}
+
+void ensure_initialized() {
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_state == State::DONE) {
+            return;
+        }
+    }
+    initialize_with_mode("on_demand", false);
+}
+
+bool is_initialized() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_state == State::DONE;
+}
+
+Timings timings() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_timings;
+}
+
+void shutdown() {
+    std::thread thread;
+    bool initialized;
+    {
+        std::unique_lock<std::mutex> lock(g_mutex);
+        g_cv.wait(lock, [] { return g_state != State::RUNNING; });
+        thread.swap(g_thread);
+        initialized = g_state == State::DONE;
+        g_state = State::IDLE;
+        g_timings = Timings();
+    }
+    if (thread.joinable()) {
+        thread.join();
+    }
+    if (initialized) {
+        grpc_shutdown();
+    }
+}
+
+} // namespace runtime
+
+} // namespace godot_grpc
@@ -0,0 +1,74 @@
+#ifndef GODOT_GRPC_RUNTIME_INIT_H
+#define GODOT_GRPC_RUNTIME_INIT_H
+
+#include <functional>
+#include <string>
+
+namespace godot_grpc {
+
+/**
+ * Explicit start-up of the gRPC runtime.
+ *
+ * Left alone, gRPC pays its start-up costs piecemeal: the core on the first
+ * channel, and the DNS resolver, TLS root store and SSL context on the first
+ * connection attempt (tens of milliseconds for the roots alone). initialize()
+ * pays them all at once, up front and measured, by bringing the core up and
+ * making throwaway connection attempts to localhost (insecure, then TLS)
+ * that fail fast. initialize_async() does the same on a background thread,
+ * e.g. during a splash screen.
+ *
+ * Channel creation calls ensure_initialized(), so an application that never
+ * initializes explicitly still works: the core comes up on the first
+ * channel and the rest is paid on the first connection, as before. Either
+ * way the core then stays up until shutdown() instead of being torn down
+ * and rebuilt whenever the last channel closes.
+ *
+ * Free of Godot types so native tools can warm up the same way.
+ */
+namespace runtime {
+
+struct Timings {
+    bool initialized = false;
+    std::string mode;       // "blocking", "async" or "on_demand"
+    double core_ms = 0.0;     // grpc_init()
+    double resolver_ms = 0.0; // First resolution and connection attempt
+    double tls_ms = 0.0;      // Default root store and SSL context
+    double total_ms = 0.0;
+};
+
+using DoneCallback = std::function<void(const Timings& timings)>;
+
+/**
+ * Initialize on the calling thread. Returns at once if already initialized,
+ * or waits for a background initialization in progress.
+ */
+Timings initialize();
+
+/**
+ * Initialize on a background thread and call on_done from that thread when
+ * finished. Returns false (and does not call on_done) if initialization was
+ * already started or done.
+ */
+bool initialize_async(DoneCallback on_done);
+
+/**
+ * Bring up the core only, recorded as "on_demand", unless initialization
+ * was done or started already (then wait for it). Called by channel
+ * creation.
+ */
+void ensure_initialized();
+
+bool is_initialized();
+Timings timings();
+
+/**
+ * Wait for a background initialization and release the core reference taken
+ * by initialization. Call once, at unload.
+ */
+void shutdown();
+
+} // namespace runtime
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_RUNTIME_INIT_H
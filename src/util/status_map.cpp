@@ -1,10 +1,28 @@
 #include "status_map.h"
+#ifdef GODOT_GRPC_NO_GODOT
+#include <cstdio>
+#else
 #include <godot_cpp/variant/utility_functions.hpp>
+#endif
 #include <sstream>
 
 namespace godot_grpc {
 
-LogLevel Logger::current_level = LogLevel::WARN;
+namespace {
+
+#ifdef GODOT_GRPC_NO_GODOT
+void log_error(const std::string& line) { std::fprintf(stderr, "%s\n", line.c_str()); }
+void log_warning(const std::string& line) { std::fprintf(stderr, "%s\n", line.c_str()); }
+void log_print(const std::string& line) { std::fprintf(stderr, "%s\n", line.c_str()); }
+#else
+void log_error(const std::string& line) { godot::UtilityFunctions::push_error(line.c_str()); }
+void log_warning(const std::string& line) { godot::UtilityFunctions::push_warning(line.c_str()); }
+void log_print(const std::string& line) { godot::UtilityFunctions::print(line.c_str()); }
+#endif
+
+} // namespace
+
+std::atomic<LogLevel> Logger::current_level{LogLevel::WARN};
 
 void Logger::set_level(LogLevel level) {
     current_level = level;
@@ -16,34 +34,35 @@ LogLevel Logger::get_level() {
 
 void Logger::error(const std::string& message) {
     if (current_level >= LogLevel::ERR) {
-        godot::UtilityFunctions::push_error(("[GodotGRPC ERROR] " + message).c_str());
+        log_error("[GodotGRPC ERROR] " + message);
     }
 }
 
 void Logger::warn(const std::string& message) {
     if (current_level >= LogLevel::WARN) {
-        godot::UtilityFunctions::push_warning(("[GodotGRPC WARN] " + message).c_str());
+        log_warning("[GodotGRPC WARN] " + message);
     }
 }
 
 void Logger::info(const std::string& message) {
     if (current_level >= LogLevel::INFO) {
-        godot::UtilityFunctions::print(("[GodotGRPC INFO] " + message).c_str());
+        log_print("[GodotGRPC INFO] " + message);
     }
 }
 
 void Logger::debug(const std::string& message) {
     if (current_level >= LogLevel::DEBUG) {
-        godot::UtilityFunctions::print(("[GodotGRPC DEBUG] " + message).c_str());
+        log_print("[GodotGRPC DEBUG] " + message);
     }
 }
 
 void Logger::trace(const std::string& message) {
     if (current_level >= LogLevel::TRACE) {
-        godot::UtilityFunctions::print(("[GodotGRPC TRACE] " + message).c_str());
+        log_print("[GodotGRPC TRACE] " + message);
     }
 }
 
+#ifndef GODOT_GRPC_NO_GODOT
 int StatusMap::grpc_to_godot_error(grpc::StatusCode code) {
     switch (code) {
         case grpc::StatusCode::OK:
@@ -84,6 +103,7 @@ int StatusMap::grpc_to_godot_error(grpc::StatusCode code) {
             return godot::FAILED;
     }
 }
+#endif
 
 std::string StatusMap::status_code_string(grpc::StatusCode code) {
     switch (code) {
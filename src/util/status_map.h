@@ -2,8 +2,11 @@
 #define GODOT_GRPC_STATUS_MAP_H
 
 #include <grpcpp/grpcpp.h>
+#ifndef GODOT_GRPC_NO_GODOT
 #include <godot_cpp/core/error_macros.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
+#endif
+#include <atomic>
 #include <string>
 
 namespace godot_grpc {
@@ -14,10 +17,12 @@ namespace godot_grpc {
  */
 class StatusMap {
 public:
+#ifndef GODOT_GRPC_NO_GODOT
     /**
      * Convert gRPC status code to Godot Error enum.
      */
     static int grpc_to_godot_error(grpc::StatusCode code);
+#endif
 
     /**
      * Get human-readable string for gRPC status code.
@@ -49,12 +54,18 @@ enum class LogLevel {
 
 /**
  * Simple logger for the extension.
+ * Prints through Godot, or to stderr in standalone builds (GODOT_GRPC_NO_GODOT).
  */
 class Logger {
 public:
     static void set_level(LogLevel level);
     static LogLevel get_level();
 
+    // Check before building a message on a hot path
+    static bool enabled(LogLevel level) {
+        return current_level.load(std::memory_order_relaxed) >= level;
+    }
+
     static void error(const std::string& message);
     static void warn(const std::string& message);
     static void info(const std::string& message);
@@ -62,7 +73,8 @@ public:
     static void trace(const std::string& message);
 
 private:
-    static LogLevel current_level;
+    // Atomic: set from the main thread while stream threads log
+    static std::atomic<LogLevel> current_level;
 };
 
 } // namespace godot_grpc
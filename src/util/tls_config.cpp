@@ -0,0 +1,90 @@
+#include "tls_config.h"
+#include <grpc/grpc_security.h>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace godot_grpc {
+
+namespace tls {
+
+namespace {
+
+// Configurations seen at once are few (usually one); the bound only stops a
+// caller that generates certificates on the fly from growing the map forever
+constexpr size_t MAX_CACHED_CONFIGS = 16;
+
+struct Entry {
+    std::shared_ptr<grpc::ChannelCredentials> credentials;
+    grpc_ssl_session_cache* session_cache = nullptr;
+
+    Entry() = default;
+    Entry(const Entry&) = delete;
+    Entry& operator=(const Entry&) = delete;
+
+    // Channels created with the cache hold their own references
+    ~Entry() {
+        if (session_cache) {
+            grpc_ssl_session_cache_destroy(session_cache);
+        }
+    }
+};
+
+using Key = std::tuple<std::string, std::string, std::string>;
+
+std::mutex g_mutex;
+std::map<Key, std::unique_ptr<Entry>> g_entries;
+
+bool looks_like_pem(const std::string& data) {
+    return data.find("-----BEGIN ") != std::string::npos;
+}
+
+} // namespace
+
+bool validate(const Config& config, std::string* error) {
+    if (config.client_cert_pem.empty() != config.client_key_pem.empty()) {
+        *error = "client_cert_pem and client_key_pem must be given together";
+        return false;
+    }
+    const std::pair<const char*, const std::string*> fields[] = {
+        { "root_certs_pem", &config.root_certs_pem },
+        { "client_cert_pem", &config.client_cert_pem },
+        { "client_key_pem", &config.client_key_pem },
+    };
+    for (const auto& field : fields) {
+        if (!field.second->empty() && !looks_like_pem(*field.second)) {
+            *error = std::string(field.first) + " is not PEM data";
+            return false;
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<grpc::ChannelCredentials> credentials(const Config& config, grpc::ChannelArguments* args) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    Key key(config.root_certs_pem, config.client_cert_pem, config.client_key_pem);
+    auto it = g_entries.find(key);
+    if (it == g_entries.end()) {
+        if (g_entries.size() >= MAX_CACHED_CONFIGS) {
+            g_entries.clear();
+        }
+        auto entry = std::make_unique<Entry>();
+        grpc::SslCredentialsOptions ssl_opts;
+        ssl_opts.pem_root_certs = config.root_certs_pem;
+        ssl_opts.pem_cert_chain = config.client_cert_pem;
+        ssl_opts.pem_private_key = config.client_key_pem;
+        entry->credentials = grpc::SslCredentials(ssl_opts);
+        entry->session_cache = grpc_ssl_session_cache_create_lru(SESSION_CACHE_CAPACITY);
+        it = g_entries.emplace(std::move(key), std::move(entry)).first;
+    }
+
+    if (config.session_resumption) {
+        grpc_arg arg = grpc_ssl_session_cache_create_channel_arg(it->second->session_cache);
+        args->SetPointerWithVtable(arg.key, arg.value.pointer.p, arg.value.pointer.vtable);
+    }
+    return it->second->credentials;
+}
+
+} // namespace tls
+
+} // namespace godot_grpc
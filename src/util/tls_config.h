@@ -0,0 +1,49 @@
+#ifndef GODOT_GRPC_TLS_CONFIG_H
+#define GODOT_GRPC_TLS_CONFIG_H
+
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/support/channel_arguments.h>
+#include <memory>
+#include <string>
+
+namespace godot_grpc {
+
+/**
+ * TLS channel credentials, built once per configuration and shared.
+ *
+ * Channels with the same roots and client certificate get the same
+ * credentials object instead of each parsing the PEM data again, and the
+ * same client session cache, so a reconnect (or a second channel to the same
+ * server) resumes the earlier TLS session with a ticket instead of running a
+ * full handshake. Each configuration has its own session cache: a session
+ * established with one client certificate is never offered with another.
+ */
+namespace tls {
+
+struct Config {
+    std::string root_certs_pem;   // Empty = system roots
+    std::string client_cert_pem;  // mTLS: both or neither
+    std::string client_key_pem;
+    bool session_resumption = true;
+};
+
+// Sessions kept per configuration, one per server name
+constexpr size_t SESSION_CACHE_CAPACITY = 64;
+
+/**
+ * Check the PEM fields are consistent. Fills `error` and returns false
+ * otherwise.
+ */
+bool validate(const Config& config, std::string* error);
+
+/**
+ * Shared credentials for `config`, and the session cache added to `args`
+ * when resumption is on. `config` must have passed validate().
+ */
+std::shared_ptr<grpc::ChannelCredentials> credentials(const Config& config, grpc::ChannelArguments* args);
+
+} // namespace tls
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_TLS_CONFIG_H
@@ -0,0 +1,335 @@
+#include "traffic_log.h"
+#include <cstring>
+
+namespace godot_grpc {
+
+namespace traffic {
+
+namespace {
+
+// Buffered bytes before a write to disk
+constexpr size_t FLUSH_THRESHOLD = 256 * 1024;
+
+// Full buffers queued for the flush thread before recording waits for it
+// (4 MB), so a disk that cannot keep up at all does not grow memory forever
+constexpr size_t MAX_FULL_BUFFERS = 16;
+
+} // namespace
+
+Writer::~Writer() {
+    close();
+}
+
+bool Writer::open(const std::string& path, std::string* error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        *error = "already recording";
+        return false;
+    }
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        *error = "cannot open " + path + " for writing";
+        return false;
+    }
+
+    uint64_t start_unix_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    buffer_.clear();
+    buffer_.put_bytes(reinterpret_cast<const uint8_t*>(MAGIC), sizeof(MAGIC));
+    buffer_.put_varint(FORMAT_VERSION);
+    buffer_.put_varint(start_unix_us);
+    last_time_ = std::chrono::steady_clock::now();
+    next_call_id_ = 1;
+    record_count_ = 0;
+    bytes_written_ = 0;
+    closing_ = false;
+    flush_thread_ = std::thread(&Writer::flush_loop, this);
+    queue_buffer();
+    return true;
+}
+
+void Writer::close() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!file_ || closing_) {
+        return;
+    }
+    queue_buffer();
+    closing_ = true;
+    flush_cv_.notify_one();
+    drained_cv_.notify_all();
+    std::thread flush_thread = std::move(flush_thread_);
+    lock.unlock();
+    flush_thread.join();
+    lock.lock();
+
+    // Records made while the flush thread finished
+    if (buffer_.size() > 0) {
+        std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+        bytes_written_ += buffer_.size();
+        buffer_.clear();
+    }
+    std::fclose(file_);
+    file_ = nullptr;
+    closing_ = false;
+}
+
+bool Writer::is_open() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_ != nullptr;
+}
+
+uint64_t Writer::start_call(CallType type, int64_t stream_id, const std::string& method, const Metadata& metadata) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!file_) {
+        return 0;
+    }
+    uint64_t call_id = next_call_id_++;
+    put_record_header(CALL_START, call_id);
+    buffer_.put_varint(type);
+    buffer_.put_varint(static_cast<uint64_t>(stream_id));
+    put_string(method);
+    buffer_.put_varint(metadata.size());
+    for (const auto& pair : metadata) {
+        put_string(pair.first);
+        put_string(pair.second);
+    }
+    flush_if_full(lock);
+    return call_id;
+}
+
+void Writer::message(RecordKind direction, uint64_t call_id, const BytesPart* parts, size_t part_count) {
+    size_t total = 0;
+    for (size_t i = 0; i < part_count; ++i) {
+        total += parts[i].size;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!file_) {
+        return;
+    }
+    put_record_header(direction, call_id);
+    buffer_.reserve(buffer_.size() + wire::MAX_VARINT_SIZE + total);
+    buffer_.put_varint(total);
+    for (size_t i = 0; i < part_count; ++i) {
+        buffer_.put_bytes(parts[i].data, parts[i].size);
+    }
+    flush_if_full(lock);
+}
+
+void Writer::message(RecordKind direction, uint64_t call_id, const uint8_t* data, size_t size) {
+    BytesPart part = { data, size };
+    message(direction, call_id, &part, 1);
+}
+
+void Writer::finish(uint64_t call_id, int status_code, const std::string& message) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!file_) {
+        return;
+    }
+    put_record_header(FINISH, call_id);
+    buffer_.put_varint(static_cast<uint64_t>(status_code));
+    put_string(message);
+    flush_if_full(lock);
+}
+
+uint64_t Writer::get_record_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return record_count_;
+}
+
+uint64_t Writer::get_bytes_written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_written_ + buffer_.size();
+}
+
+void Writer::put_record_header(RecordKind kind, uint64_t call_id) {
+    // Timestamps are taken under the lock, so deltas never go negative
+    auto now = std::chrono::steady_clock::now();
+    uint64_t delta_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - last_time_).count());
+    // Carry the sub-microsecond remainder so deltas do not drift
+    last_time_ += std::chrono::microseconds(delta_us);
+
+    buffer_.put_varint(kind);
+    buffer_.put_varint(delta_us);
+    buffer_.put_varint(call_id);
+    record_count_++;
+}
+
+void Writer::put_string(const std::string& text) {
+    buffer_.put_varint(text.size());
+    buffer_.put_bytes(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+}
+
+void Writer::flush_if_full(std::unique_lock<std::mutex>& lock) {
+    if (buffer_.size() < FLUSH_THRESHOLD) {
+        return;
+    }
+    drained_cv_.wait(lock, [this]() { return full_.size() < MAX_FULL_BUFFERS || closing_; });
+    // While closing, close() writes what is left after the flush thread exits
+    if (file_ && !closing_) {
+        queue_buffer();
+    }
+}
+
+void Writer::queue_buffer() {
+    if (buffer_.size() == 0) {
+        return;
+    }
+    bytes_written_ += buffer_.size();
+    full_.push_back(std::move(buffer_));
+    if (spare_.empty()) {
+        buffer_ = wire::Buffer();
+    } else {
+        buffer_ = std::move(spare_.back());
+        spare_.pop_back();
+    }
+    flush_cv_.notify_one();
+}
+
+void Writer::flush_loop() {
+    // file_ stays open until close() has joined this thread
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        flush_cv_.wait(lock, [this]() { return !full_.empty() || closing_; });
+        if (full_.empty()) {
+            return;
+        }
+        std::vector<wire::Buffer> buffers;
+        buffers.swap(full_);
+        FILE* file = file_;
+        lock.unlock();
+        for (const wire::Buffer& buffer : buffers) {
+            std::fwrite(buffer.data(), 1, buffer.size(), file);
+        }
+        std::fflush(file);
+        lock.lock();
+
+        for (wire::Buffer& buffer : buffers) {
+            if (spare_.size() >= MAX_FULL_BUFFERS) {
+                break;
+            }
+            buffer.clear();
+            spare_.push_back(std::move(buffer));
+        }
+        drained_cv_.notify_all();
+    }
+}
+
+bool Reader::open(const std::string& path, std::string* error) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        *error = "cannot open " + path;
+        return false;
+    }
+    data_.clear();
+    uint8_t chunk[64 * 1024];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data_.insert(data_.end(), chunk, chunk + read);
+    }
+    std::fclose(file);
+
+    pos_ = 0;
+    time_us_ = 0;
+    error_.clear();
+    uint64_t version = 0;
+    if (data_.size() < sizeof(MAGIC) || std::memcmp(data_.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        *error = path + " is not a traffic log";
+        return false;
+    }
+    pos_ = sizeof(MAGIC);
+    if (!read_varint(&version) || version != FORMAT_VERSION || !read_varint(&start_unix_us_)) {
+        *error = path + ": unsupported traffic log version";
+        return false;
+    }
+    return true;
+}
+
+bool Reader::next(Record* record) {
+    if (pos_ >= data_.size()) {
+        return false;
+    }
+
+    uint64_t kind = 0;
+    uint64_t delta_us = 0;
+    uint64_t value = 0;
+    size_t offset = 0;
+    size_t size = 0;
+    auto corrupt = [this]() {
+        error_ = "corrupt record at offset " + std::to_string(pos_);
+        pos_ = data_.size();
+        return false;
+    };
+    auto read_string = [&](std::string* out) {
+        if (!read_bytes(&offset, &size)) {
+            return false;
+        }
+        out->assign(reinterpret_cast<const char*>(data_.data() + offset), size);
+        return true;
+    };
+
+    if (!read_varint(&kind) || !read_varint(&delta_us) || !read_varint(&record->call_id)) {
+        return corrupt();
+    }
+    time_us_ += delta_us;
+    record->kind = static_cast<RecordKind>(kind);
+    record->time_us = time_us_;
+
+    switch (kind) {
+        case CALL_START: {
+            uint64_t count = 0;
+            if (!read_varint(&value) || value > BIDIRECTIONAL) {
+                return corrupt();
+            }
+            record->call_type = static_cast<CallType>(value);
+            if (!read_varint(&value) || !read_string(&record->method) || !read_varint(&count)) {
+                return corrupt();
+            }
+            record->stream_id = static_cast<int64_t>(value);
+            record->metadata.clear();
+            for (uint64_t i = 0; i < count; ++i) {
+                std::pair<std::string, std::string> pair;
+                if (!read_string(&pair.first) || !read_string(&pair.second)) {
+                    return corrupt();
+                }
+                record->metadata.push_back(std::move(pair));
+            }
+            return true;
+        }
+        case SEND:
+        case RECEIVE:
+            if (!read_bytes(&offset, &size)) {
+                return corrupt();
+            }
+            record->payload.assign(data_.begin() + offset, data_.begin() + offset + size);
+            return true;
+        case FINISH:
+            if (!read_varint(&value) || !read_string(&record->message)) {
+                return corrupt();
+            }
+            record->status_code = static_cast<int>(value);
+            return true;
+        default:
+            return corrupt();
+    }
+}
+
+bool Reader::read_varint(uint64_t* value) {
+    return wire::decode_varint(data_.data(), data_.size(), &pos_, value);
+}
+
+bool Reader::read_bytes(size_t* offset, size_t* size) {
+    uint64_t length = 0;
+    if (!read_varint(&length) || length > data_.size() - pos_) {
+        return false;
+    }
+    *offset = pos_;
+    *size = static_cast<size_t>(length);
+    pos_ += *size;
+    return true;
+}
+
+} // namespace traffic
+
+} // namespace godot_grpc
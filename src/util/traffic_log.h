@@ -0,0 +1,167 @@
+#ifndef GODOT_GRPC_TRAFFIC_LOG_H
+#define GODOT_GRPC_TRAFFIC_LOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "wire_format.h"
+
+namespace godot_grpc {
+
+/**
+ * Binary log of recorded gRPC traffic.
+ *
+ * Layout: the 8-byte magic "GGRPCLOG", varint format version, varint wall
+ * clock start time (Unix microseconds), then records of
+ *   varint kind, varint microseconds since the previous record, varint call id
+ * followed by a kind-specific body:
+ *   CALL_START  varint call type, varint stream id, string method,
+ *               varint metadata count, (string key, string value) pairs
+ *   SEND        bytes payload
+ *   RECEIVE     bytes payload
+ *   FINISH      varint status code, string message
+ * where string and bytes are a varint length and the raw data. Call ids are
+ * assigned by the writer, so unary calls and streams share one id space.
+ *
+ * Free of Godot and gRPC types so tools can read and write logs too.
+ */
+namespace traffic {
+
+constexpr char MAGIC[8] = { 'G', 'G', 'R', 'P', 'C', 'L', 'O', 'G' };
+constexpr uint64_t FORMAT_VERSION = 1;
+
+enum RecordKind : uint32_t {
+    CALL_START = 1,
+    SEND = 2,
+    RECEIVE = 3,
+    FINISH = 4
+};
+
+enum CallType : uint32_t {
+    UNARY = 0,
+    SERVER_STREAMING = 1,
+    CLIENT_STREAMING = 2,
+    BIDIRECTIONAL = 3
+};
+
+using Metadata = std::vector<std::pair<std::string, std::string>>;
+
+// A payload given as pieces (e.g. the slices of a grpc::ByteBuffer)
+struct BytesPart {
+    const uint8_t* data;
+    size_t size;
+};
+
+/**
+ * Appends records to a log file. Thread-safe; records are buffered and
+ * written in large chunks, so recording costs a copy and a lock per message.
+ * Full buffers are written by the writer's own thread, so a slow disk never
+ * stalls the stream threads that record messages.
+ */
+class Writer {
+public:
+    Writer() = default;
+    ~Writer();
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    bool open(const std::string& path, std::string* error);
+    void close();
+    bool is_open() const;
+
+    // start_call() allocates and returns the id later records refer to
+    uint64_t start_call(CallType type, int64_t stream_id, const std::string& method, const Metadata& metadata);
+    void message(RecordKind direction, uint64_t call_id, const BytesPart* parts, size_t part_count);
+    void message(RecordKind direction, uint64_t call_id, const uint8_t* data, size_t size);
+    void finish(uint64_t call_id, int status_code, const std::string& message);
+
+    uint64_t get_record_count() const;
+    uint64_t get_bytes_written() const;
+
+private:
+    // Caller holds mutex_
+    void put_record_header(RecordKind kind, uint64_t call_id);
+    void put_string(const std::string& text);
+    void flush_if_full(std::unique_lock<std::mutex>& lock);
+    void queue_buffer();
+
+    // Flush thread body
+    void flush_loop();
+
+    mutable std::mutex mutex_;
+    FILE* file_ = nullptr;
+    wire::Buffer buffer_;
+
+    // Buffers waiting for the flush thread, oldest first, and written ones
+    // kept for reuse
+    std::thread flush_thread_;
+    std::condition_variable flush_cv_;
+    std::condition_variable drained_cv_;
+    std::vector<wire::Buffer> full_;
+    std::vector<wire::Buffer> spare_;
+    bool closing_ = false;
+    std::chrono::steady_clock::time_point last_time_;
+    uint64_t next_call_id_ = 1;
+    uint64_t record_count_ = 0;
+    uint64_t bytes_written_ = 0;
+};
+
+/**
+ * One decoded record. Only the fields of its kind are set.
+ */
+struct Record {
+    RecordKind kind = CALL_START;
+    uint64_t time_us = 0;  // Since the start of the recording
+    uint64_t call_id = 0;
+
+    // CALL_START
+    CallType call_type = UNARY;
+    int64_t stream_id = 0;
+    std::string method;
+    Metadata metadata;
+
+    // SEND / RECEIVE
+    std::vector<uint8_t> payload;
+
+    // FINISH
+    int status_code = 0;
+    std::string message;
+};
+
+/**
+ * Reads a whole log into memory and iterates over its records.
+ */
+class Reader {
+public:
+    bool open(const std::string& path, std::string* error);
+
+    // False at the end of the log or on a corrupt record (see error())
+    bool next(Record* record);
+
+    const std::string& error() const { return error_; }
+    uint64_t start_unix_us() const { return start_unix_us_; }
+
+private:
+    bool read_varint(uint64_t* value);
+    bool read_bytes(size_t* offset, size_t* size);
+
+    std::vector<uint8_t> data_;
+    size_t pos_ = 0;
+    uint64_t time_us_ = 0;
+    uint64_t start_unix_us_ = 0;
+    std::string error_;
+};
+
+} // namespace traffic
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_TRAFFIC_LOG_H
@@ -0,0 +1,335 @@
+#include "varint_decode.h"
+#include "wire_format.h"
+#include <bitset>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GODOT_GRPC_VARINT_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang compile the vector kernels for their ISA without raising the
+// baseline of the rest of the library; MSVC accepts the intrinsics as-is.
+#if defined(GODOT_GRPC_VARINT_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GODOT_GRPC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define GODOT_GRPC_TARGET(isa)
+#endif
+
+namespace godot_grpc {
+
+namespace wire {
+
+namespace {
+
+bool decode_scalar(const uint8_t* data, size_t size, uint64_t* out, size_t count) {
+    size_t pos = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!decode_varint(data, size, &pos, &out[i])) {
+            return false;
+        }
+    }
+    return pos == size;
+}
+
+#ifdef GODOT_GRPC_VARINT_X86
+
+inline unsigned lowest_bit(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Decode a varint whose length is already known from the terminator mask.
+// Up to 8 bytes take one load and a branch-free compaction of the 7-bit
+// groups; the caller guarantees 8 readable bytes at `p`.
+inline uint64_t decode_known_length(const uint8_t* p, size_t length) {
+    if (length <= 8) {
+        uint64_t x;
+        std::memcpy(&x, p, sizeof(x)); // x86 is little-endian
+        x &= ~uint64_t(0) >> (64 - 8 * length);
+        x = ((x & 0x7F007F007F007F00ULL) >> 1) | (x & 0x007F007F007F007FULL);
+        x = ((x & 0x3FFF00003FFF0000ULL) >> 2) | (x & 0x00003FFF00003FFFULL);
+        x = ((x & 0x0FFFFFFF00000000ULL) >> 4) | (x & 0x000000000FFFFFFFULL);
+        return x;
+    }
+    uint64_t result = 0;
+    for (size_t i = 0; i < length; ++i) {
+        result |= static_cast<uint64_t>(p[i] & 0x7F) << (7 * i);
+    }
+    return result;
+}
+
+// Decode the varints terminated inside a block starting at `*pos` (always a
+// varint boundary). Positions come straight from the terminator mask, so
+// consecutive varints decode independently of each other. Indices are kept
+// in locals: `out` may alias size_t storage as far as the compiler knows.
+inline bool decode_block(const uint8_t* data, size_t* pos, uint32_t terminators,
+                         uint64_t* out, size_t* n, size_t count) {
+    if (terminators == 0) {
+        return false; // A whole block without a terminator: over-long varint
+    }
+    size_t base = *pos;
+    size_t start = base;
+    size_t index = *n;
+    while (terminators) {
+        size_t end = base + lowest_bit(terminators);
+        terminators &= terminators - 1;
+        size_t length = end - start + 1;
+        if (length > MAX_VARINT_SIZE || index >= count) {
+            return false;
+        }
+        out[index++] = decode_known_length(data + start, length);
+        start = end + 1;
+    }
+    *pos = start;
+    *n = index;
+    return true;
+}
+
+bool decode_tail(const uint8_t* data, size_t size, size_t pos, uint64_t* out, size_t n, size_t count) {
+    for (; n < count; ++n) {
+        if (!decode_varint(data, size, &pos, &out[n])) {
+            return false;
+        }
+    }
+    return pos == size;
+}
+
+// Blocks of two-byte varints (terminators on every odd byte) are common for
+// ids and counts up to 16383, and too regular for the mask walk to beat the
+// branch-predicted scalar loop, so they are merged 16 bits at a time:
+// low 7 bits | next 7 bits << 7.
+GODOT_GRPC_TARGET("sse4.1")
+inline __m128i merge_two_byte_sse41(__m128i block) {
+    __m128i low = _mm_and_si128(block, _mm_set1_epi16(0x007F));
+    __m128i high = _mm_srli_epi16(_mm_and_si128(block, _mm_set1_epi16(0x7F00)), 1);
+    return _mm_or_si128(low, high);
+}
+
+GODOT_GRPC_TARGET("avx2")
+inline __m256i merge_two_byte_avx2(__m256i block) {
+    __m256i low = _mm256_and_si256(block, _mm256_set1_epi16(0x007F));
+    __m256i high = _mm256_srli_epi16(_mm256_and_si256(block, _mm256_set1_epi16(0x7F00)), 1);
+    return _mm256_or_si256(low, high);
+}
+
+// Blocks are only taken while 8 bytes past the block remain, so the 8-byte
+// loads in decode_known_length never read out of bounds.
+GODOT_GRPC_TARGET("sse4.1")
+bool decode_sse41(const uint8_t* data, size_t size, uint64_t* out, size_t count) {
+    size_t pos = 0;
+    size_t n = 0;
+    while (size - pos >= 16 + 8) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        uint32_t terminators = ~static_cast<uint32_t>(_mm_movemask_epi8(block)) & 0xFFFF;
+
+        if (terminators == 0xFFFF && count - n >= 16) {
+            // 16 single-byte varints: widen two bytes at a time
+            __m128i* dst = reinterpret_cast<__m128i*>(out + n);
+            _mm_storeu_si128(dst + 0, _mm_cvtepu8_epi64(block));
+            _mm_storeu_si128(dst + 1, _mm_cvtepu8_epi64(_mm_srli_si128(block, 2)));
+            _mm_storeu_si128(dst + 2, _mm_cvtepu8_epi64(_mm_srli_si128(block, 4)));
+            _mm_storeu_si128(dst + 3, _mm_cvtepu8_epi64(_mm_srli_si128(block, 6)));
+            _mm_storeu_si128(dst + 4, _mm_cvtepu8_epi64(_mm_srli_si128(block, 8)));
+            _mm_storeu_si128(dst + 5, _mm_cvtepu8_epi64(_mm_srli_si128(block, 10)));
+            _mm_storeu_si128(dst + 6, _mm_cvtepu8_epi64(_mm_srli_si128(block, 12)));
+            _mm_storeu_si128(dst + 7, _mm_cvtepu8_epi64(_mm_srli_si128(block, 14)));
+            pos += 16;
+            n += 16;
+            continue;
+        }
+        if (terminators == 0xAAAA && count - n >= 8) {
+            // 8 two-byte varints: merge, then widen two values at a time
+            __m128i values = merge_two_byte_sse41(block);
+            __m128i* dst = reinterpret_cast<__m128i*>(out + n);
+            _mm_storeu_si128(dst + 0, _mm_cvtepu16_epi64(values));
+            _mm_storeu_si128(dst + 1, _mm_cvtepu16_epi64(_mm_srli_si128(values, 4)));
+            _mm_storeu_si128(dst + 2, _mm_cvtepu16_epi64(_mm_srli_si128(values, 8)));
+            _mm_storeu_si128(dst + 3, _mm_cvtepu16_epi64(_mm_srli_si128(values, 12)));
+            pos += 16;
+            n += 8;
+            continue;
+        }
+        if (!decode_block(data, &pos, terminators, out, &n, count)) {
+            return false;
+        }
+    }
+    return decode_tail(data, size, pos, out, n, count);
+}
+
+GODOT_GRPC_TARGET("avx2")
+bool decode_avx2(const uint8_t* data, size_t size, uint64_t* out, size_t count) {
+    size_t pos = 0;
+    size_t n = 0;
+    while (size - pos >= 32 + 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        uint32_t terminators = ~static_cast<uint32_t>(_mm256_movemask_epi8(block));
+
+        if (terminators == 0xFFFFFFFFu && count - n >= 32) {
+            // 32 single-byte varints: widen four bytes at a time
+            __m128i low = _mm256_castsi256_si128(block);
+            __m128i high = _mm256_extracti128_si256(block, 1);
+            __m256i* dst = reinterpret_cast<__m256i*>(out + n);
+            _mm256_storeu_si256(dst + 0, _mm256_cvtepu8_epi64(low));
+            _mm256_storeu_si256(dst + 1, _mm256_cvtepu8_epi64(_mm_srli_si128(low, 4)));
+            _mm256_storeu_si256(dst + 2, _mm256_cvtepu8_epi64(_mm_srli_si128(low, 8)));
+            _mm256_storeu_si256(dst + 3, _mm256_cvtepu8_epi64(_mm_srli_si128(low, 12)));
+            _mm256_storeu_si256(dst + 4, _mm256_cvtepu8_epi64(high));
+            _mm256_storeu_si256(dst + 5, _mm256_cvtepu8_epi64(_mm_srli_si128(high, 4)));
+            _mm256_storeu_si256(dst + 6, _mm256_cvtepu8_epi64(_mm_srli_si128(high, 8)));
+            _mm256_storeu_si256(dst + 7, _mm256_cvtepu8_epi64(_mm_srli_si128(high, 12)));
+            pos += 32;
+            n += 32;
+            continue;
+        }
+        if (terminators == 0xAAAAAAAAu && count - n >= 16) {
+            // 16 two-byte varints: merge, then widen four values at a time
+            __m256i values = merge_two_byte_avx2(block);
+            __m128i low = _mm256_castsi256_si128(values);
+            __m128i high = _mm256_extracti128_si256(values, 1);
+            __m256i* dst = reinterpret_cast<__m256i*>(out + n);
+            _mm256_storeu_si256(dst + 0, _mm256_cvtepu16_epi64(low));
+            _mm256_storeu_si256(dst + 1, _mm256_cvtepu16_epi64(_mm_srli_si128(low, 8)));
+            _mm256_storeu_si256(dst + 2, _mm256_cvtepu16_epi64(high));
+            _mm256_storeu_si256(dst + 3, _mm256_cvtepu16_epi64(_mm_srli_si128(high, 8)));
+            pos += 32;
+            n += 16;
+            continue;
+        }
+        if (!decode_block(data, &pos, terminators, out, &n, count)) {
+            return false;
+        }
+    }
+    return decode_tail(data, size, pos, out, n, count);
+}
+
+GODOT_GRPC_TARGET("avx2")
+size_t count_terminators_avx2(const uint8_t* data, size_t size, size_t* pos) {
+    size_t count = 0;
+    for (; size - *pos >= 32; *pos += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + *pos));
+        count += std::bitset<32>(~static_cast<uint32_t>(_mm256_movemask_epi8(block))).count();
+    }
+    return count;
+}
+
+GODOT_GRPC_TARGET("sse4.1")
+size_t count_terminators_sse41(const uint8_t* data, size_t size, size_t* pos) {
+    size_t count = 0;
+    for (; size - *pos >= 16; *pos += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + *pos));
+        count += std::bitset<16>(~static_cast<uint32_t>(_mm_movemask_epi8(block))).count();
+    }
+    return count;
+}
+
+bool cpu_supports(VarintKernel kernel) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (kernel == VarintKernel::SSE41) {
+        return sse41;
+    }
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    if (kernel == VarintKernel::SSE41) {
+        return __builtin_cpu_supports("sse4.1");
+    }
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // GODOT_GRPC_VARINT_X86
+
+VarintKernel select_kernel() {
+#ifdef GODOT_GRPC_VARINT_X86
+    if (cpu_supports(VarintKernel::AVX2)) {
+        return VarintKernel::AVX2;
+    }
+    if (cpu_supports(VarintKernel::SSE41)) {
+        return VarintKernel::SSE41;
+    }
+#endif
+    return VarintKernel::SCALAR;
+}
+
+} // namespace
+
+VarintKernel active_varint_kernel() {
+    static const VarintKernel kernel = select_kernel();
+    return kernel;
+}
+
+bool varint_kernel_supported(VarintKernel kernel) {
+    if (kernel == VarintKernel::SCALAR) {
+        return true;
+    }
+#ifdef GODOT_GRPC_VARINT_X86
+    return cpu_supports(kernel);
+#else
+    return false;
+#endif
+}
+
+const char* varint_kernel_name(VarintKernel kernel) {
+    switch (kernel) {
+        case VarintKernel::AVX2: return "avx2";
+        case VarintKernel::SSE41: return "sse4.1";
+        default: return "scalar";
+    }
+}
+
+bool count_varints(const uint8_t* data, size_t size, size_t* out_count) {
+    if (size > 0 && (data[size - 1] & 0x80) != 0) {
+        return false;
+    }
+
+    size_t count = 0;
+    size_t pos = 0;
+#ifdef GODOT_GRPC_VARINT_X86
+    switch (active_varint_kernel()) {
+        case VarintKernel::AVX2: count = count_terminators_avx2(data, size, &pos); break;
+        case VarintKernel::SSE41: count = count_terminators_sse41(data, size, &pos); break;
+        default: break;
+    }
+#endif
+    for (; pos < size; ++pos) {
+        count += (data[pos] & 0x80) == 0;
+    }
+    *out_count = count;
+    return true;
+}
+
+bool decode_varints_with(VarintKernel kernel, const uint8_t* data, size_t size, uint64_t* out, size_t count) {
+    switch (kernel) {
+#ifdef GODOT_GRPC_VARINT_X86
+        case VarintKernel::AVX2: return decode_avx2(data, size, out, count);
+        case VarintKernel::SSE41: return decode_sse41(data, size, out, count);
+#endif
+        default: return decode_scalar(data, size, out, count);
+    }
+}
+
+bool decode_varints(const uint8_t* data, size_t size, uint64_t* out, size_t count) {
+    return decode_varints_with(active_varint_kernel(), data, size, out, count);
+}
+
+} // namespace wire
+
+} // namespace godot_grpc
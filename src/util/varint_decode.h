@@ -0,0 +1,55 @@
+#ifndef GODOT_GRPC_VARINT_DECODE_H
+#define GODOT_GRPC_VARINT_DECODE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace godot_grpc {
+
+namespace wire {
+
+/**
+ * Bulk decoding of packed varint runs (repeated int32/int64/uint/sint/enum).
+ *
+ * On x86-64 the decoder uses SSE4.1 or AVX2 when the CPU supports them,
+ * selected once at runtime; other platforms use the scalar loop. The vector
+ * kernels find varint terminators 16/32 bytes at a time and widen runs of
+ * single-byte and of two-byte varints directly, the common cases for ids
+ * and counts. Runs of uniformly 3+ byte values gain little (about 1.1x)
+ * over the branch-predicted scalar loop; bench/varint_bench.cpp measures
+ * each case.
+ *
+ * Free of Godot types so it can be benchmarked standalone.
+ */
+
+enum class VarintKernel {
+    SCALAR,
+    SSE41,
+    AVX2
+};
+
+/**
+ * Count the varints in a packed run (one terminator byte per varint).
+ * Returns false if the run ends in the middle of a varint.
+ */
+bool count_varints(const uint8_t* data, size_t size, size_t* out_count);
+
+/**
+ * Decode a packed run holding exactly `count` varints (see count_varints)
+ * into `out` with the best kernel for this CPU. Values are the raw 64-bit
+ * varints; apply zigzag/int32 truncation afterwards as needed.
+ * Returns false on malformed input (varints longer than 10 bytes).
+ */
+bool decode_varints(const uint8_t* data, size_t size, uint64_t* out, size_t count);
+
+// Kernel selection, exposed for benchmarks and diagnostics
+VarintKernel active_varint_kernel();
+bool varint_kernel_supported(VarintKernel kernel);
+bool decode_varints_with(VarintKernel kernel, const uint8_t* data, size_t size, uint64_t* out, size_t count);
+const char* varint_kernel_name(VarintKernel kernel);
+
+} // namespace wire
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_VARINT_DECODE_H
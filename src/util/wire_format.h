@@ -0,0 +1,243 @@
+#ifndef GODOT_GRPC_WIRE_FORMAT_H
+#define GODOT_GRPC_WIRE_FORMAT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace godot_grpc {
+
+/**
+ * Low-level protobuf wire-format primitives.
+ *
+ * Header-only and free of Godot types so the same code backs the
+ * GDScript-facing GrpcProtoWriter/GrpcProtoReader and any native decoder.
+ * All multi-byte fixed-width values are little-endian on the wire.
+ */
+namespace wire {
+
+enum WireType : uint32_t {
+    VARINT = 0,
+    FIXED64 = 1,
+    LENGTH_DELIMITED = 2,
+    START_GROUP = 3,
+    END_GROUP = 4,
+    FIXED32 = 5
+};
+
+// Maximum encoded size of a 64-bit varint.
+constexpr size_t MAX_VARINT_SIZE = 10;
+
+// Deepest group nesting skip_field() follows, matching the decode plan's
+// message nesting limit, so hostile input cannot exhaust the stack.
+constexpr int MAX_DEPTH = 100;
+
+inline uint64_t zigzag_encode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline uint32_t make_tag(uint32_t field_number, WireType wire_type) {
+    return (field_number << 3) | static_cast<uint32_t>(wire_type);
+}
+
+inline size_t varint_size(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+/**
+ * Encode a varint into `out`, which must have room for MAX_VARINT_SIZE bytes.
+ * Returns the number of bytes written.
+ */
+inline size_t encode_varint(uint64_t value, uint8_t* out) {
+    size_t i = 0;
+    while (value >= 0x80) {
+        out[i++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[i++] = static_cast<uint8_t>(value);
+    return i;
+}
+
+/**
+ * Decode a varint starting at `*pos`. Advances `*pos` past the varint.
+ * Returns false on truncated or over-long input (pos is left unchanged).
+ */
+inline bool decode_varint(const uint8_t* data, size_t size, size_t* pos, uint64_t* value) {
+    uint64_t result = 0;
+    size_t p = *pos;
+    for (uint32_t shift = 0; shift < 64 && p < size; shift += 7) {
+        uint8_t byte = data[p++];
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *pos = p;
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline uint32_t load_fixed32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) |
+           (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline uint64_t load_fixed64(const uint8_t* p) {
+    return static_cast<uint64_t>(load_fixed32(p)) |
+           (static_cast<uint64_t>(load_fixed32(p + 4)) << 32);
+}
+
+inline void store_fixed32(uint32_t value, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+inline void store_fixed64(uint64_t value, uint8_t* out) {
+    store_fixed32(static_cast<uint32_t>(value), out);
+    store_fixed32(static_cast<uint32_t>(value >> 32), out + 4);
+}
+
+inline uint32_t float_bits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline uint64_t double_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float bits_to_float(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline double bits_to_double(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Skip over the payload of a field whose tag has already been consumed.
+ * Groups are skipped recursively; `depth` is the caller's nesting level.
+ * Returns false on malformed input or groups nested past MAX_DEPTH.
+ */
+inline bool skip_field(const uint8_t* data, size_t size, size_t* pos, uint32_t wire_type, uint32_t field_number,
+                       int depth = 0) {
+    uint64_t value;
+    switch (wire_type) {
+        case VARINT:
+            return decode_varint(data, size, pos, &value);
+        case FIXED64:
+            if (size - *pos < 8) {
+                return false;
+            }
+            *pos += 8;
+            return true;
+        case FIXED32:
+            if (size - *pos < 4) {
+                return false;
+            }
+            *pos += 4;
+            return true;
+        case LENGTH_DELIMITED:
+            if (!decode_varint(data, size, pos, &value) || value > size - *pos) {
+                return false;
+            }
+            *pos += static_cast<size_t>(value);
+            return true;
+        case START_GROUP:
+            if (depth >= MAX_DEPTH) {
+                return false;
+            }
+            while (*pos < size) {
+                uint64_t tag;
+                if (!decode_varint(data, size, pos, &tag)) {
+                    return false;
+                }
+                uint32_t inner_wire = static_cast<uint32_t>(tag & 0x7);
+                uint32_t inner_field = static_cast<uint32_t>(tag >> 3);
+                if (inner_wire == END_GROUP) {
+                    return inner_field == field_number;
+                }
+                if (!skip_field(data, size, pos, inner_wire, inner_field, depth + 1)) {
+                    return false;
+                }
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Growable output buffer for building messages. clear() keeps the
+ * allocation so one buffer can be reused across messages.
+ */
+class Buffer {
+public:
+    void clear() { data_.clear(); }
+    size_t size() const { return data_.size(); }
+    const uint8_t* data() const { return data_.data(); }
+    // Grows geometrically so repeated reserve() calls stay amortized O(1).
+    void reserve(size_t capacity) {
+        if (capacity > data_.capacity()) {
+            data_.reserve(capacity > data_.capacity() * 2 ? capacity : data_.capacity() * 2);
+        }
+    }
+
+    void put_varint(uint64_t value) {
+        size_t old_size = data_.size();
+        data_.resize(old_size + MAX_VARINT_SIZE);
+        data_.resize(old_size + encode_varint(value, data_.data() + old_size));
+    }
+
+    void put_tag(uint32_t field_number, WireType wire_type) {
+        put_varint(make_tag(field_number, wire_type));
+    }
+
+    void put_fixed32(uint32_t value) {
+        size_t old_size = data_.size();
+        data_.resize(old_size + 4);
+        store_fixed32(value, data_.data() + old_size);
+    }
+
+    void put_fixed64(uint64_t value) {
+        size_t old_size = data_.size();
+        data_.resize(old_size + 8);
+        store_fixed64(value, data_.data() + old_size);
+    }
+
+    void put_bytes(const uint8_t* bytes, size_t size) {
+        if (size > 0) {
+            data_.insert(data_.end(), bytes, bytes + size);
+        }
+    }
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+} // namespace wire
+
+} // namespace godot_grpc
+
+#endif // GODOT_GRPC_WIRE_FORMAT_H